@@ -28,6 +28,7 @@
 ***********************************************************************************************************************/
 
 #include "BIMserverConnection.hpp"
+#include "BIMserverStreams.hpp"
 
 #include "../model_editor/Application.hpp"
 #include "../model_editor/Utilities.hpp"
@@ -47,6 +48,9 @@
 #include <QJsonArray>
 #include <QJsonValue>
 #include <QByteArray>
+#include <QDir>
+#include <QMetaMethod>
+#include <QTemporaryFile>
 #include <iostream>
 #include <boost/none.hpp>
 
@@ -64,6 +68,9 @@ BIMserverConnection::~BIMserverConnection() {
   delete m_networkManager;
 }
 
+// Bytes of the download data reply buffered by the network manager, it is decoded to a file as it arrives
+static constexpr qint64 downloadReadBufferSize = 1024 * 1024;
+
 void BIMserverConnection::login(QString username, QString password) {
 
   if (!m_operationDone) {
@@ -210,6 +217,7 @@ void BIMserverConnection::download(QString revisionID) {
     return;
   }
   m_operationDone = false;
+  m_osmFile.reset();
   if (!revisionID.isEmpty()) {
     m_roid = revisionID;
     sendGetSerializerRequest();
@@ -334,38 +342,61 @@ void BIMserverConnection::sendGetDownloadDataRequest() {
   QNetworkRequest qNetworkRequest(m_bimserverURL);
   qNetworkRequest.setRawHeader("Content-Type", "application/json");
 
+  // the osm file is decoded from the base64 data as the reply is received
+  m_osmFile.reset(new QTemporaryFile(QDir::temp().filePath("BIMserver_XXXXXX.osm")));
+  if (!m_osmFile->open()) {
+    m_osmFile.reset();
+    emit errorOccured(QString("Cannot create a temporary file for the downloaded model"));
+    return;
+  }
+  m_downloadReader.reset(new DownloadDataReader(m_osmFile.get()));
+
   // disconnect all signals from m_networkManager to this
   disconnect(m_networkManager, nullptr, this, nullptr);
   connect(m_networkManager, &QNetworkAccessManager::finished, this, &BIMserverConnection::processGetDownloadDataRequest);
-  m_networkManager->post(qNetworkRequest, getDownloadDataJson);
+  QNetworkReply* reply = m_networkManager->post(qNetworkRequest, getDownloadDataJson);
+  reply->setReadBufferSize(downloadReadBufferSize);
+  connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+    if (m_downloadReader) {
+      m_downloadReader->addData(reply->readAll());
+    }
+  });
 }
 
 void BIMserverConnection::processGetDownloadDataRequest(QNetworkReply* rep) {
   //extract token from login Request
 
-  if (rep) {
-    QByteArray responseArray = rep->readAll();
-
-    QJsonDocument responseDoc = QJsonDocument::fromJson(responseArray);
-    QJsonObject downloadResponse = responseDoc.object();
+  if (rep && m_downloadReader) {
+    m_downloadReader->addData(rep->readAll());
+    bool decoded = m_downloadReader->finish();
+    QJsonObject downloadResponse = m_downloadReader->response();
     QJsonObject response = downloadResponse["response"].toObject();
+    m_downloadReader.reset();
 
     if (!containsError(response)) {
-      QJsonObject result = response["result"].toObject();
-      QString file = result["file"].toString();
-      //decode the response
-      QByteArray byteArray;
-      byteArray.append(file);
-      QString OSMFile = QByteArray::fromBase64(byteArray);
+      if (!decoded || !m_osmFile->flush()) {
+        m_osmFile.reset();
+        emit errorOccured(QString("Cannot decode the downloaded model"));
+        return;
+      }
 
-      m_osmModel = OSMFile;
       m_operationDone = true;
-      emit osmStringRetrieved(OSMFile);
+      emit osmFileRetrieved(m_osmFile->fileName());
+
+      // only hold the model in memory for receivers that need the string
+      if (isSignalConnected(QMetaMethod::fromSignal(&BIMserverConnection::osmStringRetrieved))) {
+        if (boost::optional<QString> osmString = readOSMFile()) {
+          emit osmStringRetrieved(*osmString);
+        }
+      }
     } else {
+      m_osmFile.reset();
       emitErrorMessage(response);
     }
 
   } else {
+    m_downloadReader.reset();
+    m_osmFile.reset();
     emit bimserverError();
   }
 }
@@ -564,8 +595,7 @@ void BIMserverConnection::processGetDeserializerRequest(QNetworkReply* rep) {
 
 void BIMserverConnection::sendCheckInIFCRequest(QString IFCFilePath) {
   const auto path = openstudio::toPath(IFCFilePath.toStdString());
-  openstudio::filesystem::ifstream file(path);
-  if (!file.is_open()) {
+  if (!openstudio::filesystem::is_regular_file(path)) {
     emit errorOccured(QString("Cannot open file, please verify and try again"));
     return;
   }
@@ -577,11 +607,9 @@ void BIMserverConnection::sendCheckInIFCRequest(QString IFCFilePath) {
   // filesystem::file_size returns a uintmax_t really.
   parameters["fileSize"] = QJsonValue(toQString(openstudio::string_conversions::number(std::uint64_t(openstudio::filesystem::file_size(path)))));
   parameters["fileName"] = QJsonValue(toQString(toString(path.stem())));
-  //encode file into Base64
-  std::vector<char> data = openstudio::filesystem::read(file);
-  QByteArray fileArrayEncoded = QByteArray(data.data(), data.size()).toBase64();
-  QString fileEncoded(fileArrayEncoded);
-  parameters["data"] = QJsonValue(fileEncoded);
+  //the file is encoded into Base64 as the request is sent, in place of this placeholder
+  const QString dataPlaceholder("BIMSERVER_CHECKIN_DATA");
+  parameters["data"] = QJsonValue(dataPlaceholder);
   parameters["merge"] = QJsonValue(false);
   parameters["sync"] = QJsonValue(false);
 
@@ -597,15 +625,26 @@ void BIMserverConnection::sendCheckInIFCRequest(QString IFCFilePath) {
   QJsonDocument doc;
   doc.setObject(checkInIFCRequest);
   QByteArray checkInIFCRequestJson = doc.toJson();
+  int dataIndex = checkInIFCRequestJson.indexOf("\"" + dataPlaceholder.toUtf8() + "\"");
+
+  auto body = new CheckInRequestBody(IFCFilePath, checkInIFCRequestJson.left(dataIndex + 1),
+                                     checkInIFCRequestJson.mid(dataIndex + 1 + dataPlaceholder.size()), this);
+  if (!body->open()) {
+    delete body;
+    emit errorOccured(QString("Cannot open file, please verify and try again"));
+    return;
+  }
 
   //setup network connection
   QNetworkRequest qNetworkRequest(m_bimserverURL);
   qNetworkRequest.setRawHeader("Content-Type", "application/json");
+  qNetworkRequest.setHeader(QNetworkRequest::ContentLengthHeader, body->size());
 
   // disconnect all signals from m_networkManager to this
   disconnect(m_networkManager, nullptr, this, nullptr);
   connect(m_networkManager, &QNetworkAccessManager::finished, this, &BIMserverConnection::processCheckInIFCRequest);
-  m_networkManager->post(qNetworkRequest, checkInIFCRequestJson);
+  QNetworkReply* reply = m_networkManager->post(qNetworkRequest, body);
+  connect(reply, &QNetworkReply::finished, body, &QObject::deleteLater);
 }
 
 void BIMserverConnection::processCheckInIFCRequest(QNetworkReply* rep) {
@@ -796,7 +835,9 @@ bool BIMserverConnection::loginBlocked(QString username, QString password, int t
 boost::optional<QString> BIMserverConnection::downloadBlocked(QString projectID, int timeout) {
   m_osmModel = boost::none;
   download(projectID);
-  waitForLock(timeout);
+  if (waitForLock(timeout) && m_osmFile) {
+    m_osmModel = readOSMFile();
+  }
   return m_osmModel;
 }
 
@@ -859,5 +900,17 @@ bool BIMserverConnection::waitForLock(int msec) const {
   return false;
 }
 
+boost::optional<QString> BIMserverConnection::readOSMFile() const {
+  if (!m_osmFile) {
+    return boost::none;
+  }
+
+  QFile file(m_osmFile->fileName());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return boost::none;
+  }
+  return QString::fromUtf8(file.readAll());
+}
+
 }  // namespace bimserver
 }  // namespace openstudio
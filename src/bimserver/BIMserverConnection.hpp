@@ -41,6 +41,10 @@
 #include <QtNetwork/QNetworkReply>
 #include <boost/optional.hpp>
 
+#include <memory>
+
+class QTemporaryFile;
+
 namespace openstudio {
 
 class ProgressBar;
@@ -53,6 +57,8 @@ class Surface;
 
 namespace bimserver {
 
+class DownloadDataReader;
+
 /// This provides utilities to connect to BIMserver
 class BIMSERVER_API BIMserverConnection : public QObject
 {
@@ -103,9 +109,12 @@ class BIMSERVER_API BIMserverConnection : public QObject
   boost::optional<QStringList> getIFCRevisionListBlocked(QString projectID, int timeout);
 
  signals:
-  /// send the retrieved osmString to GUI
+  /// send the retrieved osmString to GUI, only read from the downloaded file if this signal is connected
   void osmStringRetrieved(QString osmString);
 
+  /// send the path of the downloaded osm file, valid until the next download or the connection is destroyed
+  void osmFileRetrieved(QString osmFilePath);
+
   ///send the list of all projects to GUI
   void listAllProjects(QStringList projectList);
 
@@ -166,6 +175,8 @@ class BIMSERVER_API BIMserverConnection : public QObject
 
   bool waitForLock(int msec) const;
 
+  boost::optional<QString> readOSMFile() const;
+
   QNetworkAccessManager* m_networkManager;
   QUrl m_bimserverURL;
   QString m_username;
@@ -179,6 +190,10 @@ class BIMSERVER_API BIMserverConnection : public QObject
   QString m_filePath;
   bool m_operationDone;
 
+  /// Variables for the streamed download data
+  std::unique_ptr<DownloadDataReader> m_downloadReader;
+  std::unique_ptr<QTemporaryFile> m_osmFile;
+
   /// Variables for the blocking calls
   bool m_loginSuccess;
   boost::optional<QString> m_osmModel;
@@ -0,0 +1,242 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "BIMserverStreams.hpp"
+
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <cstring>
+
+namespace openstudio {
+namespace bimserver {
+
+CheckInRequestBody::CheckInRequestBody(const QString& filePath, const QByteArray& prefix, const QByteArray& suffix, QObject* parent)
+  : QIODevice(parent), m_file(filePath), m_prefix(prefix), m_suffix(suffix), m_encodedSize(0), m_offset(0), m_chunkOffset(-1) {}
+
+bool CheckInRequestBody::open() {
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  m_encodedSize = 4 * ((m_file.size() + 2) / 3);
+  m_offset = 0;
+  m_chunk.clear();
+  m_chunkOffset = -1;
+  return QIODevice::open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+bool CheckInRequestBody::isSequential() const {
+  return false;
+}
+
+qint64 CheckInRequestBody::size() const {
+  return m_prefix.size() + m_encodedSize + m_suffix.size();
+}
+
+bool CheckInRequestBody::seek(qint64 pos) {
+  if (pos < 0 || pos > size()) {
+    return false;
+  }
+  m_offset = pos;
+  return QIODevice::seek(pos);
+}
+
+qint64 CheckInRequestBody::readData(char* data, qint64 maxSize) {
+  const qint64 prefixSize = m_prefix.size();
+  const qint64 total = size();
+
+  qint64 result = 0;
+  while (result < maxSize && m_offset < total) {
+    qint64 n = 0;
+    if (m_offset < prefixSize) {
+      n = std::min(maxSize - result, prefixSize - m_offset);
+      std::memcpy(data + result, m_prefix.constData() + m_offset, n);
+    } else if (m_offset < prefixSize + m_encodedSize) {
+      const qint64 encodedOffset = m_offset - prefixSize;
+      if (!encodeChunk(encodedOffset)) {
+        return result > 0 ? result : -1;
+      }
+      const qint64 chunkPos = encodedOffset - m_chunkOffset;
+      n = std::min(maxSize - result, m_chunk.size() - chunkPos);
+      std::memcpy(data + result, m_chunk.constData() + chunkPos, n);
+    } else {
+      const qint64 suffixPos = m_offset - prefixSize - m_encodedSize;
+      n = std::min(maxSize - result, m_suffix.size() - suffixPos);
+      std::memcpy(data + result, m_suffix.constData() + suffixPos, n);
+    }
+    result += n;
+    m_offset += n;
+  }
+
+  return result;
+}
+
+qint64 CheckInRequestBody::writeData(const char*, qint64) {
+  return -1;
+}
+
+bool CheckInRequestBody::encodeChunk(qint64 encodedOffset) {
+  if (m_chunkOffset >= 0 && encodedOffset >= m_chunkOffset && encodedOffset < m_chunkOffset + m_chunk.size()) {
+    return true;
+  }
+
+  // the network manager may rewind the body to resend it, chunks are encoded again from the file
+  const qint64 encodedChunkSize = chunkSize / 3 * 4;
+  const qint64 index = encodedOffset / encodedChunkSize;
+  if (!m_file.seek(index * chunkSize)) {
+    return false;
+  }
+
+  QByteArray raw = m_file.read(chunkSize);
+  if (raw.isEmpty()) {
+    return false;
+  }
+
+  m_chunk = raw.toBase64();
+  m_chunkOffset = index * encodedChunkSize;
+
+  // the file may have been truncated since open()
+  return encodedOffset < m_chunkOffset + m_chunk.size();
+}
+
+DownloadDataReader::DownloadDataReader(QIODevice* output, const QByteArray& key)
+  : m_output(output),
+    m_key(key),
+    m_state(State::Document),
+    m_escaped(false),
+    m_afterColon(false),
+    m_foundData(false),
+    m_failed(false),
+    m_bytesWritten(0) {}
+
+void DownloadDataReader::addData(const QByteArray& data) {
+  const char* p = data.constData();
+  const char* end = p + data.size();
+
+  while (p < end) {
+    const char c = *p;
+    switch (m_state) {
+      case State::Document:
+        m_document.append(c);
+        if (c == '"') {
+          if (m_afterColon && m_lastString == m_key) {
+            m_state = State::Data;
+            m_foundData = true;
+          } else {
+            m_state = State::String;
+            m_currentString.clear();
+          }
+          m_afterColon = false;
+        } else if (c == ':') {
+          m_afterColon = true;
+        } else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+          m_afterColon = false;
+        }
+        ++p;
+        break;
+      case State::String:
+        m_document.append(c);
+        if (m_escaped) {
+          m_escaped = false;
+        } else if (c == '\\') {
+          m_escaped = true;
+        } else if (c == '"') {
+          m_lastString = m_currentString;
+          m_state = State::Document;
+          ++p;
+          break;
+        }
+        // only needs to be compared with the key
+        if (m_currentString.size() <= m_key.size()) {
+          m_currentString.append(c);
+        }
+        ++p;
+        break;
+      case State::Data:
+        if (m_escaped) {
+          // "\/" is the only escape a base64 string may need, others are line breaks
+          m_escaped = false;
+          if (c == '/') {
+            m_encoded.append(c);
+          }
+          ++p;
+        } else if (c == '\\') {
+          m_escaped = true;
+          ++p;
+        } else if (c == '"') {
+          decode(true);
+          m_document.append(c);
+          m_state = State::Document;
+          ++p;
+        } else {
+          const char* start = p;
+          while (p < end && *p != '"' && *p != '\\') {
+            ++p;
+          }
+          m_encoded.append(start, p - start);
+          if (m_encoded.size() >= chunkSize) {
+            decode(false);
+          }
+        }
+        break;
+    }
+  }
+}
+
+bool DownloadDataReader::finish() {
+  return m_foundData && m_state != State::Data && !m_failed;
+}
+
+QJsonObject DownloadDataReader::response() const {
+  return QJsonDocument::fromJson(m_document).object();
+}
+
+qint64 DownloadDataReader::bytesWritten() const {
+  return m_bytesWritten;
+}
+
+void DownloadDataReader::decode(bool final) {
+  // only whole groups of 4 characters are decoded until the end of the string
+  const int n = final ? m_encoded.size() : m_encoded.size() / 4 * 4;
+  if (n == 0) {
+    return;
+  }
+
+  QByteArray decoded = QByteArray::fromBase64(QByteArray::fromRawData(m_encoded.constData(), n));
+  m_encoded.remove(0, n);
+
+  if (m_output->write(decoded) == decoded.size()) {
+    m_bytesWritten += decoded.size();
+  } else {
+    m_failed = true;
+  }
+}
+
+}  // namespace bimserver
+}  // namespace openstudio
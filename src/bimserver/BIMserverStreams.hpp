@@ -0,0 +1,139 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef BIMSERVER_BIMSERVERSTREAMS_HPP
+#define BIMSERVER_BIMSERVERSTREAMS_HPP
+
+#include "BIMserverAPI.hpp"
+
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+#include <QJsonObject>
+
+namespace openstudio {
+namespace bimserver {
+
+/// Request body of a check-in, the JSON document with the file inlined as base64 data
+/**
+* The document is given as the JSON before and after the data string, the file is base64 encoded one chunk at a time as
+* the body is read. The size of the body is known up front, so the network manager does not need to buffer it.
+**/
+class BIMSERVER_API CheckInRequestBody : public QIODevice
+{
+ public:
+  /// prefix ends with the opening quote of the data string, suffix starts with its closing quote
+  CheckInRequestBody(const QString& filePath, const QByteArray& prefix, const QByteArray& suffix, QObject* parent = nullptr);
+
+  virtual ~CheckInRequestBody() {}
+
+  /// open the file and the device for reading
+  bool open();
+
+  bool isSequential() const override;
+
+  qint64 size() const override;
+
+  bool seek(qint64 pos) override;
+
+  /// number of bytes of the file encoded in one go, a multiple of 3 so that chunks do not need padding
+  static constexpr qint64 chunkSize = 3 * 16384;
+
+ protected:
+  qint64 readData(char* data, qint64 maxSize) override;
+
+  qint64 writeData(const char* data, qint64 maxSize) override;
+
+ private:
+  // encode the chunk containing this offset of the base64 data
+  bool encodeChunk(qint64 encodedOffset);
+
+  QFile m_file;
+  QByteArray m_prefix;
+  QByteArray m_suffix;
+  qint64 m_encodedSize;
+  qint64 m_offset;
+
+  // last encoded chunk and its offset in the base64 data
+  QByteArray m_chunk;
+  qint64 m_chunkOffset;
+};
+
+/// Incremental reader of a JSON response containing a large base64 string
+/**
+* Data is added as it is received. The value of the string member named key is decoded to output one chunk at a time,
+* the rest of the document is kept and parsed by response(), with an empty string in place of the data.
+**/
+class BIMSERVER_API DownloadDataReader
+{
+ public:
+  DownloadDataReader(QIODevice* output, const QByteArray& key = QByteArray("file"));
+
+  void addData(const QByteArray& data);
+
+  /// decode what remains of the data, returns false if the data string was not found, not terminated or not written
+  bool finish();
+
+  /// the response without the data
+  QJsonObject response() const;
+
+  /// number of decoded bytes written to output
+  qint64 bytesWritten() const;
+
+  /// number of base64 characters decoded in one go, a multiple of 4
+  static constexpr int chunkSize = 4 * 16384;
+
+ private:
+  enum class State
+  {
+    Document,
+    String,
+    Data
+  };
+
+  void decode(bool final);
+
+  QIODevice* m_output;
+  QByteArray m_key;
+  State m_state;
+  bool m_escaped;
+  bool m_afterColon;
+  bool m_foundData;
+  bool m_failed;
+  QByteArray m_document;
+  QByteArray m_currentString;
+  QByteArray m_lastString;
+  QByteArray m_encoded;
+  qint64 m_bytesWritten;
+};
+
+}  // namespace bimserver
+}  // namespace openstudio
+
+#endif  // BIMSERVER_BIMSERVERSTREAMS_HPP
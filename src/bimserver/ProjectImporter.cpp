@@ -29,6 +29,7 @@
 
 #include "ProjectImporter.hpp"
 #include "BIMserverConnection.hpp"
+#include "../model_editor/Utilities.hpp"
 
 #include <openstudio/osversion/VersionTranslator.hpp>
 
@@ -105,7 +106,7 @@ boost::optional<model::Model> ProjectImporter::run() {
 
     m_bimserverConnection = new BIMserverConnection(this, addr, port);
 
-    connect(m_bimserverConnection, &BIMserverConnection::osmStringRetrieved, this, &ProjectImporter::processOSMRetrieved);
+    connect(m_bimserverConnection, &BIMserverConnection::osmFileRetrieved, this, &ProjectImporter::processOSMRetrieved);
     connect(m_bimserverConnection, &BIMserverConnection::listAllProjects, this, &ProjectImporter::processProjectList);
     connect(m_bimserverConnection, &BIMserverConnection::listAllIFCRevisions, this, &ProjectImporter::processIFCList);
     connect(m_bimserverConnection, &BIMserverConnection::operationSucceeded, this, &ProjectImporter::processSucessCases);
@@ -122,14 +123,12 @@ boost::optional<model::Model> ProjectImporter::run() {
   //execute event loop
   m_waitForOSM->exec();
 
-  //Reverse Translate from osmString.
-
-  if (!m_OSM.isEmpty()) {
-    std::stringstream stringStream(m_OSM.toStdString());
+  //Reverse Translate from the downloaded osm file.
 
+  if (!m_osmFilePath.isEmpty()) {
     openstudio::osversion::VersionTranslator vt;
 
-    return vt.loadModel(stringStream);
+    return vt.loadModel(toPath(m_osmFilePath));
   } else {
     return boost::none;
   }
@@ -259,8 +258,8 @@ void ProjectImporter::loadButton_clicked() {
   }
 }
 
-void ProjectImporter::processOSMRetrieved(QString osmString) {
-  m_OSM = osmString;
+void ProjectImporter::processOSMRetrieved(QString osmFilePath) {
+  m_osmFilePath = osmFilePath;
   emit finished();
 }
 
@@ -344,7 +343,7 @@ void ProjectImporter::settingButton_clicked() {
 
       m_bimserverConnection = new BIMserverConnection(this, address, port);
 
-      connect(m_bimserverConnection, &BIMserverConnection::osmStringRetrieved, this, &ProjectImporter::processOSMRetrieved);
+      connect(m_bimserverConnection, &BIMserverConnection::osmFileRetrieved, this, &ProjectImporter::processOSMRetrieved);
       connect(m_bimserverConnection, &BIMserverConnection::listAllProjects, this, &ProjectImporter::processProjectList);
       connect(m_bimserverConnection, &BIMserverConnection::listAllIFCRevisions, this, &ProjectImporter::processIFCList);
       connect(m_bimserverConnection, &BIMserverConnection::operationSucceeded, this, &ProjectImporter::processSucessCases);
@@ -81,8 +81,8 @@ class BIMSERVER_API ProjectImporter : public QDialog
   void processSucessCases(QString sucessCase);
   /// process all failure cases if BIMserver outputs an exception. Print it
   void processFailureCases(QString failureCase);
-  /// OSM string is retrieved
-  void processOSMRetrieved(QString osmString);
+  /// OSM file is retrieved, it is loaded once the dialog is done
+  void processOSMRetrieved(QString osmFilePath);
   /// process if BIMserver is not connected.
   void processBIMserverErrors();
 
@@ -96,7 +96,7 @@ class BIMSERVER_API ProjectImporter : public QDialog
   QListWidget* m_ifcList;
   QStatusBar* m_statusBar;
   QEventLoop* m_waitForOSM;
-  QString m_OSM;
+  QString m_osmFilePath;
 
   QPushButton* m_okButton;
   QPushButton* m_loadButton;
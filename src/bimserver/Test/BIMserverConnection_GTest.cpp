@@ -0,0 +1,147 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "BIMserverFixture.hpp"
+#include "LocalBIMserver.hpp"
+
+#include "../BIMserverConnection.hpp"
+#include "../BIMserverStreams.hpp"
+
+#include "../../model_editor/Application.hpp"
+
+#include <QBuffer>
+#include <QFile>
+#include <QJsonObject>
+#include <QTemporaryFile>
+
+using namespace openstudio;
+using namespace openstudio::bimserver;
+
+static QByteArray testData(int size) {
+  QByteArray result(size, '\0');
+  for (int i = 0; i < size; ++i) {
+    result[i] = static_cast<char>((i * 7919) % 256);
+  }
+  return result;
+}
+
+TEST_F(BIMserverFixture, CheckInRequestBody) {
+  // spans several chunks, the last one needs padding
+  QByteArray data = testData(2 * CheckInRequestBody::chunkSize + 1);
+  QTemporaryFile file;
+  ASSERT_TRUE(file.open());
+  file.write(data);
+  file.close();
+
+  QByteArray prefix = "{\"data\": \"";
+  QByteArray suffix = "\", \"merge\": false}";
+  QByteArray expected = prefix + data.toBase64() + suffix;
+
+  CheckInRequestBody body(file.fileName(), prefix, suffix);
+  ASSERT_TRUE(body.open());
+  EXPECT_EQ(expected.size(), body.size());
+
+  QByteArray read;
+  while (!body.atEnd()) {
+    QByteArray piece = body.read(1000);
+    ASSERT_FALSE(piece.isEmpty());
+    read.append(piece);
+  }
+  EXPECT_EQ(expected, read);
+
+  // resent from the start
+  ASSERT_TRUE(body.reset());
+  EXPECT_EQ(expected, body.readAll());
+}
+
+TEST_F(BIMserverFixture, DownloadDataReader) {
+  QByteArray data = testData(3 * DownloadDataReader::chunkSize);
+  QByteArray response = "{\"response\": {\"result\": {\"file\": \"" + data.toBase64().replace("/", "\\/")
+                        + "\", \"filename\": \"model.osm\"}}}";
+
+  QBuffer output;
+  output.open(QIODevice::WriteOnly);
+  DownloadDataReader reader(&output);
+
+  // received in pieces that do not line up with the base64 groups
+  for (int i = 0; i < response.size(); i += 4099) {
+    reader.addData(response.mid(i, 4099));
+  }
+  EXPECT_TRUE(reader.finish());
+  EXPECT_EQ(data.size(), reader.bytesWritten());
+  EXPECT_EQ(data, output.data());
+
+  QJsonObject result = reader.response()["response"].toObject()["result"].toObject();
+  EXPECT_EQ(QString("model.osm"), result["filename"].toString());
+  EXPECT_TRUE(result["file"].toString().isEmpty());
+
+  // truncated reply
+  QBuffer truncatedOutput;
+  truncatedOutput.open(QIODevice::WriteOnly);
+  DownloadDataReader truncated(&truncatedOutput);
+  truncated.addData(response.left(response.size() / 2));
+  EXPECT_FALSE(truncated.finish());
+}
+
+TEST_F(BIMserverFixture, BIMserverConnection_LocalServer) {
+  Application::instance().application(false);
+
+  LocalBIMserver server;
+  ASSERT_TRUE(server.listen());
+
+  QByteArray osm = "OS:Version,\n  {00000000-0000-0000-0000-000000000000}, !- Handle\n  2.8.0;  !- Version Identifier\n";
+  server.setModel(osm);
+
+  QByteArray ifc = testData(4 * 1024 * 1024);
+  QTemporaryFile file;
+  ASSERT_TRUE(file.open());
+  file.write(ifc);
+  file.close();
+
+  BIMserverConnection connection(nullptr, server.address(), server.port());
+  EXPECT_TRUE(connection.loginBlocked("user", "password", 10000));
+
+  EXPECT_TRUE(connection.checkInIFCFileBlocked("1", file.fileName(), 10000));
+  EXPECT_EQ(ifc, server.checkedInData());
+  // the whole file went out in the request body, encoded as it was sent
+  EXPECT_LT(4 * ((ifc.size() + 2) / 3), server.maxRequestSize());
+
+  QString osmFilePath;
+  QObject::connect(&connection, &BIMserverConnection::osmFileRetrieved, [&osmFilePath](QString path) { osmFilePath = path; });
+
+  boost::optional<QString> downloaded = connection.downloadBlocked("3", 10000);
+  ASSERT_TRUE(downloaded);
+  EXPECT_EQ(QString(osm), *downloaded);
+
+  QFile osmFile(osmFilePath);
+  ASSERT_TRUE(osmFile.open(QIODevice::ReadOnly));
+  EXPECT_EQ(osm, osmFile.readAll());
+}
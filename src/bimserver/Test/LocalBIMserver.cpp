@@ -0,0 +1,144 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "LocalBIMserver.hpp"
+
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <algorithm>
+
+LocalBIMserver::LocalBIMserver() : m_server(new QTcpServer()), m_maxRequestSize(0) {
+  QObject::connect(m_server, &QTcpServer::newConnection, [this]() { onNewConnection(); });
+}
+
+LocalBIMserver::~LocalBIMserver() {
+  // Sockets are children of the server
+  delete m_server;
+}
+
+bool LocalBIMserver::listen() {
+  return m_server->listen(QHostAddress::LocalHost);
+}
+
+QString LocalBIMserver::address() const {
+  return QString("127.0.0.1");
+}
+
+QString LocalBIMserver::port() const {
+  return QString::number(m_server->serverPort());
+}
+
+void LocalBIMserver::setModel(const QByteArray& osm) {
+  m_model = osm;
+}
+
+QByteArray LocalBIMserver::checkedInData() const {
+  return m_checkedInData;
+}
+
+int LocalBIMserver::maxRequestSize() const {
+  return m_maxRequestSize;
+}
+
+void LocalBIMserver::onNewConnection() {
+  while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+    m_buffers[socket] = QByteArray();
+    QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { onReadyRead(socket); });
+    QObject::connect(socket, &QTcpSocket::disconnected, [this, socket]() {
+      m_buffers.erase(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void LocalBIMserver::onReadyRead(QTcpSocket* socket) {
+  QByteArray& buffer = m_buffers[socket];
+  buffer.append(socket->readAll());
+
+  while (true) {
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+      return;
+    }
+
+    QByteArray header = buffer.left(headerEnd);
+    int contentLength = 0;
+    for (const QByteArray& line : header.split('\n')) {
+      if (line.toLower().startsWith("content-length:")) {
+        contentLength = line.mid(line.indexOf(':') + 1).trimmed().toInt();
+      }
+    }
+
+    int requestSize = headerEnd + 4 + contentLength;
+    if (buffer.size() < requestSize) {
+      return;
+    }
+
+    QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+    buffer.remove(0, requestSize);
+    m_maxRequestSize = std::max(m_maxRequestSize, contentLength);
+
+    QJsonObject request = QJsonDocument::fromJson(body).object()["request"].toObject();
+    QByteArray response = "{\"response\": {\"result\": " + result(request) + "}}";
+
+    socket->write("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: application/json\r\n"
+                  "Connection: keep-alive\r\n"
+                  "Content-Length: "
+                  + QByteArray::number(response.size()) + "\r\n\r\n");
+    socket->write(response);
+  }
+}
+
+QByteArray LocalBIMserver::result(const QJsonObject& request) {
+  QString method = request["method"].toString();
+  QJsonObject parameters = request["parameters"].toObject();
+
+  if (method == "login") {
+    return "\"token\"";
+  } else if (method == "getSuggestedDeserializerForExtension") {
+    return "{\"oid\": 11}";
+  } else if (method == "checkin") {
+    m_checkedInData = QByteArray::fromBase64(parameters["data"].toString().toUtf8());
+    return "21";
+  } else if (method == "getSerializerByName") {
+    return "{\"oid\": 12}";
+  } else if (method == "download") {
+    return "31";
+  } else if (method == "getDownloadData") {
+    QByteArray file = m_model.toBase64().replace("/", "\\/");
+    return "{\"file\": \"" + file + "\", \"filename\": \"model.osm\"}";
+  } else if (method == "getProgress") {
+    return "{\"state\": \"FINISHED\"}";
+  }
+  return "{}";
+}
@@ -0,0 +1,81 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef BIMSERVER_TEST_LOCALBIMSERVER_HPP
+#define BIMSERVER_TEST_LOCALBIMSERVER_HPP
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <map>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Minimal stand-in for BIMserver's JSON API, used to exercise BIMserverConnection in tests.
+// It answers the calls of the login, check-in and download workflows, keeps the last checked in file and serves the
+// model given to setModel() as the download data, base64 encoded with escaped slashes like the Java server writes it.
+class LocalBIMserver
+{
+ public:
+  LocalBIMserver();
+
+  ~LocalBIMserver();
+
+  // Listen on a free port of the loopback interface
+  bool listen();
+
+  QString address() const;
+
+  QString port() const;
+
+  void setModel(const QByteArray& osm);
+
+  // Decoded data of the last check-in
+  QByteArray checkedInData() const;
+
+  // Size of the largest request body received
+  int maxRequestSize() const;
+
+ private:
+  void onNewConnection();
+
+  void onReadyRead(QTcpSocket* socket);
+
+  QByteArray result(const QJsonObject& request);
+
+  QTcpServer* m_server;
+  std::map<QTcpSocket*, QByteArray> m_buffers;
+  QByteArray m_model;
+  QByteArray m_checkedInData;
+  int m_maxRequestSize;
+};
+
+#endif  // BIMSERVER_TEST_LOCALBIMSERVER_HPP
@@ -29,8 +29,10 @@
 
 #include "InspectorGadget.hpp"
 #include "InspectorDialog.hpp"
+#include "ModelChangeBus.hpp"
 #include "Application.hpp"
 #include "AccessPolicyStore.hpp"
+#include "ReferenceIndex.hpp"
 #include "Utilities.hpp"
 
 #include <openstudio/model/Model.hpp>
@@ -68,17 +70,12 @@ using namespace openstudio;
 using namespace openstudio::model;
 
 InspectorDialog::InspectorDialog(InspectorDialogClient client, QWidget* parent)
-  : QMainWindow(parent), m_inspectorGadget(nullptr), m_workspaceChanged(false), m_workspaceObjectAdded(false), m_workspaceObjectRemoved(false) {
+  : QMainWindow(parent), m_inspectorGadget(nullptr) {
   init(client);
 }
 
 InspectorDialog::InspectorDialog(openstudio::model::Model& model, InspectorDialogClient client, QWidget* parent)
-  : QMainWindow(parent),
-    m_inspectorGadget(nullptr),
-    m_model(model),
-    m_workspaceChanged(false),
-    m_workspaceObjectAdded(false),
-    m_workspaceObjectRemoved(false) {
+  : QMainWindow(parent), m_inspectorGadget(nullptr), m_model(model) {
   init(client);
 }
 
@@ -278,6 +275,7 @@ void InspectorDialog::setModel(openstudio::model::Model& model, bool force) {
 
   // change model
   m_model = model;
+  m_referenceIndex = ReferenceIndex::get(m_model);
 
   // connect signals to the new model
   this->connectModelSignalsAndSlots();
@@ -339,6 +337,9 @@ void InspectorDialog::onPushButtonNew(bool) {
     m_selectedObjectHandles.push_back(object->handle());
     //setSelectedObjectHandles(m_selectedObjectHandles, true);
   }
+
+  // show the outcome of the button right away rather than on the next turn of the event loop
+  m_modelChangeBus->flush();
 }
 
 void InspectorDialog::onPushButtonCopy(bool) {
@@ -351,6 +352,8 @@ void InspectorDialog::onPushButtonCopy(bool) {
       //setSelectedObjectHandles(m_selectedObjectHandles, true);
     }
   }
+
+  m_modelChangeBus->flush();
 }
 
 void InspectorDialog::onPushButtonDelete(bool) {
@@ -362,10 +365,14 @@ void InspectorDialog::onPushButtonDelete(bool) {
       object->remove();
     }
   }
+
+  m_modelChangeBus->flush();
 }
 
 void InspectorDialog::onPushButtonPurge(bool) {
   m_model.purgeUnusedResourceObjects(m_iddObjectType);
+
+  m_modelChangeBus->flush();
 }
 
 /*
@@ -407,69 +414,27 @@ void InspectorDialog::onTableWidgetSelectionChanged() {
   setSelectedObjectHandles(selectedObjectHandles, true);
 }
 
-void InspectorDialog::onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
-                                           const openstudio::UUID& uuid) {
-  m_workspaceObjectAdded = true;
-  m_workspaceChanged = true;
-
-  if (impl->iddObject().type() == m_iddObjectType) {
-
-    m_objectHandles.push_back(impl->handle());
-
-    if (m_selectedObjectHandles.empty()) {
-      m_selectedObjectHandles.push_back(impl->handle());
-    } else {
-      // do we want to do this or preserve the current selection?
-      // this functionality is now in onPushButtonNew
-      //m_selectedObjectHandles.clear();
-      //m_selectedObjectHandles.push_back(impl->handle());
-      //setSelectedObjectHandles(m_selectedObjectHandles, true);
+void InspectorDialog::onModelChanges(const openstudio::ModelChangeBatch& batch) {
+  auto added = batch.added.find(m_iddObjectType);
+  if (added != batch.added.end()) {
+    for (const auto& impl : added->second) {
+      m_objectHandles.push_back(impl->handle());
     }
-  }
-
-  QTimer::singleShot(0, this, SLOT(onTimeout()));
-}
-
-void InspectorDialog::onWorkspaceChange() {
-  m_workspaceChanged = true;
-
-  QTimer::singleShot(0, this, SLOT(onTimeout()));
-}
-
-void InspectorDialog::onTimeout() {
-  if (m_workspaceObjectAdded) {
-    updateListWidgetData();
-    m_workspaceObjectAdded = false;
-  }
-
-  if (m_workspaceObjectRemoved) {
-    updateListWidgetData();
-    m_workspaceObjectRemoved = false;
-  }
-
-  if (m_workspaceChanged) {
-    loadTableWidgetData();
-    setSelectedObjectHandles(m_selectedObjectHandles, true);
-    m_workspaceChanged = false;
-  }
-}
-
-void InspectorDialog::onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
-                                              const openstudio::UUID& uuid) {
-  m_workspaceObjectRemoved = true;
-  m_workspaceChanged = true;
 
-  // if removed object is of current type
-  if (impl->iddObject().type() == m_iddObjectType) {
-
-    auto it = std::remove(m_objectHandles.begin(), m_objectHandles.end(), impl->handle());
-    if (it != m_objectHandles.end()) {
-      m_objectHandles.erase(it, m_objectHandles.end());
+    // do we want to do this or preserve the current selection?
+    // this functionality is now in onPushButtonNew
+    if (m_selectedObjectHandles.empty() && !added->second.empty()) {
+      m_selectedObjectHandles.push_back(added->second.front()->handle());
     }
+  }
 
-    it = std::remove(m_selectedObjectHandles.begin(), m_selectedObjectHandles.end(), impl->handle());
-    if (it != m_selectedObjectHandles.end()) {
-      m_selectedObjectHandles.erase(it, m_selectedObjectHandles.end());
+  // if removed objects are of current type
+  auto removed = batch.removed.find(m_iddObjectType);
+  if (removed != batch.removed.end()) {
+    for (const Handle& handle : removed->second) {
+      m_objectHandles.erase(std::remove(m_objectHandles.begin(), m_objectHandles.end(), handle), m_objectHandles.end());
+      m_selectedObjectHandles.erase(std::remove(m_selectedObjectHandles.begin(), m_selectedObjectHandles.end(), handle),
+                                    m_selectedObjectHandles.end());
     }
 
     if (m_selectedObjectHandles.empty()) {
@@ -479,7 +444,12 @@ void InspectorDialog::onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail
     }
   }
 
-  QTimer::singleShot(0, this, SLOT(onTimeout()));
+  if (!batch.added.empty() || !batch.removed.empty()) {
+    updateListWidgetData();
+  }
+
+  loadTableWidgetData();
+  setSelectedObjectHandles(m_selectedObjectHandles, true);
 }
 
 void InspectorDialog::init(InspectorDialogClient client) {
@@ -910,12 +880,15 @@ void InspectorDialog::connectSelfSignalsAndSlots() {
 }
 
 void InspectorDialog::connectModelSignalsAndSlots() {
-  m_model.getImpl<model::detail::Model_Impl>().get()->addWorkspaceObjectPtr.connect<InspectorDialog, &InspectorDialog::onAddWorkspaceObject>(this);
+  if (m_modelChangeBus) {
+    disconnect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &InspectorDialog::onModelChanges);
+  }
 
-  m_model.getImpl<model::detail::Model_Impl>().get()->onChange.connect<InspectorDialog, &InspectorDialog::onWorkspaceChange>(this);
+  m_modelChangeBus = ModelChangeBus::get(m_model);
+  // setModel loads the objects added so far, they must not come again in the next batch
+  m_modelChangeBus->flush();
 
-  m_model.getImpl<model::detail::Model_Impl>().get()->removeWorkspaceObjectPtr.connect<InspectorDialog, &InspectorDialog::onRemoveWorkspaceObject>(
-    this);
+  connect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &InspectorDialog::onModelChanges);
 }
 
 void InspectorDialog::hideSelectionWidget(bool hideSelectionWidget) {
@@ -1065,7 +1038,7 @@ void InspectorDialog::loadTableWidgetData() {
     if (object.name()) {
       displayName = object.name().get().c_str();
     }
-    unsigned numSources = object.numSources();
+    unsigned numSources = m_referenceIndex->numSources(object);
     displayName += QString(" (") + QString::number(numSources) + QString(")");
 
     auto tableItem = new QTableWidgetItem(displayName);
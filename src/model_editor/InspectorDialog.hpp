@@ -52,8 +52,11 @@ class QPushButton;
 class QShowEvent;
 class QCloseEvent;
 class InspectorGadget;
+class ReferenceIndex;
 
 namespace openstudio {
+class ModelChangeBus;
+struct ModelChangeBatch;
 class WorkspaceObject;
 
 namespace model {
@@ -152,12 +155,7 @@ class MODELEDITOR_API InspectorDialog : public QMainWindow, public Nano::Observe
   //void onCheckBox(bool checked);
   void onListWidgetSelectionChanged();
   void onTableWidgetSelectionChanged();
-  void onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
-                            const openstudio::UUID& uuid);
-  void onWorkspaceChange();
-  void onTimeout();
-  void onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
-                               const openstudio::UUID& uuid);
+  void onModelChanges(const openstudio::ModelChangeBatch& batch);
 
  private:
   QListWidget* m_listWidget;
@@ -182,9 +180,8 @@ class MODELEDITOR_API InspectorDialog : public QMainWindow, public Nano::Observe
   std::vector<openstudio::Handle> m_objectHandles;
   std::vector<openstudio::Handle> m_selectedObjectHandles;
   openstudio::model::Model m_model;
-  bool m_workspaceChanged;
-  bool m_workspaceObjectAdded;
-  bool m_workspaceObjectRemoved;
+  std::shared_ptr<ReferenceIndex> m_referenceIndex;
+  std::shared_ptr<openstudio::ModelChangeBus> m_modelChangeBus;
 
   void init(InspectorDialogClient client);
   void createWidgets();
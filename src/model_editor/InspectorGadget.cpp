@@ -33,6 +33,7 @@
 #include "IGLineEdit.hpp"
 #include "IGPrecisionDialog.hpp"
 #include "IGSpinBoxes.hpp"
+#include "ReferenceIndex.hpp"
 
 #include <openstudio/model/Model.hpp>
 #include <openstudio/model/ParentObject.hpp>
@@ -118,7 +119,8 @@ InspectorGadget::InspectorGadget(QWidget* parent, int indent, ComboHighlightBrid
     m_precision(1000),
     m_floatDisplayType(UNFORMATED),
     m_unitSystem(IP),
-    m_workspaceObjectChanged(false)
+    m_workspaceObjectChanged(false),
+    m_fieldLayout(nullptr)
 //m_workspaceObjs(std::vector<openstudio::OptionalWorkspaceObject>&())
 {
   m_layout = new QVBoxLayout(this);
@@ -151,7 +153,8 @@ InspectorGadget::InspectorGadget(WorkspaceObject& workspaceObj, int indent, Comb
     m_precision(precision),
     m_floatDisplayType(style),
     m_unitSystem(IP),
-    m_workspaceObjectChanged(false)
+    m_workspaceObjectChanged(false),
+    m_fieldLayout(nullptr)
 //m_workspaceObjs(std::vector<openstudio::OptionalWorkspaceObject>&())
 {
   m_layout = new QVBoxLayout(this);
@@ -210,6 +213,9 @@ void InspectorGadget::layoutModelObj(openstudio::WorkspaceObject& workspaceObj,
   }
 
   m_workspaceObj = workspaceObj;
+  if (!m_referenceIndex || !(m_referenceIndex->workspace() == workspaceObj.workspace())) {
+    m_referenceIndex = ReferenceIndex::get(workspaceObj.workspace());
+  }
 
   m_objectHasName = workspaceObj.name().has_value();
   if (m_objectHasName) {
@@ -264,6 +270,10 @@ void InspectorGadget::clear(bool recursive) {
     m_deleteHandle = nullptr;
   }
 
+  m_fieldRows.clear();
+  m_fieldLayout = nullptr;
+  m_childHandles.clear();
+
   // This line is commented out to prevent a crash when displaying the Inspector Gadget
   // within SketchUp 2016.  We have no idea why this works or what repercussions it may cause
   //m_workspaceObj.reset();
@@ -296,41 +306,17 @@ void InspectorGadget::layoutItems(QVBoxLayout* masterLayout, QWidget* parent, bo
   hlayout->addLayout(layout);
   layoutText(layout, parent, AccessPolicy::LOCKED, iddObj.type().valueDescription().c_str(), -1, comment);
 
+  m_objectComment = m_workspaceObj->comment();
+  m_fieldLayout = layout;
+  m_fieldRows.clear();
+
   AccessPolicy::ACCESS_LEVEL level;
   const AccessPolicy* pAccessPolicy = AccessPolicyStore::Instance().getPolicy(iddObj.type());
   for (unsigned int i = 0, iend = m_workspaceObj->numFields(); i < iend; ++i) {
-    openstudio::IddField field(*(iddObj.getField(i)));
-    if (pAccessPolicy) {
-      level = pAccessPolicy->getAccess(i);
-    } else {
-      level = AccessPolicy::FREE;
-    }
-
-    if (m_locked && (level == AccessPolicy::FREE)) {
-      level = AccessPolicy::LOCKED;
-    }
-
-    comment = *(m_workspaceObj->fieldComment(i, true));
-    // starting at 1 because the "base" obj is at 0
-    //for(unsigned it=1; i<m_workspaceObjs.size(); i++)
-    //{
-    //  if(comment == m_workspaceObjs[it]->fieldComment(i,true)){
-    //    // keep track of a field set to the value FIELDS_MATCH,
-    //    // if it changed, change the respective elements in any
-    //    // other
-    //    comment == FIELDS_MATCH;
-    //    break;
-    //  }
-    //}
-
-    //Strip off prefix of "!"
-    if (comment.size() >= 1) {
-      string::size_type i = comment.find('!');
-      if (i != string::npos) {
-        comment.erase(0, i + 1);
-      }
-    }
-    parseItem(layout, parent, field, field.name(), *(m_workspaceObj->getString(i, true)), level, i, comment, true);
+    std::string value = *(m_workspaceObj->getString(i, true));
+    std::string fieldComment = *(m_workspaceObj->fieldComment(i, true));
+    QWidget* row = layoutField(layout, parent, i, value, fieldComment);
+    m_fieldRows.push_back(FieldRow{value, fieldComment, row});
   }
 
   const IddObjectProperties& props = m_workspaceObj->iddObject().properties();
@@ -359,9 +345,11 @@ void InspectorGadget::layoutItems(QVBoxLayout* masterLayout, QWidget* parent, bo
   }
   // model only follows...
   OptionalParentObject p = m_workspaceObj->optionalCast<ParentObject>();
+  m_childHandles.clear();
   if (p && (!hideChildren)) {
     ModelObjectVector cvec = p->children();
     for (auto& elem : cvec) {
+      m_childHandles.push_back(elem.handle());
       auto igChildItr = m_childMap.find(elem);
       if (igChildItr != m_childMap.end()) {
         InspectorGadget* igchild = igChildItr->second;
@@ -384,6 +372,84 @@ void InspectorGadget::layoutItems(QVBoxLayout* masterLayout, QWidget* parent, bo
   if (m_stretch) masterLayout->addStretch();
 }
 
+QWidget* InspectorGadget::layoutField(QVBoxLayout* layout, QWidget* parent, unsigned index, const std::string& value, std::string comment) {
+  IddObject iddObj = m_workspaceObj->iddObject();
+  openstudio::IddField field(*(iddObj.getField(index)));
+
+  AccessPolicy::ACCESS_LEVEL level = AccessPolicy::FREE;
+  const AccessPolicy* pAccessPolicy = AccessPolicyStore::Instance().getPolicy(iddObj.type());
+  if (pAccessPolicy) {
+    level = pAccessPolicy->getAccess(index);
+  }
+
+  if (m_locked && (level == AccessPolicy::FREE)) {
+    level = AccessPolicy::LOCKED;
+  }
+
+  //Strip off prefix of "!"
+  if (comment.size() >= 1) {
+    string::size_type i = comment.find('!');
+    if (i != string::npos) {
+      comment.erase(0, i + 1);
+    }
+  }
+
+  // parseItem adds at most one row, nothing for hidden fields
+  int count = layout->count();
+  parseItem(layout, parent, field, field.name(), value, level, index, comment, true);
+  if (layout->count() > count) {
+    return layout->itemAt(count)->widget();
+  }
+  return nullptr;
+}
+
+bool InspectorGadget::updateFields() {
+  if (!m_deleteHandle || !m_fieldLayout || !m_workspaceObj) {
+    return false;
+  }
+
+  // extensible groups added or removed, or children changed
+  if ((m_workspaceObj->numFields() != m_fieldRows.size()) || (m_workspaceObj->comment() != m_objectComment)) {
+    return false;
+  }
+  if (!m_childHandles.empty() || !m_lastHideChildren) {
+    std::vector<openstudio::Handle> childHandles;
+    if (OptionalParentObject p = m_workspaceObj->optionalCast<ParentObject>()) {
+      for (const ModelObject& child : p->children()) {
+        childHandles.push_back(child.handle());
+      }
+    }
+    if (childHandles != m_childHandles) {
+      return false;
+    }
+  }
+
+  for (unsigned i = 0, iend = m_fieldRows.size(); i < iend; ++i) {
+    FieldRow& fieldRow = m_fieldRows[i];
+    std::string value = *(m_workspaceObj->getString(i, true));
+    std::string fieldComment = *(m_workspaceObj->fieldComment(i, true));
+    if ((value == fieldRow.value) && (fieldComment == fieldRow.comment)) {
+      continue;
+    }
+
+    QWidget* row = nullptr;
+    if (fieldRow.widget) {
+      // build the new row aside and put it in place of the old one
+      QVBoxLayout rowLayout;
+      row = layoutField(&rowLayout, m_deleteHandle, i, value, fieldComment);
+      if (row) {
+        rowLayout.removeWidget(row);
+        m_fieldLayout->insertWidget(m_fieldLayout->indexOf(fieldRow.widget), row);
+        row->show();
+      }
+      delete fieldRow.widget;
+    }
+    fieldRow = FieldRow{value, fieldComment, row};
+  }
+
+  return true;
+}
+
 void InspectorGadget::parseItem(QVBoxLayout* layout, QWidget* parent, openstudio::IddField& field, const std::string& name, const std::string& curVal,
                                 openstudio::model::AccessPolicy::ACCESS_LEVEL level, int index, const std::string& comment, bool exists) {
   IddFieldProperties prop = field.properties();
@@ -754,16 +820,17 @@ void InspectorGadget::layoutComboBox(QVBoxLayout* layout, QWidget* parent, opens
   combo->setSizeAdjustPolicy(QComboBox::AdjustToContentsOnFirstShow);
 
   if (prop.objectLists.size() && m_workspaceObj && !m_workspaceObj->handle().isNull()) {
-    Workspace workspace = m_workspaceObj->workspace();
     std::vector<std::string> names;
 
+    // each list is already sorted
     for (const std::string& objectList : prop.objectLists) {
-      for (const WorkspaceObject& workspaceObject : workspace.getObjectsByReference(objectList)) {
-        names.push_back(workspaceObject.name().get());
-      }
+      const std::vector<std::string>& listNames = m_referenceIndex->names(objectList);
+      names.insert(names.end(), listNames.begin(), listNames.end());
     }
 
-    std::sort(names.begin(), names.end(), IstringCompare());
+    if (prop.objectLists.size() > 1) {
+      std::sort(names.begin(), names.end(), IstringCompare());
+    }
 
     if (!prop.required) {
       combo->addItem("");
@@ -1105,7 +1172,8 @@ void InspectorGadget::onWorkspaceObjectChanged() {
 
 void InspectorGadget::onTimeout() {
   if (m_workspaceObjectChanged && m_workspaceObj && !m_workspaceObj->handle().isNull()) {
-    if (m_workspaceObj) {
+    // only rebuild the rows of the fields that changed if the layout of the object is the same
+    if (!updateFields()) {
       rebuild(false);
     }
     m_workspaceObjectChanged = false;
@@ -47,6 +47,7 @@
 #include <openstudio/utilities/idf/WorkspaceObject.hpp>
 #include <openstudio/utilities/idf/WorkspaceObject_Impl.hpp>
 
+#include <memory>
 #include <string>
 
 class QDoubleSpinBox;
@@ -57,6 +58,7 @@ class QSpinBox;
 class QVBoxLayout;
 
 class ComboHighlightBridge;
+class ReferenceIndex;
 
 class MODELEDITOR_API IGWidget : public QWidget, public Nano::Observer
 {
@@ -292,6 +294,16 @@ class MODELEDITOR_API InspectorGadget : public QWidget, public Nano::Observer
     */
   virtual void layoutItems(QVBoxLayout* layout, QWidget* parent, bool hideChildren = false);
 
+  /*! lays out the row of an existing field, returns the row or nullptr if the field is hidden
+   */
+  QWidget* layoutField(QVBoxLayout* layout, QWidget* parent, unsigned index, const std::string& value, std::string comment);
+
+  /*! rebuilds only the rows of the fields that changed since the layout
+   *
+   * returns false if the object has a different number of fields, comment or children, it then needs a rebuild
+   */
+  bool updateFields();
+
   void parseItem(QVBoxLayout* layout, QWidget* parent, openstudio::IddField& field, const std::string& name, const std::string& curVal,
                  openstudio::model::AccessPolicy::ACCESS_LEVEL level, int index, const std::string& comment, bool exists);
 
@@ -318,6 +330,8 @@ class MODELEDITOR_API InspectorGadget : public QWidget, public Nano::Observer
   int m_indent;  // how much we indent each IGChildFrame widget by
   // TODO replace below by m_workspaceObjs[0]
   openstudio::OptionalWorkspaceObject m_workspaceObj;
+  // names of the objects for the combo boxes, shared with the other views of the workspace
+  std::shared_ptr<ReferenceIndex> m_referenceIndex;
   //std::vector<openstudio::OptionalWorkspaceObject>& m_workspaceObjs;
   QErrorMessage* m_errorMessage;
   bool m_locked;
@@ -341,6 +355,18 @@ class MODELEDITOR_API InspectorGadget : public QWidget, public Nano::Observer
   UNIT_SYSTEM m_unitSystem;
   bool m_workspaceObjectChanged;
 
+  // value and comment each field row was built with
+  struct FieldRow
+  {
+    std::string value;
+    std::string comment;
+    QWidget* widget;
+  };
+  std::vector<FieldRow> m_fieldRows;
+  QVBoxLayout* m_fieldLayout;
+  std::string m_objectComment;
+  std::vector<openstudio::Handle> m_childHandles;
+
   typedef std::map<openstudio::model::ModelObject, InspectorGadget*> MODELMAP;
   MODELMAP m_childMap;
 
@@ -0,0 +1,240 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "ModelChangeBus.hpp"
+
+#include <openstudio/model/Model_Impl.hpp>
+#include <openstudio/utilities/idd/IddObject.hpp>
+#include <openstudio/utilities/idf/IdfObject_Impl.hpp>
+
+#include <QTimer>
+
+#include <algorithm>
+
+namespace openstudio {
+
+bool ModelChangeBatch::empty() const {
+  return added.empty() && removed.empty() && changed.empty();
+}
+
+size_t ModelChangeBatch::size() const {
+  size_t result = 0;
+  for (const auto* objectsByType : {&added, &changed}) {
+    for (const auto& [type, objects] : *objectsByType) {
+      result += objects.size();
+    }
+  }
+  for (const auto& [type, handles] : removed) {
+    result += handles.size();
+  }
+  return result;
+}
+
+bool ModelChangeBatch::contains(const openstudio::IddObjectType& type) const {
+  return (added.count(type) != 0) || (removed.count(type) != 0) || (changed.count(type) != 0);
+}
+
+std::set<openstudio::IddObjectType> ModelChangeBatch::types() const {
+  std::set<openstudio::IddObjectType> result;
+  for (const auto* objectsByType : {&added, &changed}) {
+    for (const auto& [type, objects] : *objectsByType) {
+      result.insert(type);
+    }
+  }
+  for (const auto& [type, handles] : removed) {
+    result.insert(type);
+  }
+  return result;
+}
+
+struct ModelChangeBus::ChangeObserver : public Nano::Observer
+{
+  ChangeObserver(ModelChangeBus* bus, std::weak_ptr<openstudio::detail::WorkspaceObject_Impl> impl) : bus(bus), impl(std::move(impl)) {}
+
+  void onChange() {
+    if (auto object = impl.lock()) {
+      bus->onObjectChange(object);
+    }
+  }
+
+  ModelChangeBus* bus;
+  std::weak_ptr<openstudio::detail::WorkspaceObject_Impl> impl;
+};
+
+ModelChangeBus::ModelChangeBus(const openstudio::model::Model& model) : QObject(), m_model(model) {
+  auto modelImpl = m_model.getImpl<openstudio::model::detail::Model_Impl>();
+  modelImpl->addWorkspaceObjectPtr.connect<ModelChangeBus, &ModelChangeBus::onAddWorkspaceObject>(this);
+  modelImpl->removeWorkspaceObjectPtr.connect<ModelChangeBus, &ModelChangeBus::onRemoveWorkspaceObject>(this);
+
+  for (const openstudio::WorkspaceObject& object : m_model.objects()) {
+    connectObject(object.getImpl<openstudio::detail::WorkspaceObject_Impl>());
+  }
+}
+
+ModelChangeBus::~ModelChangeBus() {}
+
+static std::map<const void*, std::weak_ptr<ModelChangeBus>>& registry() {
+  static std::map<const void*, std::weak_ptr<ModelChangeBus>> result;
+  return result;
+}
+
+std::shared_ptr<ModelChangeBus> ModelChangeBus::get(const openstudio::model::Model& model) {
+  const void* key = model.getImpl<openstudio::model::detail::Model_Impl>().get();
+
+  // forget the buses no one holds anymore
+  for (auto it = registry().begin(); it != registry().end();) {
+    if (it->second.expired()) {
+      it = registry().erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = registry().find(key);
+  if (it != registry().end()) {
+    return it->second.lock();
+  }
+
+  auto result = std::make_shared<ModelChangeBus>(model);
+  registry()[key] = result;
+  return result;
+}
+
+openstudio::model::Model ModelChangeBus::model() const {
+  return m_model;
+}
+
+void ModelChangeBus::connectObject(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl) {
+  auto observer = std::make_unique<ChangeObserver>(this, impl);
+  impl->openstudio::detail::IdfObject_Impl::onChange.connect<ChangeObserver, &ChangeObserver::onChange>(observer.get());
+  m_changeObservers[impl->handle()] = std::move(observer);
+}
+
+void ModelChangeBus::onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                                          const openstudio::UUID& handle) {
+  connectObject(impl);
+
+  m_added.push_back({type, handle, impl});
+  m_addedHandles.insert(handle);
+  record();
+}
+
+void ModelChangeBus::onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                                             const openstudio::UUID& handle) {
+  m_changeObservers.erase(handle);
+
+  // Added during this turn, the subscribers never heard of it
+  if (m_addedHandles.erase(handle) != 0) {
+    return;
+  }
+
+  m_removed[type].push_back(handle);
+  m_removedHandles.insert(handle);
+  record();
+}
+
+void ModelChangeBus::onObjectChange(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl) {
+  const openstudio::Handle handle = impl->handle();
+  // An object added during this turn is delivered as added, and each changed object once
+  if ((m_addedHandles.count(handle) != 0) || !m_changedHandles.insert(handle).second) {
+    return;
+  }
+
+  m_changed.push_back({impl->iddObject().type(), handle, impl});
+  record();
+}
+
+size_t ModelChangeBus::queueDepth() const {
+  return m_queueDepth;
+}
+
+const ModelChangeBus::Metrics& ModelChangeBus::metrics() const {
+  return m_metrics;
+}
+
+void ModelChangeBus::record() {
+  ++m_queueDepth;
+  m_metrics.maxQueueDepth = std::max(m_metrics.maxQueueDepth, m_queueDepth);
+
+  if (!m_flushScheduled) {
+    m_flushScheduled = true;
+    m_pendingSince.start();
+    QTimer::singleShot(0, this, &ModelChangeBus::flush);
+  }
+}
+
+void ModelChangeBus::flush() {
+  // The scheduled flush may find nothing left if flush() was called directly in between
+  m_flushScheduled = false;
+  if (m_queueDepth == 0) {
+    return;
+  }
+
+  // Subscribers may change the model, their notifications go to the next batch
+  ModelChangeBatch batch;
+  for (const PendingObject& pending : m_added) {
+    if (m_addedHandles.count(pending.handle) != 0) {
+      if (auto impl = pending.impl.lock()) {
+        batch.added[pending.type].push_back(impl);
+      }
+    }
+  }
+  for (const PendingObject& pending : m_changed) {
+    if (m_removedHandles.count(pending.handle) == 0) {
+      if (auto impl = pending.impl.lock()) {
+        batch.changed[pending.type].push_back(impl);
+      }
+    }
+  }
+  std::swap(batch.removed, m_removed);
+
+  m_added.clear();
+  m_changed.clear();
+  m_removed.clear();
+  m_addedHandles.clear();
+  m_changedHandles.clear();
+  m_removedHandles.clear();
+  const size_t depth = m_queueDepth;
+  m_queueDepth = 0;
+
+  m_metrics.lastLatency = m_pendingSince.elapsed();
+  m_metrics.maxLatency = std::max(m_metrics.maxLatency, m_metrics.lastLatency);
+  ++m_metrics.batches;
+  m_metrics.notifications += depth;
+
+  if (batch.empty()) {
+    return;
+  }
+
+  LOG(Debug, "Delivering " << batch.size() << " changes of " << batch.types().size() << " types after " << m_metrics.lastLatency << " ms");
+
+  emit changesReady(batch);
+}
+
+}  // namespace openstudio
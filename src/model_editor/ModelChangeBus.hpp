@@ -0,0 +1,176 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef MODELEDITOR_MODELCHANGEBUS_HPP
+#define MODELEDITOR_MODELCHANGEBUS_HPP
+
+#include "ModelEditorAPI.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
+#include <openstudio/utilities/core/Logger.hpp>
+#include <openstudio/utilities/core/UUID.hpp>
+#include <openstudio/utilities/idd/IddEnums.hxx>
+#include <openstudio/utilities/idf/WorkspaceObject_Impl.hpp>
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include <boost/functional/hash.hpp>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace openstudio {
+
+/** The objects added, removed and changed in a model during one turn of the event loop, by type.
+  *
+  * An object added and removed in the same turn is in neither list, and the changes of the objects added or removed
+  * during the turn are not listed. Removed objects are only listed by handle, the batch does not keep them alive.
+  **/
+struct MODELEDITOR_API ModelChangeBatch
+{
+  using Objects = std::vector<std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>>;
+
+  std::map<openstudio::IddObjectType, Objects> added;
+  std::map<openstudio::IddObjectType, std::vector<openstudio::Handle>> removed;
+  std::map<openstudio::IddObjectType, Objects> changed;
+
+  bool empty() const;
+
+  // Number of notifications in the batch
+  size_t size() const;
+
+  // Whether any object of this type was added, removed or changed
+  bool contains(const openstudio::IddObjectType& type) const;
+
+  std::set<openstudio::IddObjectType> types() const;
+};
+
+/** ModelChangeBus coalesces the workspace notifications of a model and delivers them once per turn of the event loop,
+  * so that a view listening to every add, remove and change rebuilds once for an operation touching thousands of
+  * objects (loading a library, applying a measure, deleting a story) rather than once per object.
+  *
+  * The bus listens to the model signals. The change signal of an object does not say which object it is, so each object
+  * is connected through an observer that knows it. Pending objects are held by weak reference, an object destroyed
+  * before the delivery is left out of the batch.
+  *
+  * One bus is shared by all the views of a model, get it with ModelChangeBus::get and hold on to it.
+  **/
+class MODELEDITOR_API ModelChangeBus : public QObject, public Nano::Observer
+{
+  Q_OBJECT;
+
+ public:
+  struct Metrics
+  {
+    // batches delivered and notifications they held
+    size_t batches = 0;
+    size_t notifications = 0;
+    // largest number of notifications waiting for delivery
+    size_t maxQueueDepth = 0;
+    // time in milliseconds from the first notification of a batch to its delivery
+    qint64 lastLatency = 0;
+    qint64 maxLatency = 0;
+  };
+
+  explicit ModelChangeBus(const openstudio::model::Model& model);
+
+  virtual ~ModelChangeBus();
+
+  ModelChangeBus(const ModelChangeBus&) = delete;
+  ModelChangeBus& operator=(const ModelChangeBus&) = delete;
+
+  /// the bus of model, created if no one holds one yet
+  static std::shared_ptr<ModelChangeBus> get(const openstudio::model::Model& model);
+
+  openstudio::model::Model model() const;
+
+  // Number of notifications waiting for the next batch
+  size_t queueDepth() const;
+
+  const Metrics& metrics() const;
+
+  // Deliver the pending notifications now rather than on the next turn of the event loop
+  void flush();
+
+ signals:
+
+  // Connect directly: the batch is only valid during the call
+  void changesReady(const openstudio::ModelChangeBatch& batch);
+
+ private:
+  REGISTER_LOGGER("openstudio.ModelChangeBus");
+
+  struct ChangeObserver;
+
+  struct PendingObject
+  {
+    openstudio::IddObjectType type;
+    openstudio::Handle handle;
+    std::weak_ptr<openstudio::detail::WorkspaceObject_Impl> impl;
+  };
+
+  void onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                            const openstudio::UUID& handle);
+
+  void onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                               const openstudio::UUID& handle);
+
+  void onObjectChange(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl);
+
+  void connectObject(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl);
+
+  void record();
+
+  openstudio::model::Model m_model;
+
+  std::unordered_map<openstudio::Handle, std::unique_ptr<ChangeObserver>, boost::hash<openstudio::Handle>> m_changeObservers;
+
+  // Notifications of the current turn, the handles tell what was added, changed and removed so far
+  std::vector<PendingObject> m_added;
+  std::vector<PendingObject> m_changed;
+  std::map<openstudio::IddObjectType, std::vector<openstudio::Handle>> m_removed;
+  std::unordered_set<openstudio::Handle, boost::hash<openstudio::Handle>> m_addedHandles;
+  std::unordered_set<openstudio::Handle, boost::hash<openstudio::Handle>> m_changedHandles;
+  std::unordered_set<openstudio::Handle, boost::hash<openstudio::Handle>> m_removedHandles;
+
+  size_t m_queueDepth = 0;
+  bool m_flushScheduled = false;
+  QElapsedTimer m_pendingSince;
+  Metrics m_metrics;
+};
+
+}  // namespace openstudio
+
+#endif  // MODELEDITOR_MODELCHANGEBUS_HPP
@@ -35,41 +35,67 @@
 #include <openstudio/utilities/core/Checksum.hpp>
 #include <openstudio/utilities/core/Assert.hpp>
 
+#include <QDateTime>
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QTimer>
 
+// a file modified this recently may be written again without its size or modification time changing
+static constexpr qint64 racyMsec = 2000;
+
+// window used to coalesce events when the path is not polled
+static constexpr int defaultCoalesceMsec = 100;
+
 /// constructor
 PathWatcher::PathWatcher(const openstudio::path& p, int msec)
   : m_impl(new QFileSystemWatcher()),
+    m_coalesceTimer(new QTimer()),
     m_enabled(true),
     m_isDirectory(openstudio::filesystem::is_directory(p) || openstudio::toString(p.filename()) == "." || openstudio::toString(p.filename()) == "/"),
-    m_exists(openstudio::filesystem::exists(p)),
+    m_exists(false),
     m_dirty(false),
-    m_checksum(openstudio::checksum(p)),
+    m_size(-1),
+    m_lastModified(-1),
+    m_racy(false),
     m_path(p),
     m_msec(msec) {
   // make sure a QApplication exists
   openstudio::Application::instance().application(false);
   openstudio::Application::instance().processEvents();
 
+  resetState();
+
+  m_coalesceTimer->setSingleShot(true);
+  connect(m_coalesceTimer.get(), &QTimer::timeout, this, &PathWatcher::runPendingCheck);
+
   if (m_isDirectory) {
 
     if (!m_exists) {
       LOG_FREE_AND_THROW("openstudio.PathWatcher", "Directory '" << openstudio::toString(p) << "' does not exist, cannot be watched");
     }
 
-    connect(m_impl.get(), &QFileSystemWatcher::directoryChanged, this, &PathWatcher::directoryChanged);
+    connect(m_impl.get(), &QFileSystemWatcher::directoryChanged, this, &PathWatcher::onWatcherEvent);
     m_impl->addPath(openstudio::toQString(p));
 
   } else {
     m_timer = std::shared_ptr<QTimer>(new QTimer());
     connect(m_timer.get(), &QTimer::timeout, this, &PathWatcher::checkFile);
-    m_timer->start(m_msec);
+    if (m_msec > 0) {
+      m_timer->start(m_msec);
+    }
 
-    // DLM: do not use QFileSystemWatcher to watch individual files, was acting glitchy
-    //connected = this->connect(m_impl.get(), SIGNAL(fileChanged(const QString&)), SLOT(fileChanged(const QString&)));
-    //OS_ASSERT(connected);
-    //m_impl->addPath(openstudio::toQString(p));
+    // DLM: QFileSystemWatcher was acting glitchy on individual files, its events only trigger a check and the
+    // periodic check remains in case one is missed. The parent directory is watched to see the file created or replaced.
+    connect(m_impl.get(), &QFileSystemWatcher::fileChanged, this, &PathWatcher::onWatcherEvent);
+    connect(m_impl.get(), &QFileSystemWatcher::directoryChanged, this, &PathWatcher::onWatcherEvent);
+    openstudio::path parent = m_path.parent_path();
+    if (parent.empty()) {
+      parent = openstudio::toPath(".");
+    }
+    if (openstudio::filesystem::is_directory(parent)) {
+      m_impl->addPath(openstudio::toQString(parent));
+    }
+    watchFile();
   }
 }
 
@@ -82,13 +108,13 @@ bool PathWatcher::enabled() const {
 void PathWatcher::enable() {
   m_enabled = true;
 
-  if (!m_timer->isActive()) {
+  if (m_timer && m_msec > 0 && !m_timer->isActive()) {
     m_timer->start(m_msec);
   }
 }
 
 bool PathWatcher::disable() {
-  if (m_timer->isActive()) {
+  if (m_timer && m_timer->isActive()) {
     m_timer->stop();
   }
 
@@ -106,9 +132,8 @@ bool PathWatcher::dirty() const {
 }
 
 void PathWatcher::clearState() {
-  m_exists = openstudio::filesystem::exists(m_path);
+  resetState();
   m_dirty = false;
-  m_checksum = openstudio::checksum(m_path);
 }
 
 void PathWatcher::onPathAdded() {}
@@ -159,8 +184,8 @@ void PathWatcher::fileChanged(const QString& path) {
 }
 
 void PathWatcher::checkFile() {
-  bool exists = openstudio::filesystem::exists(m_path);
-  std::string checksum = openstudio::checksum(m_path);
+  bool exists = false;
+  std::string checksum = currentChecksum(exists);
 
   if (checksum == "00000000") {
     exists = false;
@@ -184,7 +209,7 @@ void PathWatcher::checkFile() {
     // used to exist, now does not
     m_dirty = true;
     m_exists = exists;
-    m_checksum = openstudio::checksum(m_path);
+    m_checksum = checksum;
 
     if (m_enabled) {
       onPathRemoved();
@@ -195,7 +220,7 @@ void PathWatcher::checkFile() {
     // did not exist, now does
     m_dirty = true;
     m_exists = exists;
-    m_checksum = openstudio::checksum(m_path);
+    m_checksum = checksum;
 
     if (m_enabled) {
       onPathAdded();
@@ -205,4 +230,77 @@ void PathWatcher::checkFile() {
     // !m_exists && !exists
     // no change
   }
+
+  watchFile();
+}
+
+void PathWatcher::onWatcherEvent() {
+  // file changes are picked up by the periodic check once the watcher is enabled again
+  if (!m_isDirectory && !m_enabled) {
+    return;
+  }
+
+  if (m_coalesceTimer->isActive()) {
+    return;
+  }
+
+  // the first event of a burst is handled right away, the following ones once the window elapses
+  const qint64 window = m_msec > 0 ? m_msec : defaultCoalesceMsec;
+  if (!m_sinceCheck.isValid() || m_sinceCheck.elapsed() >= window) {
+    runPendingCheck();
+  } else {
+    m_coalesceTimer->start(static_cast<int>(window - m_sinceCheck.elapsed()));
+  }
+}
+
+void PathWatcher::runPendingCheck() {
+  m_sinceCheck.restart();
+
+  if (m_isDirectory) {
+    directoryChanged(openstudio::toQString(m_path));
+  } else {
+    checkFile();
+  }
+}
+
+std::string PathWatcher::currentChecksum(bool& exists) {
+  QFileInfo info(openstudio::toQString(m_path));
+  exists = info.exists();
+  if (!exists) {
+    m_size = -1;
+    m_lastModified = -1;
+    m_racy = false;
+    return "00000000";
+  }
+
+  const qint64 size = info.size();
+  const qint64 lastModified = info.lastModified().toMSecsSinceEpoch();
+  if (size == m_size && lastModified == m_lastModified && !m_racy) {
+    return m_checksum;
+  }
+
+  m_size = size;
+  m_lastModified = lastModified;
+  m_racy = QDateTime::currentMSecsSinceEpoch() - lastModified < racyMsec;
+  return openstudio::checksum(m_path);
+}
+
+void PathWatcher::resetState() {
+  if (m_isDirectory) {
+    m_exists = openstudio::filesystem::exists(m_path);
+    return;
+  }
+
+  // the checksum of a file that does not exist is "00000000"
+  bool exists = false;
+  m_checksum = currentChecksum(exists);
+  m_exists = openstudio::filesystem::exists(m_path);
+}
+
+void PathWatcher::watchFile() {
+  // QFileSystemWatcher stops watching a file that is removed or replaced
+  const QString path = openstudio::toQString(m_path);
+  if (m_exists && !m_impl->files().contains(path)) {
+    m_impl->addPath(path);
+  }
 }
@@ -32,6 +32,7 @@
 
 #include <openstudio/utilities/core/Path.hpp>
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
 
@@ -41,6 +42,10 @@ class QTimer;
 
 /** Class for watching either a file or directory, QFileSystemWatcher has issues when watching
   **  many files so it is not recommended to use too many of these objects.
+  **
+  **  Files are checked when QFileSystemWatcher reports an event for the file or its directory, and periodically in case
+  **  an event is missed. A check only stats the file, the checksum is computed when its size or modification time changed
+  **  or when that time is too recent to tell writes apart.
   **/
 class PathWatcher : public QObject
 {
@@ -53,7 +58,8 @@ class PathWatcher : public QObject
   /// if path is a directory it must exist at time of construction, no periodic checks are performed for directory
   /// if path is not a directory it is assumed to be a regular file which may or may not exist at construction,
   /// a timer is used to periodically check for changes to the file
-  /// msec is the timer delay to check for updates to the file, msec does not apply if the path is a directory
+  /// msec is the timer delay to check for updates to the file, checks only rely on file system events if msec is 0,
+  /// events received within msec of a check are coalesced into a single check when it elapses
   PathWatcher(const openstudio::path& p, int msec = 1000);
 
   /// virtual destructor
@@ -99,16 +105,38 @@ class PathWatcher : public QObject
   /// periodically check for changes
   void checkFile();
 
+ private slots:
+
+  /// called for any event of the file system watcher
+  void onWatcherEvent();
+
+  /// runs the check coalescing the events received since the last one
+  void runPendingCheck();
+
  private:
+  /// stat the file, and checksum it if its metadata changed since the last call
+  std::string currentChecksum(bool& exists);
+
+  /// record the current state of the path as clean
+  void resetState();
+
+  /// watch the file again if it was replaced
+  void watchFile();
+
   /// impl
   std::shared_ptr<QFileSystemWatcher> m_impl;
   std::shared_ptr<QTimer> m_timer;
+  std::shared_ptr<QTimer> m_coalesceTimer;
+  QElapsedTimer m_sinceCheck;
 
   bool m_enabled;
   bool m_isDirectory;
   bool m_exists;
   bool m_dirty;
   std::string m_checksum;
+  qint64 m_size;
+  qint64 m_lastModified;
+  bool m_racy;
   openstudio::path m_path;
   int m_msec;
 };
@@ -0,0 +1,164 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "ReferenceIndex.hpp"
+
+#include <openstudio/utilities/core/Compare.hpp>
+#include <openstudio/utilities/idd/IddObject.hpp>
+#include <openstudio/utilities/idf/IdfObject_Impl.hpp>
+#include <openstudio/utilities/idf/Workspace_Impl.hpp>
+#include <openstudio/utilities/idf/WorkspaceObject_Impl.hpp>
+
+#include <algorithm>
+
+struct ReferenceIndex::NameObserver : public Nano::Observer
+{
+  NameObserver(ReferenceIndex* index, std::vector<std::string> references) : index(index), references(std::move(references)) {}
+
+  void onNameChange() {
+    for (const std::string& reference : references) {
+      index->m_names.erase(reference);
+    }
+  }
+
+  ReferenceIndex* index;
+  std::vector<std::string> references;
+};
+
+ReferenceIndex::ReferenceIndex(const openstudio::Workspace& workspace) : m_workspace(workspace) {
+  auto workspaceImpl = m_workspace.getImpl<openstudio::detail::Workspace_Impl>();
+  workspaceImpl->addWorkspaceObjectPtr.connect<ReferenceIndex, &ReferenceIndex::onAddWorkspaceObject>(this);
+  workspaceImpl->removeWorkspaceObjectPtr.connect<ReferenceIndex, &ReferenceIndex::onRemoveWorkspaceObject>(this);
+
+  for (const openstudio::WorkspaceObject& object : m_workspace.objects()) {
+    connectObject(object.getImpl<openstudio::detail::WorkspaceObject_Impl>());
+  }
+}
+
+ReferenceIndex::~ReferenceIndex() {}
+
+static std::map<const void*, std::weak_ptr<ReferenceIndex>>& registry() {
+  static std::map<const void*, std::weak_ptr<ReferenceIndex>> result;
+  return result;
+}
+
+std::shared_ptr<ReferenceIndex> ReferenceIndex::get(const openstudio::Workspace& workspace) {
+  const void* key = workspace.getImpl<openstudio::detail::Workspace_Impl>().get();
+
+  // forget the indexes no one holds anymore
+  for (auto it = registry().begin(); it != registry().end();) {
+    if (it->second.expired()) {
+      it = registry().erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = registry().find(key);
+  if (it != registry().end()) {
+    return it->second.lock();
+  }
+
+  auto result = std::make_shared<ReferenceIndex>(workspace);
+  registry()[key] = result;
+  return result;
+}
+
+openstudio::Workspace ReferenceIndex::workspace() const {
+  return m_workspace;
+}
+
+const std::vector<std::string>& ReferenceIndex::names(const std::string& reference) {
+  auto it = m_names.find(reference);
+  if (it == m_names.end()) {
+    std::vector<std::string> names;
+    for (const openstudio::WorkspaceObject& workspaceObject : m_workspace.getObjectsByReference(reference)) {
+      names.push_back(workspaceObject.name().get());
+    }
+    std::sort(names.begin(), names.end(), openstudio::IstringCompare());
+    it = m_names.emplace(reference, std::move(names)).first;
+  }
+  return it->second;
+}
+
+unsigned ReferenceIndex::numSources(const openstudio::WorkspaceObject& object) {
+  auto it = m_numSources.find(object.handle());
+  if (it == m_numSources.end()) {
+    it = m_numSources.emplace(object.handle(), object.numSources()).first;
+  }
+  return it->second;
+}
+
+void ReferenceIndex::onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                                          const openstudio::UUID& uuid) {
+  for (const std::string& reference : impl->iddObject().references()) {
+    m_names.erase(reference);
+  }
+
+  // the new object is a new source of the objects it points to
+  for (const openstudio::WorkspaceObject& target : impl->targets()) {
+    m_numSources.erase(target.handle());
+  }
+
+  connectObject(impl);
+}
+
+void ReferenceIndex::onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                                             const openstudio::UUID& uuid) {
+  for (const std::string& reference : impl->iddObject().references()) {
+    m_names.erase(reference);
+  }
+
+  m_numSources.erase(uuid);
+
+  // the removed object is no longer a source of the objects it points to. Pointers cleared before this signal already
+  // dropped their target in onRelationshipChange
+  for (const openstudio::WorkspaceObject& target : impl->targets()) {
+    m_numSources.erase(target.handle());
+  }
+}
+
+void ReferenceIndex::onRelationshipChange(int index, openstudio::Handle newHandle, openstudio::Handle oldHandle) {
+  m_numSources.erase(newHandle);
+  m_numSources.erase(oldHandle);
+}
+
+void ReferenceIndex::connectObject(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl) {
+  impl->onRelationshipChange.connect<ReferenceIndex, &ReferenceIndex::onRelationshipChange>(this);
+
+  // only the names of referenceable objects are listed
+  std::vector<std::string> references = impl->iddObject().references();
+  if (!references.empty()) {
+    auto& nameObserver = m_nameObservers[impl->iddObject().type()];
+    if (!nameObserver) {
+      nameObserver = std::make_unique<NameObserver>(this, std::move(references));
+    }
+    impl->openstudio::detail::IdfObject_Impl::onNameChange.connect<NameObserver, &NameObserver::onNameChange>(nameObserver.get());
+  }
+}
@@ -0,0 +1,107 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef MODELEDITOR_REFERENCEINDEX_HPP
+#define MODELEDITOR_REFERENCEINDEX_HPP
+
+#include "ModelEditorAPI.hpp"
+
+#include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
+
+#include <openstudio/utilities/core/UUID.hpp>
+#include <openstudio/utilities/idd/IddEnums.hpp>
+#include <openstudio/utilities/idf/Workspace.hpp>
+#include <openstudio/utilities/idf/WorkspaceObject.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+namespace detail {
+class WorkspaceObject_Impl;
+}
+}  // namespace openstudio
+
+/** ReferenceIndex caches what InspectorDialog and InspectorGadget look up for every row and every object list field:
+  *  the sorted names of the objects in a reference list, and the number of sources of an object.
+  *
+  *  Entries are computed on first use and kept until the workspace signals that they changed: adding or removing an
+  *  object drops the lists of its references and the counts of its targets, renaming an object drops the lists of its
+  *  references, and a pointer change drops the counts of its old and new targets.
+  *
+  *  One index is shared by all the views of a workspace, get it with ReferenceIndex::get and hold on to it.
+  **/
+class MODELEDITOR_API ReferenceIndex : public Nano::Observer
+{
+ public:
+  explicit ReferenceIndex(const openstudio::Workspace& workspace);
+
+  virtual ~ReferenceIndex();
+
+  ReferenceIndex(const ReferenceIndex&) = delete;
+  ReferenceIndex& operator=(const ReferenceIndex&) = delete;
+
+  /// the index of workspace, created if no one holds one yet
+  static std::shared_ptr<ReferenceIndex> get(const openstudio::Workspace& workspace);
+
+  openstudio::Workspace workspace() const;
+
+  /// names of the objects in the reference list, sorted case insensitively
+  const std::vector<std::string>& names(const std::string& reference);
+
+  /// number of objects pointing to object, same as object.numSources()
+  unsigned numSources(const openstudio::WorkspaceObject& object);
+
+ private:
+  void onAddWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                            const openstudio::UUID& uuid);
+
+  void onRemoveWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& type,
+                               const openstudio::UUID& uuid);
+
+  void onRelationshipChange(int index, openstudio::Handle newHandle, openstudio::Handle oldHandle);
+
+  void connectObject(const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& impl);
+
+  // the name change signal does not say which object was renamed, objects are connected through the observer of their
+  // type, which knows the reference lists they are in
+  struct NameObserver;
+
+  openstudio::Workspace m_workspace;
+
+  std::map<openstudio::IddObjectType, std::unique_ptr<NameObserver>> m_nameObservers;
+
+  // only the reference lists and objects asked for so far
+  std::map<std::string, std::vector<std::string>> m_names;
+  std::map<openstudio::Handle, unsigned> m_numSources;
+};
+
+#endif  // MODELEDITOR_REFERENCEINDEX_HPP
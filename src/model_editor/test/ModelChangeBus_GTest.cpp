@@ -0,0 +1,133 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ModelEditorFixture.hpp"
+
+#include "../ModelChangeBus.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Space.hpp>
+#include <openstudio/model/Space_Impl.hpp>
+
+#include <QCoreApplication>
+
+using namespace openstudio;
+
+TEST_F(ModelEditorFixture, ModelChangeBus_Coalesce) {
+  model::Model model;
+  std::shared_ptr<ModelChangeBus> bus = ModelChangeBus::get(model);
+  EXPECT_EQ(bus, ModelChangeBus::get(model));
+
+  std::vector<ModelChangeBatch> batches;
+  QObject::connect(bus.get(), &ModelChangeBus::changesReady, [&batches](const ModelChangeBatch& batch) { batches.push_back(batch); });
+
+  std::vector<model::Space> spaces;
+  for (int i = 0; i < 1000; ++i) {
+    spaces.push_back(model::Space(model));
+  }
+
+  // Nothing is delivered until the event loop runs
+  EXPECT_TRUE(batches.empty());
+  EXPECT_EQ(1000u, bus->queueDepth());
+
+  QCoreApplication::processEvents();
+
+  // The objects added are not listed as changed too
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(0u, bus->queueDepth());
+  EXPECT_TRUE(batches[0].contains(IddObjectType::OS_Space));
+  EXPECT_EQ(1000u, batches[0].added[IddObjectType::OS_Space].size());
+  EXPECT_TRUE(batches[0].removed.empty());
+  EXPECT_TRUE(batches[0].changed.empty());
+  batches.clear();
+
+  // Removals and changes land in the same next batch, each changed object once
+  spaces[0].remove();
+  spaces[1].remove();
+  spaces[2].setName("Changed");
+  spaces[2].setName("Changed again");
+
+  QCoreApplication::processEvents();
+
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_TRUE(batches[0].added.empty());
+  EXPECT_EQ(2u, batches[0].removed[IddObjectType::OS_Space].size());
+  ASSERT_EQ(1u, batches[0].changed[IddObjectType::OS_Space].size());
+  EXPECT_EQ(spaces[2].handle(), batches[0].changed[IddObjectType::OS_Space][0]->handle());
+  EXPECT_EQ(3u, batches[0].size());
+  EXPECT_EQ(std::set<IddObjectType>{IddObjectType::OS_Space}, batches[0].types());
+  batches.clear();
+
+  // Nothing recorded, nothing delivered
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(batches.empty());
+
+  EXPECT_EQ(2u, bus->metrics().batches);
+  EXPECT_EQ(1000u, bus->metrics().maxQueueDepth);
+  EXPECT_LE(bus->metrics().lastLatency, bus->metrics().maxLatency);
+}
+
+TEST_F(ModelEditorFixture, ModelChangeBus_PendingObjects) {
+  model::Model model;
+  std::shared_ptr<ModelChangeBus> bus = ModelChangeBus::get(model);
+
+  std::vector<ModelChangeBatch> batches;
+  QObject::connect(bus.get(), &ModelChangeBus::changesReady, [&batches](const ModelChangeBatch& batch) { batches.push_back(batch); });
+
+  // Added and removed in the same turn, the subscribers don't hear of it
+  std::weak_ptr<openstudio::detail::WorkspaceObject_Impl> removedImpl;
+  {
+    model::Space space(model);
+    removedImpl = space.getImpl<openstudio::detail::WorkspaceObject_Impl>();
+    space.remove();
+  }
+
+  // The bus does not keep pending objects alive
+  EXPECT_TRUE(removedImpl.expired());
+
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(batches.empty());
+
+  // A changed object removed in the same turn is only listed as removed
+  model::Space space(model);
+  QCoreApplication::processEvents();
+  batches.clear();
+
+  Handle handle = space.handle();
+  space.setName("Changed");
+  space.remove();
+
+  QCoreApplication::processEvents();
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_TRUE(batches[0].changed.empty());
+  ASSERT_EQ(1u, batches[0].removed[IddObjectType::OS_Space].size());
+  EXPECT_EQ(handle, batches[0].removed[IddObjectType::OS_Space][0]);
+}
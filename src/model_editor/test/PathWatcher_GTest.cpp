@@ -50,8 +50,8 @@ using std::ios_base;
 struct TestPathWatcher : public PathWatcher
 {
 
-  // set periodic timer to 1 ms
-  TestPathWatcher(const openstudio::path& path) : PathWatcher(path, 1), added(false), changed(false), removed(false) {}
+  // set periodic timer to 1 ms, 0 only relies on file system events
+  TestPathWatcher(const openstudio::path& path, int msec = 1) : PathWatcher(path, msec), added(false), changed(false), removed(false) {}
 
   virtual void onPathAdded() override {
     added = true;
@@ -171,3 +171,34 @@ TEST_F(ModelEditorFixture, PathWatcher_Dir) {
 
   EXPECT_TRUE(watcher.changed);
 }
+
+TEST_F(ModelEditorFixture, PathWatcher_FileEvents) {
+  Application::instance().application(false);
+
+  openstudio::path path = toPath("./PathWatcher_FileEvents");
+  auto w1 = std::thread(write_file, path, "test 1");
+  w1.join();
+
+  TestPathWatcher watcher(path, 0);
+
+  // a larger file, changes are not polled for
+  auto w2 = std::thread(write_file, path, "test 2 and more");
+  w2.join();
+
+  for (int i = 0; i < 100 && !watcher.changed; ++i) {
+    Application::instance().processEvents(10);
+  }
+
+  EXPECT_FALSE(watcher.added);
+  EXPECT_TRUE(watcher.changed);
+  EXPECT_FALSE(watcher.removed);
+
+  auto r1 = std::thread(remove_file, path);
+  r1.join();
+
+  for (int i = 0; i < 100 && !watcher.removed; ++i) {
+    Application::instance().processEvents(10);
+  }
+
+  EXPECT_TRUE(watcher.removed);
+}
@@ -0,0 +1,109 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ModelEditorFixture.hpp"
+
+#include "../ReferenceIndex.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Lights.hpp>
+#include <openstudio/model/Lights_Impl.hpp>
+#include <openstudio/model/LightsDefinition.hpp>
+#include <openstudio/model/LightsDefinition_Impl.hpp>
+
+#include <openstudio/utilities/idd/IddObject.hpp>
+
+using namespace openstudio::model;
+using namespace openstudio;
+
+TEST_F(ModelEditorFixture, ReferenceIndex_Names) {
+  Model model;
+  LightsDefinition definition1(model);
+  definition1.setName("b definition");
+  LightsDefinition definition2(model);
+  definition2.setName("A definition");
+
+  ASSERT_FALSE(definition1.iddObject().references().empty());
+  std::string reference = definition1.iddObject().references()[0];
+
+  std::shared_ptr<ReferenceIndex> index = ReferenceIndex::get(model);
+  EXPECT_EQ(index, ReferenceIndex::get(model));
+
+  std::vector<std::string> names = index->names(reference);
+  ASSERT_EQ(2u, names.size());
+  EXPECT_EQ("A definition", names[0]);
+  EXPECT_EQ("b definition", names[1]);
+
+  definition2.setName("c definition");
+  names = index->names(reference);
+  ASSERT_EQ(2u, names.size());
+  EXPECT_EQ("b definition", names[0]);
+  EXPECT_EQ("c definition", names[1]);
+
+  LightsDefinition definition3(model);
+  definition3.setName("a definition");
+  EXPECT_EQ(3u, index->names(reference).size());
+
+  definition1.remove();
+  names = index->names(reference);
+  ASSERT_EQ(2u, names.size());
+  EXPECT_EQ("a definition", names[0]);
+}
+
+TEST_F(ModelEditorFixture, ReferenceIndex_NumSources) {
+  Model model;
+  LightsDefinition definition1(model);
+  LightsDefinition definition2(model);
+
+  std::shared_ptr<ReferenceIndex> index = ReferenceIndex::get(model);
+  EXPECT_EQ(0u, index->numSources(definition1));
+
+  Lights lights(definition1);
+  EXPECT_EQ(definition1.numSources(), index->numSources(definition1));
+  EXPECT_EQ(1u, index->numSources(definition1));
+
+  EXPECT_TRUE(lights.setLightsDefinition(definition2));
+  EXPECT_EQ(0u, index->numSources(definition1));
+  EXPECT_EQ(1u, index->numSources(definition2));
+
+  Lights lights2(definition2);
+  EXPECT_EQ(2u, index->numSources(definition2));
+
+  // only the counts of the objects the removed one pointed to change
+  definition1.remove();
+  EXPECT_EQ(2u, index->numSources(definition2));
+
+  lights.remove();
+  EXPECT_EQ(1u, index->numSources(definition2));
+
+  lights2.remove();
+  EXPECT_EQ(0u, index->numSources(definition2));
+}
@@ -33,6 +33,8 @@
 #include "StartupView.hpp"
 #include "LibraryDialog.hpp"
 #include "ExternalToolsDialog.hpp"
+#include "../openstudio_lib/ComponentLibrary.hpp"
+#include "../openstudio_lib/ComponentLibraryCache.hpp"
 #include "../openstudio_lib/MainWindow.hpp"
 #include "../openstudio_lib/OSDocument.hpp"
 
@@ -220,7 +222,7 @@ OpenStudioApp::OpenStudioApp(int& argc, char** argv)
 
   auto buildCompLibrariesFuture = QtConcurrent::run(this, &OpenStudioApp::buildCompLibraries);
   m_buildCompLibWatcher.setFuture(buildCompLibrariesFuture);
-  connect(&m_buildCompLibWatcher, &QFutureWatcher<std::vector<std::string>>::finished, this, &OpenStudioApp::onMeasureManagerAndLibraryReady);
+  connect(&m_buildCompLibWatcher, &QFutureWatcher<CompLibraries>::finished, this, &OpenStudioApp::onMeasureManagerAndLibraryReady);
 }
 
 OpenStudioApp::~OpenStudioApp() {
@@ -257,7 +259,7 @@ void OpenStudioApp::onMeasureManagerAndLibraryReady() {
                                                                                       << " at: " << toString(measureManager().url().toString()));
     }
 
-    auto failed = m_buildCompLibWatcher.result();
+    auto failed = publishCompLibraries(m_buildCompLibWatcher.result());
     showFailedLibraryDialog(failed);
 
     bool openedCommandLine = false;
@@ -368,8 +370,10 @@ bool OpenStudioApp::openFile(const QString& fileName, bool restoreTabs) {
   return false;
 }
 
-std::vector<std::string> OpenStudioApp::buildCompLibraries() {
-  std::vector<std::string> failed;
+OpenStudioApp::CompLibraries OpenStudioApp::buildCompLibraries() {
+  // Runs on a worker thread: only build locals here, m_compLibrary and m_lazyCompLibrary are set by publishCompLibraries
+  CompLibraries result;
+  std::vector<std::string>& failed = result.failed;
 
   // This is unused
   //QWidget * parent = nullptr;
@@ -387,43 +391,67 @@ std::vector<std::string> OpenStudioApp::buildCompLibraries() {
   //waitDialog()->m_thirdLine->setVisible(true);
   //waitDialog()->m_fourthLine->setVisible(true);
 
-  m_compLibrary = model::Model();
+  model::Model compLibrary;
+  std::shared_ptr<ComponentLibrary> lazyCompLibrary = ComponentLibrary::create(compLibrary);
+  // Its loadFailed signal is connected to this app, which lives on the GUI thread
+  lazyCompLibrary->moveToThread(this->thread());
 
-  std::string thisVersion = openStudioVersion();
+  std::vector<openstudio::path> paths = libraryPaths();
 
-  for (auto path : libraryPaths()) {
-    try {
-      if (exists(path)) {
-        boost::optional<VersionString> version = openstudio::IdfFile::loadVersionOnly(path);
-        if (version) {
-          waitDialog()->m_thirdLine->setText(QString::fromStdString("Translation From version " + version->str() + " to " + thisVersion + ": "));
-        } else {
-          waitDialog()->m_thirdLine->setText("Unknown starting version");
-        }
-
-        waitDialog()->m_fourthLine->setText(toQString(path));
+  waitDialog()->m_thirdLine->setText(QString("Loading %1 libraries").arg(paths.size()));
+  waitDialog()->m_fourthLine->setText(QString());
 
-        osversion::VersionTranslator versionTranslator;
-        versionTranslator.setAllowNewerVersions(false);
-        boost::optional<Model> temp = versionTranslator.loadModel(path);
-        if (temp) {
-          m_compLibrary.insertObjects(temp->objects());
-        } else {
-          LOG_FREE(Error, "OpenStudioApp", "Failed to load library");
-          failed.push_back(path.string());
-        }
+  // Libraries with an up to date translated copy in the cache are only loaded when one of their object types is first listed,
+  // or one of their objects is dropped.
+  // The others are translated now, in parallel, and cached for the next session.
+  ComponentLibraryCache cache(ComponentLibraryCache::defaultCacheDir());
+  std::vector<openstudio::path> pathsToLoad;
+  for (const auto& path : paths) {
+    if (!exists(path)) {
+      failed.push_back(path.string());
+    } else {
+      boost::optional<std::set<IddObjectType>> types = cache.types(path);
+      boost::optional<std::set<Handle>> handles = cache.handles(path);
+      if (types && handles) {
+        lazyCompLibrary->addPendingLibrary(path.string(), *types, [cache, path]() { return cache.find(path); }, *handles);
       } else {
-        failed.push_back(path.string());
+        pathsToLoad.push_back(path);
       }
-    } catch (...) {
-      failed.push_back(path.string());
+    }
+  }
+
+  // Merged in the order of the paths, so that the result does not depend on which library was loaded first
+  std::vector<boost::optional<Model>> loaded = cache.loadLibraries(pathsToLoad);
+  for (size_t i = 0; i < pathsToLoad.size(); ++i) {
+    if (loaded[i]) {
+      compLibrary.insertObjects(loaded[i]->objects());
+    } else {
+      LOG_FREE(Error, "OpenStudioApp", "Failed to load library " << pathsToLoad[i]);
+      failed.push_back(pathsToLoad[i].string());
     }
   }
 
   // Reset all labels
   waitDialog()->resetLabels();
 
-  return failed;
+  result.model = compLibrary;
+  result.lazyLibrary = lazyCompLibrary;
+  return result;
+}
+
+std::vector<std::string> OpenStudioApp::publishCompLibraries(const CompLibraries& libraries) {
+  if (m_lazyCompLibrary) {
+    m_lazyCompLibrary->disconnect(this);
+  }
+
+  m_compLibrary = libraries.model;
+  m_lazyCompLibrary = libraries.lazyLibrary;
+
+  // Libraries loaded on demand report their failures like the ones loaded at startup. Queued, the load is requested while
+  // a view is being built and the dialog may open the library settings.
+  connect(m_lazyCompLibrary.get(), &ComponentLibrary::loadFailed, this, &OpenStudioApp::showFailedLibraryDialog, Qt::QueuedConnection);
+
+  return libraries.failed;
 }
 
 OpenStudioApp* OpenStudioApp::instance() {
@@ -1376,7 +1404,7 @@ void OpenStudioApp::loadLibrary() {
 
         auto future = QtConcurrent::run(this, &OpenStudioApp::buildCompLibraries);
         m_changeLibrariesWatcher.setFuture(future);
-        connect(&m_changeLibrariesWatcher, &QFutureWatcher<std::vector<std::string>>::finished, this, &OpenStudioApp::onChangeDefaultLibrariesDone);
+        connect(&m_changeLibrariesWatcher, &QFutureWatcher<CompLibraries>::finished, this, &OpenStudioApp::onChangeDefaultLibrariesDone);
       }
     }
   }
@@ -1400,7 +1428,7 @@ void OpenStudioApp::changeDefaultLibraries() {
     // Trigger actual loading of the libraries
     auto future = QtConcurrent::run(this, &OpenStudioApp::buildCompLibraries);
     m_changeLibrariesWatcher.setFuture(future);
-    connect(&m_changeLibrariesWatcher, &QFutureWatcher<std::vector<std::string>>::finished, this, &OpenStudioApp::onChangeDefaultLibrariesDone);
+    connect(&m_changeLibrariesWatcher, &QFutureWatcher<CompLibraries>::finished, this, &OpenStudioApp::onChangeDefaultLibrariesDone);
   }
 }
 
@@ -1438,7 +1466,7 @@ void OpenStudioApp::showFailedLibraryDialog(const std::vector<std::string>& fail
 }
 
 void OpenStudioApp::onChangeDefaultLibrariesDone() {
-  auto failed = m_changeLibrariesWatcher.result();
+  auto failed = publishCompLibraries(m_changeLibrariesWatcher.result());
 
   showFailedLibraryDialog(failed);
 
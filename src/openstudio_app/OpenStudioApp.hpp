@@ -82,6 +82,8 @@ class StartupView;
 
 class OSDocument;
 
+class ComponentLibrary;
+
 class StartupMenu;
 
 class TouchEater : public QObject
@@ -175,8 +177,19 @@ class OpenStudioApp : public OSAppBase
    */
   std::vector<openstudio::path> libraryPaths() const;
 
-  // Build the component libraries and return a vector of paths that failed to load
-  std::vector<std::string> buildCompLibraries();
+  // Component libraries built on a worker thread, they are only published to the app on the GUI thread
+  struct CompLibraries
+  {
+    openstudio::model::Model model;
+    std::shared_ptr<ComponentLibrary> lazyLibrary;
+    std::vector<std::string> failed;
+  };
+
+  // Build the component libraries, along with a vector of paths that failed to load
+  CompLibraries buildCompLibraries();
+
+  // Make the built libraries current, returns the paths that failed to load
+  std::vector<std::string> publishCompLibraries(const CompLibraries& libraries);
 
   void newFromEmptyTemplateSlot();
 
@@ -243,6 +256,9 @@ class OpenStudioApp : public OSAppBase
 
   openstudio::model::Model m_compLibrary;
 
+  // Loads the libraries merged into m_compLibrary on demand
+  std::shared_ptr<ComponentLibrary> m_lazyCompLibrary;
+
   openstudio::model::Model m_hvacCompLibrary;
 
   openstudio::model::Model m_library;
@@ -258,9 +274,9 @@ class OpenStudioApp : public OSAppBase
 
   std::shared_ptr<StartupMenu> m_startupMenu;
 
-  QFutureWatcher<std::vector<std::string>> m_buildCompLibWatcher;
+  QFutureWatcher<CompLibraries> m_buildCompLibWatcher;
   QFutureWatcher<bool> m_waitForMeasureManagerWatcher;
-  QFutureWatcher<std::vector<std::string>> m_changeLibrariesWatcher;
+  QFutureWatcher<CompLibraries> m_changeLibrariesWatcher;
 };
 
 }  // namespace openstudio
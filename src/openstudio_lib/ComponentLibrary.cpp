@@ -0,0 +1,165 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "ComponentLibrary.hpp"
+
+#include <openstudio/model/Model_Impl.hpp>
+#include <openstudio/model/ModelObject_Impl.hpp>
+
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace openstudio {
+
+// Libraries are built on a QtConcurrent thread at startup
+static QMutex registryMutex;
+
+ComponentLibrary::ComponentLibrary(const model::Model& model) : m_model(model) {}
+
+std::shared_ptr<ComponentLibrary> ComponentLibrary::create(const model::Model& model) {
+  std::shared_ptr<ComponentLibrary> result(new ComponentLibrary(model));
+  QMutexLocker locker(&registryMutex);
+  registry()[result->key()] = result;
+  return result;
+}
+
+ComponentLibrary::~ComponentLibrary() {
+  QMutexLocker locker(&registryMutex);
+  auto it = registry().find(key());
+  if (it != registry().end() && it->second.expired()) {
+    registry().erase(it);
+  }
+}
+
+model::Model ComponentLibrary::model() const {
+  return m_model;
+}
+
+void ComponentLibrary::addPendingLibrary(const std::string& name, const std::set<IddObjectType>& types, const Loader& loader,
+                                         const std::set<Handle>& handles) {
+  QMutexLocker locker(&m_mutex);
+  m_pendingLibraries.push_back(PendingLibrary{name, types, loader, handles});
+}
+
+unsigned ComponentLibrary::pendingLibraryCount() const {
+  QMutexLocker locker(&m_mutex);
+  return m_pendingLibraries.size();
+}
+
+std::vector<std::string> ComponentLibrary::load(const IddObjectType& type) {
+  return loadIf([&type](const PendingLibrary& library) { return library.types.count(type) > 0; });
+}
+
+std::vector<std::string> ComponentLibrary::loadObject(const Handle& handle) {
+  return loadIf([&handle](const PendingLibrary& library) { return library.handles.count(handle) > 0; });
+}
+
+std::vector<std::string> ComponentLibrary::loadAll() {
+  return loadIf([](const PendingLibrary&) { return true; });
+}
+
+std::vector<std::string> ComponentLibrary::load(const model::Model& model, const IddObjectType& type) {
+  std::vector<std::string> failed;
+  if (std::shared_ptr<ComponentLibrary> library = find(model)) {
+    failed = library->load(type);
+    if (!failed.empty()) {
+      emit library->loadFailed(failed);
+    }
+  }
+  return failed;
+}
+
+boost::optional<model::ModelObject> ComponentLibrary::getModelObject(const model::Model& model, const Handle& handle) {
+  boost::optional<model::ModelObject> result = model.getModelObject<model::ModelObject>(handle);
+  if (result) {
+    return result;
+  }
+
+  if (std::shared_ptr<ComponentLibrary> library = find(model)) {
+    std::vector<std::string> failed = library->loadObject(handle);
+    if (!failed.empty()) {
+      emit library->loadFailed(failed);
+    }
+    result = model.getModelObject<model::ModelObject>(handle);
+  }
+  return result;
+}
+
+std::shared_ptr<ComponentLibrary> ComponentLibrary::find(const model::Model& model) {
+  QMutexLocker locker(&registryMutex);
+  auto it = registry().find(model.getImpl<model::detail::Model_Impl>().get());
+  if (it != registry().end()) {
+    return it->second.lock();
+  }
+  return nullptr;
+}
+
+template <typename Predicate>
+std::vector<std::string> ComponentLibrary::loadIf(Predicate predicate) {
+  QMutexLocker locker(&m_mutex);
+
+  std::vector<std::string> failed;
+
+  // Merged in registration order, like a library that is built eagerly
+  std::vector<PendingLibrary> stillPending;
+  for (auto& library : m_pendingLibraries) {
+    if (!predicate(library)) {
+      stillPending.push_back(library);
+      continue;
+    }
+
+    boost::optional<model::Model> temp;
+    try {
+      temp = library.loader();
+    } catch (const std::exception& e) {
+      LOG(Error, "Failed to load library '" << library.name << "': " << e.what());
+    }
+
+    if (temp) {
+      m_model.insertObjects(temp->objects());
+    } else {
+      LOG(Error, "Failed to load library '" << library.name << "'");
+      failed.push_back(library.name);
+    }
+  }
+  m_pendingLibraries = std::move(stillPending);
+
+  return failed;
+}
+
+std::map<const void*, std::weak_ptr<ComponentLibrary>>& ComponentLibrary::registry() {
+  static std::map<const void*, std::weak_ptr<ComponentLibrary>> result;
+  return result;
+}
+
+const void* ComponentLibrary::key() const {
+  return m_model.getImpl<model::detail::Model_Impl>().get();
+}
+
+}  // namespace openstudio
@@ -0,0 +1,146 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_COMPONENTLIBRARY_HPP
+#define OPENSTUDIO_COMPONENTLIBRARY_HPP
+
+#include "OpenStudioAPI.hpp"
+
+#include "../model_editor/QMetaTypes.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/ModelObject.hpp>
+#include <openstudio/utilities/core/Logger.hpp>
+#include <openstudio/utilities/idd/IddEnums.hxx>
+
+#include <boost/optional.hpp>
+
+#include <QMutex>
+#include <QObject>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+/***
+* ComponentLibrary lets the merged component library Model be populated on demand.
+*
+* Each library file is registered with the object types and handles it contains and a function loading it. A library is
+* only loaded and merged into model() when one of its types is first requested, which ModelObjectTypeListView does when it
+* lists a type of the component library, or one of its objects is looked up by handle with getModelObject, which is how
+* dropped library items are found. Libraries are merged whole, so the objects they reference come along.
+*
+* The library model is shared by value with OSDocument and the views, ComponentLibrary keeps a registry keyed by the model
+* so that code holding only the model can request a type. The registry only holds weak references, a load in progress keeps
+* the library alive even if it is replaced meanwhile.
+**/
+class OPENSTUDIO_API ComponentLibrary : public QObject
+{
+  Q_OBJECT;
+
+ public:
+  using Loader = std::function<boost::optional<model::Model>()>;
+
+  // Create a library for this model and register it
+  static std::shared_ptr<ComponentLibrary> create(const model::Model& model);
+
+  virtual ~ComponentLibrary();
+
+  ComponentLibrary(const ComponentLibrary&) = delete;
+  ComponentLibrary& operator=(const ComponentLibrary&) = delete;
+
+  // The merged model, only contains the libraries loaded so far
+  model::Model model() const;
+
+  // Register a library that is not loaded yet, it is merged into model() the first time one of its types or objects is requested
+  void addPendingLibrary(const std::string& name, const std::set<IddObjectType>& types, const Loader& loader,
+                         const std::set<Handle>& handles = std::set<Handle>());
+
+  // Number of libraries registered and not loaded yet
+  unsigned pendingLibraryCount() const;
+
+  // Load and merge the pending libraries containing this type, returns the names of the libraries that failed to load
+  std::vector<std::string> load(const IddObjectType& type);
+
+  // Load and merge the pending library containing this object, returns the names of the libraries that failed to load
+  std::vector<std::string> loadObject(const Handle& handle);
+
+  std::vector<std::string> loadAll();
+
+  // Load the pending libraries containing this type if model is a ComponentLibrary's model, does nothing otherwise.
+  // Returns the names of the libraries that failed to load.
+  static std::vector<std::string> load(const model::Model& model, const IddObjectType& type);
+
+  // The object of model with this handle, loading the pending library containing it first if model is a ComponentLibrary's model
+  static boost::optional<model::ModelObject> getModelObject(const model::Model& model, const Handle& handle);
+
+ signals:
+
+  // Emitted when libraries loaded on demand fail to load
+  void loadFailed(const std::vector<std::string>& failed);
+
+ private:
+  REGISTER_LOGGER("openstudio.ComponentLibrary");
+
+  explicit ComponentLibrary(const model::Model& model);
+
+  struct PendingLibrary
+  {
+    std::string name;
+    std::set<IddObjectType> types;
+    Loader loader;
+    std::set<Handle> handles;
+  };
+
+  template <typename Predicate>
+  std::vector<std::string> loadIf(Predicate predicate);
+
+  static std::map<const void*, std::weak_ptr<ComponentLibrary>>& registry();
+
+  // A strong reference to the library of this model, if any. It holds the library while loading, it may be replaced by
+  // another thread meanwhile
+  static std::shared_ptr<ComponentLibrary> find(const model::Model& model);
+
+  const void* key() const;
+
+  model::Model m_model;
+  std::vector<PendingLibrary> m_pendingLibraries;
+
+  // Guards m_pendingLibraries and the merge into m_model
+  mutable QMutex m_mutex;
+};
+
+}  // namespace openstudio
+
+#endif  // OPENSTUDIO_COMPONENTLIBRARY_HPP
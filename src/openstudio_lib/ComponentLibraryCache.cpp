@@ -0,0 +1,222 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "ComponentLibraryCache.hpp"
+
+#include "../model_editor/Utilities.hpp"
+
+#include <openstudio/osversion/VersionTranslator.hpp>
+#include <openstudio/utilities/idd/IddObject.hpp>
+#include <openstudio/OpenStudio.hxx>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QtConcurrent>
+
+namespace openstudio {
+
+ComponentLibraryCache::ComponentLibraryCache(const openstudio::path& cacheDir) : m_cacheDir(cacheDir) {}
+
+openstudio::path ComponentLibraryCache::defaultCacheDir() {
+  return toPath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)) / toPath("component_libraries");
+}
+
+openstudio::path ComponentLibraryCache::cacheDir() const {
+  return m_cacheDir;
+}
+
+boost::optional<model::Model> ComponentLibraryCache::loadLibrary(const openstudio::path& libraryPath) const {
+  if (boost::optional<model::Model> cached = find(libraryPath)) {
+    return cached;
+  }
+
+  osversion::VersionTranslator versionTranslator;
+  versionTranslator.setAllowNewerVersions(false);
+  boost::optional<model::Model> result = versionTranslator.loadModel(libraryPath);
+  if (result) {
+    store(libraryPath, *result);
+  }
+
+  return result;
+}
+
+std::vector<boost::optional<model::Model>> ComponentLibraryCache::loadLibraries(const std::vector<openstudio::path>& libraryPaths) const {
+  // Each load has its own VersionTranslator and each library its own cache files, nothing is shared between the threads
+  std::vector<QFuture<boost::optional<model::Model>>> futures;
+  for (const auto& libraryPath : libraryPaths) {
+    futures.push_back(QtConcurrent::run([this, libraryPath]() -> boost::optional<model::Model> {
+      try {
+        return loadLibrary(libraryPath);
+      } catch (...) {
+      }
+      return boost::none;
+    }));
+  }
+
+  std::vector<boost::optional<model::Model>> result;
+  for (auto& future : futures) {
+    result.push_back(future.result());
+  }
+  return result;
+}
+
+boost::optional<model::Model> ComponentLibraryCache::find(const openstudio::path& libraryPath) const {
+  const QString base = toQString(cachePath(libraryPath));
+  const QString osmPath = base + ".osm";
+  const QString iniPath = base + ".ini";
+  if (!QFileInfo::exists(osmPath) || !QFileInfo::exists(iniPath)) {
+    return boost::none;
+  }
+
+  if (!isUpToDate(iniPath, libraryPath)) {
+    return boost::none;
+  }
+
+  // Already at the current version, no translation needed
+  boost::optional<model::Model> result = model::Model::load(toPath(osmPath));
+  if (!result) {
+    LOG(Warn, "Cached copy of library '" << toString(libraryPath) << "' could not be loaded");
+  }
+  return result;
+}
+
+void ComponentLibraryCache::store(const openstudio::path& libraryPath, const model::Model& model) const {
+  if (!QDir().mkpath(toQString(m_cacheDir))) {
+    LOG(Warn, "Cannot create component library cache directory '" << toString(m_cacheDir) << "'");
+    return;
+  }
+
+  const QString base = toQString(cachePath(libraryPath));
+  const QString iniPath = base + ".ini";
+
+  // Invalidate first, so an interrupted store never leaves a stale .ini next to a new .osm
+  QFile::remove(iniPath);
+
+  if (!model.save(toPath(base + ".osm"), true)) {
+    LOG(Warn, "Cannot cache library '" << toString(libraryPath) << "'");
+    return;
+  }
+
+  // One handle per line, there can be thousands of them
+  QFile handlesFile(base + ".handles");
+  if (!handlesFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+    LOG(Warn, "Cannot cache the handles of library '" << toString(libraryPath) << "'");
+    return;
+  }
+  for (const auto& object : model.objects()) {
+    handlesFile.write(toQString(object.handle()).toUtf8() + "\n");
+  }
+  handlesFile.close();
+
+  QFileInfo libraryInfo(toQString(libraryPath));
+  QSettings settings(iniPath, QSettings::IniFormat);
+  settings.setValue("source", libraryInfo.absoluteFilePath());
+  settings.setValue("size", libraryInfo.size());
+  settings.setValue("last_modified", libraryInfo.lastModified().toMSecsSinceEpoch());
+  settings.setValue("openstudio_version", toQString(openStudioVersion()));
+
+  std::set<IddObjectType> types;
+  for (const auto& object : model.objects()) {
+    types.insert(object.iddObject().type());
+  }
+  QStringList typeNames;
+  for (const auto& type : types) {
+    typeNames << toQString(type.valueName());
+  }
+  settings.setValue("types", typeNames);
+
+  settings.sync();
+}
+
+boost::optional<std::set<IddObjectType>> ComponentLibraryCache::types(const openstudio::path& libraryPath) const {
+  const QString base = toQString(cachePath(libraryPath));
+  const QString iniPath = base + ".ini";
+  if (!QFileInfo::exists(base + ".osm") || !QFileInfo::exists(iniPath) || !isUpToDate(iniPath, libraryPath)) {
+    return boost::none;
+  }
+
+  QSettings settings(iniPath, QSettings::IniFormat);
+  if (!settings.contains("types")) {
+    return boost::none;
+  }
+
+  std::set<IddObjectType> result;
+  for (const QString& typeName : settings.value("types").toStringList()) {
+    try {
+      result.insert(IddObjectType(toString(typeName)));
+    } catch (const std::exception&) {
+      // Not a type of this version, the copy would not be up to date
+      return boost::none;
+    }
+  }
+  return result;
+}
+
+boost::optional<std::set<Handle>> ComponentLibraryCache::handles(const openstudio::path& libraryPath) const {
+  const QString base = toQString(cachePath(libraryPath));
+  const QString iniPath = base + ".ini";
+  if (!QFileInfo::exists(base + ".osm") || !QFileInfo::exists(iniPath) || !isUpToDate(iniPath, libraryPath)) {
+    return boost::none;
+  }
+
+  QFile handlesFile(base + ".handles");
+  if (!handlesFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    return boost::none;
+  }
+
+  std::set<Handle> result;
+  while (!handlesFile.atEnd()) {
+    QString line = QString::fromUtf8(handlesFile.readLine()).trimmed();
+    if (!line.isEmpty()) {
+      result.insert(toUUID(line));
+    }
+  }
+  return result;
+}
+
+bool ComponentLibraryCache::isUpToDate(const QString& iniPath, const openstudio::path& libraryPath) {
+  QFileInfo libraryInfo(toQString(libraryPath));
+  QSettings settings(iniPath, QSettings::IniFormat);
+  return (settings.value("source").toString() == libraryInfo.absoluteFilePath()) && (settings.value("size").toLongLong() == libraryInfo.size())
+         && (settings.value("last_modified").toLongLong() == libraryInfo.lastModified().toMSecsSinceEpoch())
+         && (settings.value("openstudio_version").toString() == toQString(openStudioVersion()));
+}
+
+openstudio::path ComponentLibraryCache::cachePath(const openstudio::path& libraryPath) const {
+  QByteArray name = QCryptographicHash::hash(QFileInfo(toQString(libraryPath)).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+  return m_cacheDir / toPath(QString(name));
+}
+
+}  // namespace openstudio
@@ -0,0 +1,100 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_COMPONENTLIBRARYCACHE_HPP
+#define OPENSTUDIO_COMPONENTLIBRARYCACHE_HPP
+
+#include "OpenStudioAPI.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/utilities/core/Logger.hpp>
+#include <openstudio/utilities/core/Path.hpp>
+#include <openstudio/utilities/idd/IddEnums.hxx>
+
+#include <boost/optional.hpp>
+
+#include <QString>
+
+#include <set>
+#include <vector>
+
+namespace openstudio {
+
+/***
+* ComponentLibraryCache keeps a version translated copy of each component library, so that an unchanged library can be
+* loaded at startup without running the VersionTranslator again.
+*
+* A cached copy is valid as long as the library file has the same size and modification time, and the OpenStudio version
+* is the one that translated it. The object types and handles of each library are recorded too, so that a library can be
+* registered without being loaded (see ComponentLibrary). Each library has its own files in the cache directory, so libraries can be loaded and
+* stored concurrently from different threads.
+**/
+class OPENSTUDIO_API ComponentLibraryCache
+{
+ public:
+  explicit ComponentLibraryCache(const openstudio::path& cacheDir);
+
+  // component_libraries directory in the user's cache location
+  static openstudio::path defaultCacheDir();
+
+  openstudio::path cacheDir() const;
+
+  // Load the library, from the cache if possible, version translating it (and caching the result) otherwise
+  boost::optional<model::Model> loadLibrary(const openstudio::path& libraryPath) const;
+
+  // Load these libraries like loadLibrary, concurrently. The results are in the order of the paths, boost::none for those
+  // that failed to load
+  std::vector<boost::optional<model::Model>> loadLibraries(const std::vector<openstudio::path>& libraryPaths) const;
+
+  // The cached copy of this library, boost::none if there is none or it is out of date
+  boost::optional<model::Model> find(const openstudio::path& libraryPath) const;
+
+  void store(const openstudio::path& libraryPath, const model::Model& model) const;
+
+  // Object types of the cached copy of this library, read without loading it. boost::none if there is no valid cached copy
+  boost::optional<std::set<IddObjectType>> types(const openstudio::path& libraryPath) const;
+
+  // Handles of the objects of the cached copy of this library, read without loading it. boost::none if there is no valid cached copy
+  boost::optional<std::set<Handle>> handles(const openstudio::path& libraryPath) const;
+
+ private:
+  REGISTER_LOGGER("openstudio.ComponentLibraryCache");
+
+  // Base name of the cached files for this library
+  openstudio::path cachePath(const openstudio::path& libraryPath) const;
+
+  // Whether the cached copy described by this ini file was made from the current version of the library
+  static bool isUpToDate(const QString& iniPath, const openstudio::path& libraryPath);
+
+  openstudio::path m_cacheDir;
+};
+
+}  // namespace openstudio
+
+#endif  // OPENSTUDIO_COMPONENTLIBRARYCACHE_HPP
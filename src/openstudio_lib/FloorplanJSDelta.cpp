@@ -0,0 +1,201 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "FloorplanJSDelta.hpp"
+
+#include <sstream>
+
+namespace openstudio {
+
+static boost::optional<std::string> idString(const Json::Value& id) {
+  if (id.isString()) {
+    return id.asString();
+  } else if (id.isIntegral()) {
+    return std::to_string(id.asLargestInt());
+  }
+  return boost::none;
+}
+
+static bool isCollection(const Json::Value& value) {
+  if (!value.isArray()) {
+    return false;
+  }
+  for (const auto& item : value) {
+    if (!item.isObject() || !idString(item["id"])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FloorplanJSDelta::Entries FloorplanJSDelta::entries(const Json::Value& floorplan) {
+  Entries result;
+  if (!floorplan.isObject()) {
+    return result;
+  }
+
+  for (const auto& name : floorplan.getMemberNames()) {
+    const Json::Value& value = floorplan[name];
+    if (!isCollection(value)) {
+      result[name] = value;
+      continue;
+    }
+
+    Json::Value ids(Json::arrayValue);
+    for (const auto& item : value) {
+      ids.append(item["id"]);
+      std::string key = name + "/" + *idString(item["id"]);
+
+      // spaces carry most of a story, keep them apart so editing one space does not resend its story
+      if ((name == "stories") && isCollection(item["spaces"])) {
+        Json::Value spaceIds(Json::arrayValue);
+        for (const auto& space : item["spaces"]) {
+          spaceIds.append(space["id"]);
+          result[key + "/spaces/" + *idString(space["id"])] = space;
+        }
+        result[key + "/@spaces"] = spaceIds;
+
+        Json::Value story = item;
+        story.removeMember("spaces");
+        result[key] = story;
+      } else {
+        result[key] = item;
+      }
+    }
+    result["@" + name] = ids;
+  }
+
+  return result;
+}
+
+Json::Value FloorplanJSDelta::assemble(const Entries& entries) {
+  Json::Value result(Json::objectValue);
+
+  for (const auto& [key, value] : entries) {
+    if (key.empty() || (key.find('/') != std::string::npos)) {
+      continue;
+    }
+    if (key[0] != '@') {
+      result[key] = value;
+      continue;
+    }
+
+    std::string name = key.substr(1);
+    Json::Value items(Json::arrayValue);
+    for (const auto& id : value) {
+      boost::optional<std::string> itemId = idString(id);
+      if (!itemId) {
+        continue;
+      }
+      std::string itemKey = name + "/" + *itemId;
+      auto it = entries.find(itemKey);
+      if (it == entries.end()) {
+        continue;
+      }
+
+      Json::Value item = it->second;
+      auto spaceIds = entries.find(itemKey + "/@spaces");
+      if (spaceIds != entries.end()) {
+        Json::Value spaces(Json::arrayValue);
+        for (const auto& spaceId : spaceIds->second) {
+          boost::optional<std::string> spaceIdString = idString(spaceId);
+          if (!spaceIdString) {
+            continue;
+          }
+          auto space = entries.find(itemKey + "/spaces/" + *spaceIdString);
+          if (space != entries.end()) {
+            spaces.append(space->second);
+          }
+        }
+        item["spaces"] = spaces;
+      }
+      items.append(item);
+    }
+    result[name] = items;
+  }
+
+  return result;
+}
+
+Json::Value FloorplanJSDelta::diff(const Entries& before, const Entries& after) {
+  Json::Value changed(Json::objectValue);
+  Json::Value removed(Json::arrayValue);
+
+  for (const auto& [key, value] : after) {
+    auto it = before.find(key);
+    if ((it == before.end()) || (it->second != value)) {
+      changed[key] = value;
+    }
+  }
+  for (const auto& entry : before) {
+    if (after.find(entry.first) == after.end()) {
+      removed.append(entry.first);
+    }
+  }
+
+  Json::Value result(Json::objectValue);
+  result["changed"] = changed;
+  result["removed"] = removed;
+  return result;
+}
+
+bool FloorplanJSDelta::isEmpty(const Json::Value& delta) {
+  return delta["changed"].empty() && delta["removed"].empty();
+}
+
+void FloorplanJSDelta::apply(Entries& entries, const Json::Value& delta) {
+  for (const auto& key : delta["removed"]) {
+    entries.erase(key.asString());
+  }
+  const Json::Value& changed = delta["changed"];
+  for (const auto& key : changed.getMemberNames()) {
+    entries[key] = changed[key];
+  }
+}
+
+boost::optional<Json::Value> FloorplanJSDelta::parse(const std::string& json) {
+  Json::CharReaderBuilder rbuilder;
+  std::istringstream ss(json);
+  std::string errorString;
+  Json::Value value;
+  if (Json::parseFromStream(rbuilder, ss, &value, &errorString)) {
+    return value;
+  }
+  return boost::none;
+}
+
+std::string FloorplanJSDelta::toJSON(const Json::Value& value) {
+  Json::StreamWriterBuilder wbuilder;
+  // mimic the old FastWriter behavior:
+  wbuilder["commentStyle"] = "None";
+  wbuilder["indentation"] = "";
+  return Json::writeString(wbuilder, value);
+}
+
+}  // namespace openstudio
@@ -0,0 +1,85 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_FLOORPLANJSDELTA_HPP
+#define OPENSTUDIO_FLOORPLANJSDELTA_HPP
+
+#include "OpenStudioAPI.hpp"
+
+#include <json/json.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+
+namespace openstudio {
+
+/***
+* FloorplanJSDelta splits a FloorspaceJS document into entries which can be compared and exchanged independently,
+* so that FloorspaceEditor only sends the stories, spaces and assignments which changed to the embedded editor and back.
+*
+* Entries are keyed by path:
+*   "member"                      top level member which is not a collection, e.g. "project"
+*   "@member"                     ordered ids of a collection, e.g. "@thermal_zones"
+*   "member/id"                   item of a collection, e.g. "thermal_zones/12"
+*   "stories/id"                  story without its spaces
+*   "stories/id/@spaces"          ordered ids of the spaces of a story
+*   "stories/id/spaces/id"        space of a story
+*
+* A collection is an array whose elements are all objects with an "id", ids are not expected to contain '/'.
+* The same splitting is done on the editor side by library/floorplan_sync.js, keep both in sync.
+**/
+class OPENSTUDIO_API FloorplanJSDelta
+{
+ public:
+  using Entries = std::map<std::string, Json::Value>;
+
+  static Entries entries(const Json::Value& floorplan);
+
+  // Rebuild the document from its entries, items missing from a collection's ids are skipped
+  static Json::Value assemble(const Entries& entries);
+
+  // Delta taking before to after: {"changed": {key: value}, "removed": [key]}
+  static Json::Value diff(const Entries& before, const Entries& after);
+
+  static bool isEmpty(const Json::Value& delta);
+
+  // Apply a delta produced by diff, on either side of the bridge
+  static void apply(Entries& entries, const Json::Value& delta);
+
+  static boost::optional<Json::Value> parse(const std::string& json);
+
+  // Compact serialization, as FloorplanJS::toJSON(false)
+  static std::string toJSON(const Json::Value& value);
+};
+
+}  // namespace openstudio
+
+#endif  // OPENSTUDIO_FLOORPLANJSDELTA_HPP
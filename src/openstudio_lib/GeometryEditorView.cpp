@@ -94,8 +94,11 @@
 #include <QProcess>
 #include <QSettings>
 #include <QProcessEnvironment>
+#include <QPointer>
+#include <QEventLoop>
 
-const int CHECKFORUPDATEMSEC = 5000;
+// editor changes are batched this long before being reported
+const int CHANGEBATCHMSEC = 1000;
 
 namespace openstudio {
 
@@ -140,8 +143,10 @@ DebugWebView::DebugWebView(const QString& debugPort, QWidget* parent) : QDialog(
 DebugWebView::~DebugWebView() {}
 
 BaseEditor::BaseEditor(bool isIP, const openstudio::model::Model& model, QWebEngineView* view, QWidget* t_parent)
-  : QObject(t_parent), m_editorLoaded(false), m_javascriptRunning(false), m_versionNumber(0), m_isIP(isIP), m_model(model), m_view(view) {
+  : QObject(t_parent), m_editorLoaded(false), m_javascriptRunning(0), m_versionNumber(0), m_isIP(isIP), m_model(model), m_view(view) {
   m_checkForUpdateTimer = new QTimer(this);
+  m_checkForUpdateTimer->setSingleShot(true);
+  m_checkForUpdateTimer->setInterval(CHANGEBATCHMSEC);
   connect(m_checkForUpdateTimer, SIGNAL(timeout()), this, SLOT(checkForUpdate()));
 
   openstudio::OSAppBase* app = OSAppBase::instance();
@@ -157,7 +162,7 @@ bool BaseEditor::editorLoaded() const {
 }
 
 bool BaseEditor::javascriptRunning() const {
-  return m_javascriptRunning;
+  return m_javascriptRunning > 0;
 }
 
 bool BaseEditor::blockUpdateTimerSignals(bool block) {
@@ -177,11 +182,40 @@ void BaseEditor::onChanged() {
   //m_document->markAsModified();
 }
 
+void BaseEditor::doExportBlocking() {
+  bool done = false;
+  doExport([&done]() { done = true; });
+  while (!done) {
+    OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
+  }
+}
+
+void BaseEditor::runJavaScript(const QString& javascript, const std::function<void(const QVariant&)>& callback) {
+  ++m_javascriptRunning;
+
+  // the page outlives editors replaced by EditorWebView::newImportClicked
+  QPointer<BaseEditor> editor(this);
+  m_view->page()->runJavaScript(javascript, [editor, callback](const QVariant& v) {
+    if (!editor) {
+      return;
+    }
+    --editor->m_javascriptRunning;
+    if (callback) {
+      callback(v);
+    }
+  });
+}
+
 FloorspaceEditor::FloorspaceEditor(const openstudio::path& floorplanPath, bool isIP, const openstudio::model::Model& model, QWebEngineView* view,
                                    QWidget* t_parent)
   : BaseEditor(isIP, model, view, t_parent), m_floorplanPath(floorplanPath) {
   m_document->disable();
 
+  // the editor pushes a notification when the floorplan changes, see library/floorplan_sync.js
+  if (auto* page = qobject_cast<OSWebEnginePage*>(m_view->page())) {
+    connect(page, &OSWebEnginePage::scriptNotification, this, &FloorspaceEditor::onScriptNotification);
+  }
+
   boost::optional<model::Building> building = model.getOptionalUniqueModelObject<model::Building>();
   if (building) {
     m_originalBuildingName = building->nameString();
@@ -248,10 +282,6 @@ FloorspaceEditor::~FloorspaceEditor() {}
 void FloorspaceEditor::loadEditor() {
   // set config
   {
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     Json::Value config(Json::objectValue);
     config["showImportExport"] = false;
 
@@ -307,31 +337,17 @@ void FloorspaceEditor::loadEditor() {
     const std::string json = Json::writeString(wbuilder, config);
 
     QString javascript = QString("window.api.setConfig(") + QString::fromStdString(json) + QString(");");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   // start the app
   {
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     QString javascript = QString("window.api.init();");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   // customize css
   {
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     QFile cssFile(":/library/geometry_editor.css");
     bool test = cssFile.open(QFile::ReadOnly | QFile::Text);
     OS_ASSERT(test);
@@ -347,30 +363,20 @@ style.type = 'text/css';\n\
 style.innerHTML = rules;\n\
 document.head.appendChild(style);\n";
 
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   // create library from current model
   {
-    OS_ASSERT(!m_javascriptRunning);
-
     if (m_floorplan) {
 
       // import the current floorplan
-      m_javascriptRunning = true;
-
       // floorplan was updated in ctor
       std::string json = m_floorplan->toJSON(false);
 
       QString javascript =
         QString("window.api.openFloorplan(JSON.stringify(") + QString::fromStdString(json) + QString("), { noReloadGrid: false });");
-      m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-      while (m_javascriptRunning) {
-        OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-      }
+      runJavaScript(javascript);
 
     } else {
 
@@ -392,8 +398,6 @@ document.head.appendChild(style);\n";
         QMessageBox::warning(qobject_cast<QWidget*>(parent()), QString("Updating Floorplan"), errorsAndWarnings);
       }
 
-      m_javascriptRunning = true;
-
       std::string json = floorplan.toJSON(false);
       // TODO: @macumber: delete this now?
       // DLM: temp
@@ -410,54 +414,104 @@ document.head.appendChild(style);\n";
       // const std::string json = Json::writeString(wbuilder, value);
 
       QString javascript = QString("window.api.importLibrary(JSON.stringify(") + QString::fromStdString(json) + QString("));");
-      m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-      while (m_javascriptRunning) {
-        OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-      }
+      runJavaScript(javascript);
     }
   }
 
-  m_editorLoaded = true;
+  // track the floorplan exchanged with the editor, later exports and updates only carry what changed
+  {
+    QFile syncFile(":/library/floorplan_sync.js");
+    bool test = syncFile.open(QFile::ReadOnly | QFile::Text);
+    OS_ASSERT(test);
+    QTextStream syncStream(&syncFile);
+    QString javascript = syncStream.readAll();
+    syncFile.close();
 
-  // start checking for updates
-  m_versionNumber = 0;
-  m_checkForUpdateTimer->start(CHECKFORUPDATEMSEC);
-}
+    javascript += "\nwindow.osFloorplanSync.reset();";
 
-void FloorspaceEditor::doExport() {
-  bool t = true;
+    // the scripts above run first, the editor is loaded once the initial floorplan is known
+    runJavaScript(javascript, [this](const QVariant& v) {
+      m_editorEntries.clear();
+      m_exportStale = false;
+      m_exportOutOfDate = false;
+      applyExportDelta(v);
 
-  if (m_editorLoaded && !m_javascriptRunning) {
-    m_javascriptRunning = true;
-    m_document->disable();
-    QString javascript = QString("JSON.stringify(window.api.exportFloorplan());");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) {
-      m_export = v;
-      m_javascriptRunning = false;
+      m_editorLoaded = true;
+
+      // changes are pushed by the editor from now on
+      m_versionNumber = 0;
+      m_changePending = false;
     });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
+  }
+}
+
+void FloorspaceEditor::doExport(const std::function<void()>& done) {
+  OS_ASSERT(m_editorLoaded);
+
+  auto finish = [this, done]() {
+    updateExport();
+    // DLM: This is an error
+    OS_ASSERT(m_floorplan);
+
+    if (done) {
+      done();
     }
+  };
+
+  // nothing changed in the editor since the last exchange, no need to ask the page for an export
+  if (!m_exportOutOfDate) {
+    finish();
+    return;
+  }
+
+  m_document->disable();
+  refreshExport([this, finish]() {
     m_document->enable();
+    finish();
+  });
+}
 
-    // DLM: what if this fails?
-    std::string contents = m_export.value<QString>().toStdString();
-    m_floorplan = FloorplanJS::load(contents);
+void FloorspaceEditor::refreshExport(const std::function<void()>& done) {
+  m_exportOutOfDate = false;
 
-    if (!m_floorplan) {
-      // DLM: This is an error
-      t = false;
+  // only the entries changed in the editor since the last exchange come back
+  QString javascript = QString("window.osFloorplanSync.exportDelta();");
+  runJavaScript(javascript, [this, done](const QVariant& v) {
+    bool test = applyExportDelta(v);
+    // DLM: This is an error
+    OS_ASSERT(test);
+
+    if (done) {
+      done();
     }
+  });
+}
 
-  } else {
-    // DLM: This is an error
-    t = false;
+bool FloorspaceEditor::applyExportDelta(const QVariant& result) {
+  boost::optional<Json::Value> delta = FloorplanJSDelta::parse(result.toString().toStdString());
+  if (!delta) {
+    return false;
+  }
+  if (!FloorplanJSDelta::isEmpty(*delta)) {
+    FloorplanJSDelta::apply(m_editorEntries, *delta);
+    m_exportStale = true;
   }
+  return true;
+}
 
-  OS_ASSERT(t);
+void FloorspaceEditor::updateExport() {
+  if (m_exportStale || m_export.isNull() || !m_floorplan) {
+    // DLM: what if this fails?
+    std::string contents = FloorplanJSDelta::toJSON(FloorplanJSDelta::assemble(m_editorEntries));
+    m_export = QString::fromStdString(contents);
+    m_floorplan = FloorplanJS::load(contents);
+    m_exportStale = false;
+  }
 }
 
 void FloorspaceEditor::saveExport() {
+  updateExport();
+
   if (!m_export.isNull()) {
 
     std::string contents = m_export.value<QString>().toStdString();
@@ -479,6 +533,8 @@ void FloorspaceEditor::saveExport() {
 }
 
 void FloorspaceEditor::translateExport() {
+  updateExport();
+
   model::ThreeJSReverseTranslator rt;
   boost::optional<model::Model> model;
   if (m_floorplan) {
@@ -554,62 +610,44 @@ void FloorspaceEditor::updateModel(const openstudio::model::Model& model) {
       QMessageBox::warning(qobject_cast<QWidget*>(parent()), "Updating Floorplan", errorsAndWarnings);
     }
 
-    OS_ASSERT(!m_javascriptRunning);
-    m_javascriptRunning = true;
-
-    // import updated floorplan back into editor
+    // only send the editor the entries the update changed, e.g. new handles or renamed spaces
     OS_ASSERT(m_floorplan);
     std::string json = m_floorplan->toJSON(false);
-
-    QString javascript = QString("window.api.openFloorplan(JSON.stringify(") + QString::fromStdString(json) + QString("), { noReloadGrid: true });");
-    //QString javascript = QString("window.api.importLibrary(JSON.stringify(") + QString::fromStdString(json) + QString("));");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
+    boost::optional<Json::Value> floorplan = FloorplanJSDelta::parse(json);
+    OS_ASSERT(floorplan);
+
+    FloorplanJSDelta::Entries entries = FloorplanJSDelta::entries(*floorplan);
+    Json::Value delta = FloorplanJSDelta::diff(m_editorEntries, entries);
+    m_editorEntries = entries;
+    m_export = QString::fromStdString(json);
+    m_exportStale = false;
+    if (FloorplanJSDelta::isEmpty(delta)) {
+      return;
     }
+
+    QString javascript = QString("window.osFloorplanSync.applyDelta(") + QString::fromStdString(FloorplanJSDelta::toJSON(delta)) + QString(");");
+    runJavaScript(javascript);
   }
 }
 
 void FloorspaceEditor::checkForUpdate() {
-  if (!m_javascriptRunning) {
-    m_javascriptRunning = true;
-
-    // DLM: don't disable and enable the tabs, too distracting
-    //m_document->disable();
-
-    unsigned currentVersionNumber = m_versionNumber;
-
-    QString javascript = QString("window.versionNumber;");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) {
-      m_versionNumber = v.toUInt();
-      m_javascriptRunning = false;
-    });
-
-    // DLM: the javascript engine appears to stop when a file dialog is launched by the editor (e.g. to import an image)
-    int processEventsTime = 200;
-    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
-    while (m_javascriptRunning) {
-      // if the javascript is taking too long to evaluate, bail out here
-      // DLM: multiply elapsed time by two, we want to make sure we have half of the time between update checks to process other events
-      int elapsed = 2 * (boost::posix_time::microsec_clock::universal_time() - start).total_milliseconds();
-      if (elapsed > CHECKFORUPDATEMSEC) {
-        break;
-      }
-      // DLM: instead ignore user events
-      // DLM: this is a problem during file dialogs launched by the editor
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, processEventsTime);
-    }
+  // report the pending batch now, e.g. before the view is destroyed
+  m_checkForUpdateTimer->stop();
+  if (m_changePending) {
+    m_changePending = false;
+    onChanged();
+  }
+}
 
-    //m_document->enable();
+void FloorspaceEditor::onScriptNotification(const QString& name, const QString& payload) {
+  if (m_editorLoaded && (name == "floorplanChanged")) {
+    m_versionNumber = payload.toUInt();
+    m_changePending = true;
+    // restart the batch, checkForUpdate runs once the editor has been quiet for a while
+    m_checkForUpdateTimer->start();
 
-    if (m_javascriptRunning) {
-      // DLM: do not set this to false, we will require the javascript to complete
-      //m_javascriptRunning = false;
-    } else {
-      if (currentVersionNumber != m_versionNumber) {
-        onChanged();
-      }
-    }
+    // pulled by the next save, preview or merge
+    m_exportOutOfDate = true;
   }
 }
 
@@ -636,36 +674,28 @@ GbXmlEditor::~GbXmlEditor() {}
 
 void GbXmlEditor::loadEditor() {
   {
-    OS_ASSERT(!m_javascriptRunning);
     // call init and animate
     QString javascript = QString("init();\n animate();");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   if (!m_gbXML.isEmpty()) {
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     QString javascript = QString("setGbXml(\"") + m_gbXML + QString("\");");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   m_editorLoaded = true;
 
   // start checking for updates
   //m_versionNumber = 0;
-  //m_checkForUpdateTimer->start(CHECKFORUPDATEMSEC);
+  //m_checkForUpdateTimer->start();
 }
 
-void GbXmlEditor::doExport() {
+void GbXmlEditor::doExport(const std::function<void()>& done) {
   // no-op since we aren't editing anything
+  if (done) {
+    done();
+  }
 }
 
 void GbXmlEditor::saveExport() {
@@ -711,15 +741,21 @@ void GbXmlEditor::checkForUpdate() {
   // no-op since we aren't editing anything
 }
 
+// epJSON converted from the IDF, next to it
+openstudio::path jdfPathFor(const openstudio::path& idfPath) {
+  QFileInfo fi(toQString(idfPath));
+  QString jdfName = fi.fileName();
+  jdfName.replace(".idf", ".epJSON");
+  return toPath(fi.absolutePath()) / toPath(jdfName);
+}
+
 IdfEditor::IdfEditor(const openstudio::path& idfPath, bool forceConvert, bool isIP, const openstudio::model::Model& model, QWebEngineView* view,
                      QWidget* t_parent)
-  : BaseEditor(isIP, model, view, t_parent), m_idfPath(idfPath) {
+  : BaseEditor(isIP, model, view, t_parent), m_idfPath(idfPath), m_converter(nullptr) {
   m_document->disable();
 
   QFileInfo fi(toQString(m_idfPath));
-  QString jdfName = fi.fileName();
-  jdfName.replace(".idf", ".epJSON");
-  openstudio::path jdfPath = toPath(fi.absolutePath()) / toPath(jdfName);
+  openstudio::path jdfPath = jdfPathFor(m_idfPath);
 
   QString qJdfPath = toQString(jdfPath);
   if (QFile::exists(qJdfPath)) {
@@ -730,62 +766,69 @@ IdfEditor::IdfEditor(const openstudio::path& idfPath, bool forceConvert, bool is
     }
   }
 
-  if (exists(m_idfPath)) {
+  if (exists(m_idfPath) && !exists(jdfPath)) {
 
-    if (!exists(jdfPath)) {
+    m_converterDir = std::make_unique<QTemporaryDir>(QString(QDir::tempPath() + "/XXXXXX"));
+    m_converterDir->setAutoRemove(true);
+    if (m_converterDir->isValid()) {
 
-      QTemporaryDir tempDir(QString(QDir::tempPath() + "/XXXXXX"));
-      tempDir.setAutoRemove(true);
-      if (tempDir.isValid()) {
+      openstudio::path jdfTempPath = toPath(m_converterDir->path()) / jdfPath.filename();
 
-        openstudio::path jdfTempPath = toPath(tempDir.path()) / toPath(jdfName);
+      m_converter = new QProcess(this);
+      m_converter->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
+      m_converter->setWorkingDirectory(m_converterDir->path());
 
-        QProcess runner;
-        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-
-        QString energyPlusExePath = toQString(getEnergyPlusExecutable());
+      // the page is loaded once the conversion is done, the application is not blocked meanwhile
+      auto converted = [this, jdfTempPath, qJdfPath]() {
+        if (exists(jdfTempPath)) {
+          QFile::copy(toQString(jdfTempPath), qJdfPath);
+        }
+        m_converterDir.reset();
+        loadJdf();
+      };
+      connect(m_converter, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, converted);
+      connect(m_converter, &QProcess::errorOccurred, this, [converted](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+          converted();
+        }
+      });
 
-        runner.setProcessEnvironment(env);
-        runner.setWorkingDirectory(tempDir.path());
+      // if still running after as long as QProcess::waitForFinished would wait, just kill it
+      QProcess* converter = m_converter;
+      QTimer::singleShot(30000, converter, [converter]() {
+        if (converter->state() != QProcess::NotRunning) {
+          converter->kill();
+        }
+      });
 
-        QStringList arguments;
-        arguments << QString("-c") << fi.absoluteFilePath();
+      QStringList arguments;
+      arguments << QString("-c") << fi.absoluteFilePath();
 
-        //m_document->disableTabsDuringRun();
+      m_converter->start(toQString(getEnergyPlusExecutable()), arguments);
 
-        runner.start(energyPlusExePath, arguments);
-        runner.waitForFinished();
-        if (runner.state()) {
-          // if still running just kill it
-          runner.kill();
-        }
-        //int result = runner.exitCode();
-        QString error(runner.readAllStandardError());
-        QString output(runner.readAllStandardOutput());
+      m_document->enable();
+      return;
+    }
+  }
 
-        //m_document->enableTabsAfterRun();
+  loadJdf();
 
-        if (exists(jdfTempPath)) {
-          QString qJdfTempPath = toQString(jdfTempPath);
-          QFile::copy(qJdfTempPath, qJdfPath);
-        }
-      }
-    }
+  m_document->enable();
+}
 
-    if (exists(jdfPath)) {
-      openstudio::filesystem::ifstream ifs(jdfPath);
-      OS_ASSERT(ifs.is_open());
-      std::string contents((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
-      m_jdf = toQString(contents).simplified();  // .replace(QString("\""), QString("\\\""));
-      ifs.close();
-    }
+void IdfEditor::loadJdf() {
+  openstudio::path jdfPath = jdfPathFor(m_idfPath);
+  if (exists(m_idfPath) && exists(jdfPath)) {
+    openstudio::filesystem::ifstream ifs(jdfPath);
+    OS_ASSERT(ifs.is_open());
+    std::string contents((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
+    m_jdf = toQString(contents).simplified();  // .replace(QString("\""), QString("\\\""));
+    ifs.close();
   }
 
   // start loading the editor, will trigger EditorWebView::onLoadFinished when done
   m_view->load(getEmbeddedFileUrl("embeddable_idf_editor.html"));
   //m_view->load(QUrl("file:///E:/openstudio2/openstudiocore/src/openstudio_lib/library/embeddable_idf_editor.html"));
-
-  m_document->enable();
 }
 
 IdfEditor::~IdfEditor() {}
@@ -794,37 +837,26 @@ void IdfEditor::loadEditor() {
 
   if (m_jdf.isEmpty() || m_jdf.isNull() || m_jdf == "null") {
 
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     QString javascript = QString("setMessage(\"Failed to convert IDF to JSON format\");");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
 
   } else {
-    OS_ASSERT(!m_javascriptRunning);
-
-    m_javascriptRunning = true;
-
     QString javascript = QString("setJdf(JSON.stringify(") + m_jdf + QString("));");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   m_editorLoaded = true;
 
   // start checking for updates
   //m_versionNumber = 0;
-  //m_checkForUpdateTimer->start(CHECKFORUPDATEMSEC);
+  //m_checkForUpdateTimer->start();
 }
 
-void IdfEditor::doExport() {
+void IdfEditor::doExport(const std::function<void()>& done) {
   // no-op since we aren't editing anything
+  if (done) {
+    done();
+  }
 }
 
 void IdfEditor::saveExport() {
@@ -912,29 +944,27 @@ OsmEditor::~OsmEditor() {}
 void OsmEditor::loadEditor() {
 
   {
-    OS_ASSERT(!m_javascriptRunning);
-
     model::ThreeJSForwardTranslator ft;
     ThreeScene scene = ft.modelToThreeJS(m_exportModel, true);  // triangulated
     std::string json = scene.toJSON(false);                     // no pretty print
 
     // call init and animate
     QString javascript = QString("init(") + toQString(json) + QString(");\n animate();\n initDatGui();");
-    m_view->page()->runJavaScript(javascript, [this](const QVariant& v) { m_javascriptRunning = false; });
-    while (m_javascriptRunning) {
-      OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
-    }
+    runJavaScript(javascript);
   }
 
   m_editorLoaded = true;
 
   // start checking for updates
   //m_versionNumber = 0;
-  //m_checkForUpdateTimer->start(CHECKFORUPDATEMSEC);
+  //m_checkForUpdateTimer->start();
 }
 
-void OsmEditor::doExport() {
+void OsmEditor::doExport(const std::function<void()>& done) {
   // no-op since we aren't editing anything
+  if (done) {
+    done();
+  }
 }
 
 void OsmEditor::saveExport() {
@@ -1125,6 +1155,8 @@ EditorWebView::~EditorWebView() {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
     m_baseEditor->blockUpdateTimerSignals(true);
     m_baseEditor->checkForUpdate();
+    // the page is going away, get the edits it has not exported yet before merging or saving them
+    m_baseEditor->doExportBlocking();
   }
   if (m_mergeWarn) {
     QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
@@ -1138,7 +1170,8 @@ EditorWebView::~EditorWebView() {
       msg.setEscapeButton(QMessageBox::No);
       int result = msg.exec();
       if (result == QMessageBox::Yes) {
-        mergeClicked();
+        // exported above
+        mergeExport();
       } else if (result == QMessageBox::No) {
         // no-op
       } else if (result == QMessageBox::Ignore) {
@@ -1147,6 +1180,11 @@ EditorWebView::~EditorWebView() {
     }
   }
   saveClickedBlocking("");
+
+  // deleting the page runs the callbacks of scripts still pending, the editor must be gone by then
+  delete m_baseEditor;
+  m_baseEditor = nullptr;
+
   delete m_page;
   delete m_view;
 }
@@ -1265,22 +1303,23 @@ void EditorWebView::refreshClicked() {
 
 void EditorWebView::saveClickedBlocking(const openstudio::path&) {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
-    m_baseEditor->doExport();
+    // the document is saved right after this returns, the editor's latest edits must be exported by then
+    m_baseEditor->doExportBlocking();
     m_baseEditor->saveExport();
   }
 }
 
 void EditorWebView::previewClicked() {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
-    m_baseEditor->doExport();
-    previewExport();
+    m_previewBtn->setEnabled(false);
+    m_baseEditor->doExport([this]() { previewExport(); });
   }
 }
 
 void EditorWebView::mergeClicked() {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
-    m_baseEditor->doExport();
-    mergeExport();
+    m_mergeBtn->setEnabled(false);
+    m_baseEditor->doExport([this]() { mergeExport(); });
   }
   m_mergeWarn = false;
 }
@@ -1293,10 +1332,7 @@ void EditorWebView::debugClicked() {
 void EditorWebView::previewExport() {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
 
-    // do the export
-    m_baseEditor->doExport();
-
-    // translate the exported floorplan
+    // translate the exported floorplan, doExport is done by now
     m_baseEditor->translateExport();
 
     // merge export model into clone of m_model
@@ -1347,10 +1383,7 @@ void EditorWebView::previewExport() {
 void EditorWebView::mergeExport() {
   if (m_baseEditor && m_baseEditor->editorLoaded()) {
 
-    // do the export
-    m_baseEditor->doExport();
-
-    // translate the exported floorplan
+    // translate the exported floorplan, doExport is done by now
     m_baseEditor->translateExport();
 
     // merge export model into m_model
@@ -1371,12 +1404,9 @@ void EditorWebView::mergeExport() {
       QMessageBox::information(this, "Merging Models", "Models Merged");
     }
 
-    // update the editor with merged model (potentially has new handles)
+    // update the editor with merged model (potentially has new handles), this also updates the export
     m_baseEditor->updateModel(m_model);
 
-    // DLM: call doExport again just to be sure we get the freshest content
-    m_baseEditor->doExport();
-
     // save the exported floorplan
     m_baseEditor->saveExport();
 
@@ -30,6 +30,7 @@
 #ifndef OPENSTUDIO_GEOMETRYEDITORVIEW_HPP
 #define OPENSTUDIO_GEOMETRYEDITORVIEW_HPP
 
+#include "FloorplanJSDelta.hpp"
 #include "ModelObjectInspectorView.hpp"
 #include "ModelSubTabView.hpp"
 #include "OSWebEnginePage.hpp"
@@ -42,8 +43,13 @@
 #include <QDialog>
 #include <QProgressBar>
 #include <QWebEngineView>
+#include <QTemporaryDir>
+
+#include <functional>
+#include <memory>
 
 class QComboBox;
+class QProcess;
 class QPushButton;
 class QTimer;
 
@@ -91,9 +97,15 @@ class BaseEditor : public QObject
   model::Model exportModel() const;
   std::map<UUID, UUID> exportModelHandleMapping() const;
 
+  // Get the current content out of the editor, done is called once it is available to saveExport and translateExport
+  virtual void doExport(const std::function<void()>& done) = 0;
+
+  // Same as doExport, returns once the content is available. Used when the caller can't wait, e.g. the document is about
+  // to be saved or the view destroyed
+  void doExportBlocking();
+
  public slots:
   virtual void loadEditor() = 0;
-  virtual void doExport() = 0;
   virtual void saveExport() = 0;
   virtual void translateExport() = 0;
   virtual void updateModel(const openstudio::model::Model& model) = 0;
@@ -106,8 +118,12 @@ class BaseEditor : public QObject
   bool changed();
 
  protected:
+  // Scripts run in the order they are sent, callback gets the result unless this editor was deleted meanwhile
+  void runJavaScript(const QString& javascript, const std::function<void(const QVariant&)>& callback = std::function<void(const QVariant&)>());
+
   bool m_editorLoaded;
-  bool m_javascriptRunning;
+  // number of scripts sent to the page which did not return yet
+  unsigned m_javascriptRunning;
   unsigned m_versionNumber;
 
   bool m_isIP;
@@ -131,19 +147,43 @@ class FloorspaceEditor : public BaseEditor
                    QWidget* t_parent = nullptr);
   virtual ~FloorspaceEditor();
 
+  virtual void doExport(const std::function<void()>& done) override;
+
  public slots:
   virtual void loadEditor();
-  virtual void doExport();
   virtual void saveExport();
   virtual void translateExport();
   virtual void updateModel(const openstudio::model::Model& model);
   virtual void checkForUpdate();
 
+ private slots:
+  void onScriptNotification(const QString& name, const QString& payload);
+
  private:
+  // Pull the changes made in the editor since the last exchange
+  void refreshExport(const std::function<void()>& done = std::function<void()>());
+
+  // Merge a delta returned by osFloorplanSync.exportDelta, returns false if it could not be read
+  bool applyExportDelta(const QVariant& result);
+
+  // Rebuild m_export and m_floorplan from m_editorEntries if they changed
+  void updateExport();
+
   std::string m_originalBuildingName;
   std::string m_originalSiteName;
   openstudio::path m_floorplanPath;
   boost::optional<FloorplanJS> m_floorplan;
+
+  // floorplan as last exchanged with the editor, only the entries which differ from it are sent either way
+  FloorplanJSDelta::Entries m_editorEntries;
+
+  // the editor reported changes which have not been passed to onChanged yet
+  bool m_changePending = false;
+
+  // the editor reported changes which have not been pulled into m_editorEntries yet, they are only pulled when needed
+  bool m_exportOutOfDate = false;
+  // m_editorEntries changed since m_export and m_floorplan were built
+  bool m_exportStale = false;
 };
 
 class GbXmlEditor : public BaseEditor
@@ -155,9 +195,10 @@ class GbXmlEditor : public BaseEditor
               QWidget* t_parent = nullptr);
   virtual ~GbXmlEditor();
 
+  virtual void doExport(const std::function<void()>& done) override;
+
  public slots:
   virtual void loadEditor();
-  virtual void doExport();
   virtual void saveExport();
   virtual void translateExport();
   virtual void updateModel(const openstudio::model::Model& model);
@@ -177,17 +218,25 @@ class IdfEditor : public BaseEditor
             QWidget* t_parent = nullptr);
   virtual ~IdfEditor();
 
+  virtual void doExport(const std::function<void()>& done) override;
+
  public slots:
   virtual void loadEditor();
-  virtual void doExport();
   virtual void saveExport();
   virtual void translateExport();
   virtual void updateModel(const openstudio::model::Model& model);
   virtual void checkForUpdate();
 
  private:
+  // Read the epJSON converted from the IDF and load the page
+  void loadJdf();
+
   openstudio::path m_idfPath;
   QString m_jdf;
+
+  // converts the IDF to epJSON in the background, the page is loaded once it is done
+  QProcess* m_converter;
+  std::unique_ptr<QTemporaryDir> m_converterDir;
 };
 
 class OsmEditor : public BaseEditor
@@ -198,9 +247,10 @@ class OsmEditor : public BaseEditor
   OsmEditor(const openstudio::path& osmPath, bool isIP, const openstudio::model::Model& model, QWebEngineView* m_view, QWidget* t_parent = nullptr);
   virtual ~OsmEditor();
 
+  virtual void doExport(const std::function<void()>& done) override;
+
  public slots:
   virtual void loadEditor();
-  virtual void doExport();
   virtual void saveExport();
   virtual void translateExport();
   virtual void updateModel(const openstudio::model::Model& model);
@@ -46,6 +46,8 @@
 #include <QFile>
 #include <QWebEngineSettings>
 #include <QWebEngineScriptCollection>
+#include <QCoreApplication>
+#include <QPointer>
 #include <QtConcurrent>
 
 using namespace std::placeholders;
@@ -66,8 +68,61 @@ GeometryPreviewView::GeometryPreviewView(bool isIP, const openstudio::model::Mod
 
 GeometryPreviewView::~GeometryPreviewView() {}
 
+PreviewSceneCache& PreviewSceneCache::instance() {
+  static PreviewSceneCache cache;
+  return cache;
+}
+
+unsigned PreviewSceneCache::revision(const model::Model& model) {
+  auto impl = model.getImpl<model::detail::Model_Impl>();
+  if (m_model.lock() != impl) {
+    if (auto previous = m_model.lock()) {
+      previous->onChange.disconnect<PreviewSceneCache, &PreviewSceneCache::onChange>(this);
+    }
+    impl->onChange.connect<PreviewSceneCache, &PreviewSceneCache::onChange>(this);
+    m_model = impl;
+    m_revision = 0;
+    m_jsonRevision.reset();
+    m_json.clear();
+  }
+  return m_revision;
+}
+
+boost::optional<QString> PreviewSceneCache::find(const model::Model& model) {
+  if (m_jsonRevision && *m_jsonRevision == revision(model)) {
+    return m_json;
+  }
+  return boost::none;
+}
+
+void PreviewSceneCache::store(const model::Model& model, unsigned revision, const QString& json) {
+  if (m_model.lock() == model.getImpl<model::detail::Model_Impl>()) {
+    m_jsonRevision = revision;
+    m_json = json;
+  }
+}
+
+void PreviewSceneCache::onChange() {
+  ++m_revision;
+}
+
+namespace {
+
+// Thrown from the progress callback to abort a translation
+struct TranslationCancelled
+{
+};
+
+}  // namespace
+
 PreviewWebView::PreviewWebView(bool isIP, const model::Model& model, QWidget* t_parent)
-  : QWidget(t_parent), m_isIP(isIP), m_model(model), m_progressBar(new QProgressBar()), m_refreshBtn(new QPushButton("Refresh")) {
+  : QWidget(t_parent),
+    m_isIP(isIP),
+    m_model(model),
+    m_progressBar(new QProgressBar()),
+    m_refreshBtn(new QPushButton("Refresh")),
+    m_pageLoaded(false),
+    m_translationId(0) {
 
   openstudio::OSAppBase* app = OSAppBase::instance();
   OS_ASSERT(app);
@@ -112,6 +167,7 @@ PreviewWebView::PreviewWebView(bool isIP, const model::Model& model, QWidget* t_
   //connect(m_view, &QWebEngineView::loadProgress, this, &PreviewWebView::onLoadProgress);
   //connect(m_view, &QWebEngineView::loadStarted, this, &PreviewWebView::onLoadStarted);
   connect(m_view, &QWebEngineView::renderProcessTerminated, this, &PreviewWebView::onRenderProcessTerminated);
+  connect(&m_translationWatcher, &QFutureWatcher<Translation>::finished, this, &PreviewWebView::onTranslationFinished);
 
   // Qt 5.8 and higher
   m_view->settings()->setAttribute(QWebEngineSettings::AllowRunningInsecureContent, true);
@@ -126,6 +182,9 @@ PreviewWebView::PreviewWebView(bool isIP, const model::Model& model, QWidget* t_
 }
 
 PreviewWebView::~PreviewWebView() {
+  // The worker only reaches this through a guarded pointer, it stops at its next progress report
+  cancelTranslation();
+
   delete m_view;
   delete m_page;
 }
@@ -135,6 +194,8 @@ void PreviewWebView::refreshClicked() {
   m_progressBar->setFormat("");
   m_progressBar->setTextVisible(false);
 
+  cancelTranslation();
+  m_pageLoaded = false;
   m_view->triggerPageAction(QWebEnginePage::ReloadAndBypassCache);
 }
 
@@ -159,18 +220,89 @@ void PreviewWebView::onLoadFinished(bool ok) {
     return;
   }
 
-  if (m_json.isEmpty()) {
-    std::function<void(double)> updatePercentage = std::bind(&PreviewWebView::onTranslateProgress, this, _1);
-    //ThreeScene scene = modelToThreeJS(m_model.clone(true).cast<model::Model>(), true, updatePercentage); // triangulated
+  m_pageLoaded = true;
 
-    model::ThreeJSForwardTranslator ft;
-    ThreeScene scene = ft.modelToThreeJS(m_model, true, updatePercentage);  // triangulated
-    std::string json = scene.toJSON(false);                                 // no pretty print
-    m_json = QString::fromStdString(json);
-  } else {
+  if (boost::optional<QString> json = PreviewSceneCache::instance().find(m_model)) {
+    // The model did not change since it was last translated
+    m_json = *json;
     m_progressBar->setValue(90);
+    initScene();
+  } else {
+    startTranslation();
+  }
+}
+
+void PreviewWebView::startTranslation() {
+  // A cancelled translation stops at its next progress report, it is not waited for: its result is dropped by id
+  cancelTranslation();
+
+  unsigned id = ++m_translationId;
+  unsigned revision = PreviewSceneCache::instance().revision(m_model);
+
+  // The worker gets its own copy, the model may be edited while it translates. Model is not thread safe so the copy is made
+  // here, it only copies the objects while the translation also triangulates every surface, and a scene already translated
+  // at this revision is served from PreviewSceneCache without copying anything.
+  model::Model model = m_model.clone(true).cast<model::Model>();
+
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  m_cancelTranslation = cancelled;
+
+  // Only dereferenced on the GUI thread
+  QPointer<PreviewWebView> view(this);
+
+  m_translationWatcher.setFuture(QtConcurrent::run([view, id, revision, model, cancelled]() -> Translation {
+    std::function<void(double)> updatePercentage = [view, id, cancelled](double percentage) {
+      if (*cancelled) {
+        throw TranslationCancelled();
+      }
+      QMetaObject::invokeMethod(
+        QCoreApplication::instance(),
+        [view, id, percentage]() {
+          if (view) {
+            view->onTranslateProgress(id, percentage);
+          }
+        },
+        Qt::QueuedConnection);
+    };
+
+    Translation result;
+    result.id = id;
+    result.revision = revision;
+    try {
+      model::ThreeJSForwardTranslator ft;
+      ThreeScene scene = ft.modelToThreeJS(model, true, updatePercentage);  // triangulated
+      if (!*cancelled) {
+        result.json = QString::fromStdString(scene.toJSON(false));  // no pretty print
+      }
+    } catch (const TranslationCancelled&) {
+    }
+    return result;
+  }));
+}
+
+void PreviewWebView::cancelTranslation() {
+  if (m_cancelTranslation) {
+    *m_cancelTranslation = true;
+    m_cancelTranslation.reset();
+  }
+}
+
+void PreviewWebView::onTranslationFinished() {
+  Translation translation = m_translationWatcher.result();
+  if (translation.id != m_translationId || translation.json.isEmpty()) {
+    // Superseded or cancelled, a new translation will be started if the view is shown again
+    return;
   }
 
+  m_cancelTranslation.reset();
+  m_json = translation.json;
+  PreviewSceneCache::instance().store(m_model, translation.revision, m_json);
+
+  m_progressBar->setValue(90);
+  initScene();
+}
+
+void PreviewWebView::initScene() {
   // disable doc
   m_document->disable();
 
@@ -182,6 +314,22 @@ void PreviewWebView::onLoadFinished(bool ok) {
   //m_view->page()->runJavaScript(javascript, [](const QVariant &v) { callWithResult(v.toString()); });
 }
 
+void PreviewWebView::showEvent(QShowEvent* event) {
+  QWidget::showEvent(event);
+
+  // Resume a translation that was cancelled when the view was hidden
+  if (m_pageLoaded && m_json.isEmpty() && !m_cancelTranslation) {
+    startTranslation();
+  }
+}
+
+void PreviewWebView::hideEvent(QHideEvent* event) {
+  QWidget::hideEvent(event);
+
+  // Don't keep a core busy for a tab the user left
+  cancelTranslation();
+}
+
 //void PreviewWebView::onLoadProgress(int progress)
 //{
 //}
@@ -190,9 +338,11 @@ void PreviewWebView::onLoadFinished(bool ok) {
 //{
 //}
 
-void PreviewWebView::onTranslateProgress(double percentage) {
+void PreviewWebView::onTranslateProgress(unsigned translationId, double percentage) {
+  if (translationId != m_translationId) {
+    return;
+  }
   m_progressBar->setValue(10 + 0.8 * percentage);
-  OSAppBase::instance()->processEvents(QEventLoop::ExcludeUserInputEvents, 200);
 }
 
 void PreviewWebView::onJavaScriptFinished(const QVariant& v) {
@@ -36,9 +36,15 @@
 
 #include <openstudio/model/Model.hpp>
 
+#include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
+
 #include <QWidget>
 #include <QWebEngineView>
 #include <QProgressBar>
+#include <QFutureWatcher>
+
+#include <atomic>
+#include <memory>
 
 class QComboBox;
 class QPushButton;
@@ -59,6 +65,32 @@ class GeometryPreviewView : public QWidget
  private:
 };
 
+// Keeps the JSON of the last translated scene, until the model it was translated from changes
+
+class PreviewSceneCache : public Nano::Observer
+{
+ public:
+  static PreviewSceneCache& instance();
+
+  // Number of changes made to the model since it started being tracked, starts tracking it if needed
+  unsigned revision(const model::Model& model);
+
+  // The scene of this model, if it was translated at its current revision
+  boost::optional<QString> find(const model::Model& model);
+
+  void store(const model::Model& model, unsigned revision, const QString& json);
+
+ private:
+  PreviewSceneCache() = default;
+
+  void onChange();
+
+  std::weak_ptr<model::detail::Model_Impl> m_model;
+  unsigned m_revision = 0;
+  boost::optional<unsigned> m_jsonRevision;
+  QString m_json;
+};
+
 // main widget
 
 class PreviewWebView : public QWidget
@@ -79,13 +111,34 @@ class PreviewWebView : public QWidget
   void onLoadFinished(bool ok);
   //void 	onLoadProgress(int progress);
   //void 	onLoadStarted();
-  void onTranslateProgress(double percentage);
+  void onTranslateProgress(unsigned translationId, double percentage);
   void onJavaScriptFinished(const QVariant& v);
   void onRenderProcessTerminated(QWebEnginePage::RenderProcessTerminationStatus terminationStatus, int exitCode);
+  void onTranslationFinished();
+
+ protected:
+  virtual void showEvent(QShowEvent* event) override;
+  virtual void hideEvent(QHideEvent* event) override;
 
  private:
   REGISTER_LOGGER("openstudio::PreviewWebView");
 
+  // A scene translated on the worker thread, tagged with the translation it comes from
+  struct Translation
+  {
+    unsigned id = 0;
+    unsigned revision = 0;
+    QString json;
+  };
+
+  // Translate a copy of the model to ThreeJS on a worker thread, the page is initialized once it is done
+  void startTranslation();
+
+  void cancelTranslation();
+
+  // Hand the scene over to the page
+  void initScene();
+
   bool m_isIP;
   model::Model m_model;
 
@@ -97,6 +150,12 @@ class PreviewWebView : public QWidget
   std::shared_ptr<OSDocument> m_document;
 
   QString m_json;
+
+  bool m_pageLoaded;
+  // Incremented for each translation, results and progress of older translations are dropped
+  unsigned m_translationId;
+  QFutureWatcher<Translation> m_translationWatcher;
+  std::shared_ptr<std::atomic<bool>> m_cancelTranslation;
 };
 
 }  // namespace openstudio
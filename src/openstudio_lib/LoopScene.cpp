@@ -30,6 +30,7 @@
 #include "LoopScene.hpp"
 #include "OSAppBase.hpp"
 #include "GridItem.hpp"
+#include "../model_editor/ModelChangeBus.hpp"
 #include <QPainter>
 #include <QGraphicsSceneMouseEvent>
 #include <QApplication>
@@ -60,10 +61,8 @@ using namespace openstudio::model;
 namespace openstudio {
 
 LoopScene::LoopScene(model::Loop loop, QObject* parent) : GridScene(parent), m_loop(loop), m_dirty(true) {
-  // loop.model().getImpl<model::detail::Model_Impl>().get()->addWorkspaceObjectPtr.connect<LoopScene, &LoopScene::addedWorkspaceObject>(this);
-  connect(OSAppBase::instance(), &OSAppBase::workspaceObjectAddedPtr, this, &LoopScene::addedWorkspaceObject, Qt::QueuedConnection);
-
-  loop.model().getImpl<model::detail::Model_Impl>().get()->removeWorkspaceObjectPtr.connect<LoopScene, &LoopScene::removedWorkspaceObject>(this);
+  m_modelChangeBus = ModelChangeBus::get(m_loop.model());
+  connect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &LoopScene::onModelChanges);
 
   layout();
 }
@@ -112,21 +111,21 @@ model::Loop LoopScene::loop() {
   return m_loop;
 }
 
-void LoopScene::addedWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
-                                     const openstudio::UUID& uuid) {
-  model::detail::HVACComponent_Impl* hvac_impl = dynamic_cast<model::detail::HVACComponent_Impl*>(wPtr.get());
-  if (hvac_impl) {
-    m_dirty = true;
-
-    QTimer::singleShot(0, this, SLOT(layout()));
+void LoopScene::onModelChanges(const ModelChangeBatch& batch) {
+  bool dirty = !batch.removed.empty();
+  for (auto it = batch.added.begin(); !dirty && it != batch.added.end(); ++it) {
+    for (const auto& wPtr : it->second) {
+      if (dynamic_cast<model::detail::HVACComponent_Impl*>(wPtr.get())) {
+        dirty = true;
+        break;
+      }
+    }
   }
-}
-
-void LoopScene::removedWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
-                                       const openstudio::UUID& uuid) {
-  m_dirty = true;
 
-  QTimer::singleShot(0, this, SLOT(layout()));
+  if (dirty) {
+    m_dirty = true;
+    layout();
+  }
 }
 
 }  // namespace openstudio
@@ -64,6 +64,10 @@ class SupplySideItem;
 
 class OASystemItem;
 
+struct ModelChangeBatch;
+
+class ModelChangeBus;
+
 class LoopScene : public GridScene
 {
 
@@ -78,12 +82,6 @@ class LoopScene : public GridScene
 
  public slots:
 
-  void addedWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
-                            const openstudio::UUID& uuid);
-
-  void removedWorkspaceObject(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
-                              const openstudio::UUID& uuid);
-
   void layout();
 
   //signals:
@@ -97,6 +95,9 @@ class LoopScene : public GridScene
   //void innerNodeClicked( model::ModelObject & );
 
  private:
+  // Lay the loop out again if HVAC components were added or anything was removed
+  void onModelChanges(const ModelChangeBatch& batch);
+
   DemandSideItem* createDemandSide();
 
   SupplySideItem* createSupplySide();
@@ -106,6 +107,8 @@ class LoopScene : public GridScene
   model::Loop m_loop;
 
   bool m_dirty;
+
+  std::shared_ptr<ModelChangeBus> m_modelChangeBus;
 };
 
 }  // namespace openstudio
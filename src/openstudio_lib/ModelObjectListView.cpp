@@ -30,6 +30,7 @@
 #include "ModelObjectListView.hpp"
 #include "ModelObjectItem.hpp"
 #include "OSAppBase.hpp"
+#include "../model_editor/ModelChangeBus.hpp"
 #include "BCLComponentItem.hpp"
 
 #include <openstudio/model/Model_Impl.hpp>
@@ -56,25 +57,27 @@ namespace openstudio {
 ModelObjectListController::ModelObjectListController(const openstudio::IddObjectType& iddObjectType, const model::Model& model, bool showLocalBCL)
   : m_iddObjectType(iddObjectType), m_model(model), m_showLocalBCL(showLocalBCL) {
 
-  // model.getImpl<model::detail::Model_Impl>().get()->addWorkspaceObjectPtr.connect<ModelObjectListController, &ModelObjectListController::objectAdded>(this);
-  connect(OSAppBase::instance(), &OSAppBase::workspaceObjectAddedPtr, this, &ModelObjectListController::objectAdded, Qt::QueuedConnection);
-
-  //model.getImpl<model::detail::Model_Impl>().get()->removeWorkspaceObjectPtr.connect<ModelObjectListController, &ModelObjectListController::objectRemoved>(this);
-  connect(OSAppBase::instance(), &OSAppBase::workspaceObjectRemovedPtr, this, &ModelObjectListController::objectRemoved, Qt::QueuedConnection);
+  m_modelChangeBus = ModelChangeBus::get(m_model);
+  connect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &ModelObjectListController::onModelChanges);
 }
 
 IddObjectType ModelObjectListController::iddObjectType() const {
   return m_iddObjectType;
 }
 
-void ModelObjectListController::objectAdded(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl,
-                                            const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle) {
-  if (iddObjectType == m_iddObjectType) {
-    std::vector<OSItemId> ids = this->makeVector();
-    emit itemIds(ids);
+void ModelObjectListController::onModelChanges(const ModelChangeBatch& batch) {
+  auto added = batch.added.find(m_iddObjectType);
+  if ((added == batch.added.end()) && (batch.removed.count(m_iddObjectType) == 0)) {
+    return;
+  }
+
+  std::vector<OSItemId> ids = this->makeVector();
+  emit itemIds(ids);
 
+  if (added != batch.added.end()) {
+    QString itemId = toQString(added->second.back()->handle());
     for (const OSItemId& id : ids) {
-      if (id.itemId() == toQString(impl->handle())) {
+      if (id.itemId() == itemId) {
         emit selectedItemId(id);
         break;
       }
@@ -82,13 +85,6 @@ void ModelObjectListController::objectAdded(std::shared_ptr<openstudio::detail::
   }
 }
 
-void ModelObjectListController::objectRemoved(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl,
-                                              const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle) {
-  if (iddObjectType == m_iddObjectType) {
-    emit itemIds(makeVector());
-  }
-}
-
 std::vector<OSItemId> ModelObjectListController::makeVector() {
   std::vector<OSItemId> result;
 
@@ -39,6 +39,10 @@
 
 namespace openstudio {
 
+struct ModelChangeBatch;
+
+class ModelChangeBus;
+
 class ModelObjectListController : public OSVectorController
 {
   Q_OBJECT
@@ -50,17 +54,17 @@ class ModelObjectListController : public OSVectorController
 
   IddObjectType iddObjectType() const;
 
- private slots:
-  void objectAdded(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&);
-  void objectRemoved(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&);
-
  protected:
   virtual std::vector<OSItemId> makeVector() override;
 
  private:
+  // Rebuild the list once per batch touching the type, select the last object added
+  void onModelChanges(const ModelChangeBatch& batch);
+
   openstudio::IddObjectType m_iddObjectType;
   model::Model m_model;
   bool m_showLocalBCL;
+  std::shared_ptr<ModelChangeBus> m_modelChangeBus;
 };
 
 class ModelObjectListView : public OSItemList
@@ -164,6 +164,8 @@ ModelObjectTreeItem::ModelObjectTreeItem(const openstudio::model::ModelObject& m
   m_modelObject->getImpl<model::detail::ModelObject_Impl>()
     .get()
     ->onRelationshipChange.connect<ModelObjectTreeItem, &ModelObjectTreeItem::changeRelationship>(this);
+
+  itemsByHandle().emplace(*m_handle, this);
 }
 
 ModelObjectTreeItem::ModelObjectTreeItem(const std::string& name, const openstudio::model::Model& model, QTreeWidgetItem* parent)
@@ -172,14 +174,41 @@ ModelObjectTreeItem::ModelObjectTreeItem(const std::string& name, const openstud
 
   this->setText(0, toQString(name));
   this->setStyle(0, "");
+
+  itemsByName().emplace(m_name, this);
 }
 
 ModelObjectTreeItem::~ModelObjectTreeItem() {
+  auto unregister = [this](auto& index, const auto& key) {
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == this) {
+        index.erase(it);
+        break;
+      }
+    }
+  };
+  if (m_handle) {
+    unregister(itemsByHandle(), *m_handle);
+  } else {
+    unregister(itemsByName(), m_name);
+  }
+
   if (m_item) {
     delete m_item;
   }
 }
 
+std::multimap<Handle, ModelObjectTreeItem*>& ModelObjectTreeItem::itemsByHandle() {
+  static std::multimap<Handle, ModelObjectTreeItem*> result;
+  return result;
+}
+
+std::multimap<std::string, ModelObjectTreeItem*>& ModelObjectTreeItem::itemsByName() {
+  static std::multimap<std::string, ModelObjectTreeItem*> result;
+  return result;
+}
+
 boost::optional<openstudio::Handle> ModelObjectTreeItem::handle() const {
   return m_handle;
 }
@@ -284,6 +313,14 @@ void ModelObjectTreeItem::makeDirty() {
 }
 
 void ModelObjectTreeItem::refresh() {
+  updateChildren(true);
+}
+
+void ModelObjectTreeItem::refreshMembership() {
+  updateChildren(false);
+}
+
+void ModelObjectTreeItem::updateChildren(bool recursive) {
   m_dirty = false;
 
   std::vector<std::string> nonModelObjectChildren = this->nonModelObjectChildren();
@@ -314,7 +351,9 @@ void ModelObjectTreeItem::refresh() {
     if (modelObject) {
       if (allModelObjectChildrenHandleSet.find(modelObject->handle()) != allModelObjectChildrenHandleSet.end()) {
         // this item's model object is for a model object we should have
-        modelObjectTreeItem->refresh();
+        if (recursive) {
+          modelObjectTreeItem->refresh();
+        }
 
         // erase from set so we don't add later
         allModelObjectChildrenHandleSet.erase(modelObject->handle());
@@ -327,7 +366,9 @@ void ModelObjectTreeItem::refresh() {
     } else {
       if (nonModelObjectChildrenSet.find(modelObjectTreeItem->name()) != nonModelObjectChildrenSet.end()) {
         // this item's name is a name we should have
-        modelObjectTreeItem->refresh();
+        if (recursive) {
+          modelObjectTreeItem->refresh();
+        }
 
         // erase from set so we don't add later
         nonModelObjectChildrenSet.erase(modelObjectTreeItem->name());
@@ -389,6 +430,54 @@ void ModelObjectTreeItem::refreshTree() {
   }
 }
 
+void ModelObjectTreeItem::refreshParents(const std::vector<Handle>& parents, const std::string& unassignedItemName, bool recursive) {
+  // other trees showing the same object get their own notification
+  QTreeWidget* treeWidget = this->treeWidget();
+
+  std::set<ModelObjectTreeItem*> items;
+  bool unassigned = false;
+  for (const Handle& parent : parents) {
+    if (parent.isNull()) {
+      unassigned = true;
+      continue;
+    }
+    auto range = itemsByHandle().equal_range(parent);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->treeWidget() == treeWidget) {
+        items.insert(it->second);
+      }
+    }
+  }
+  if (unassigned && !unassignedItemName.empty()) {
+    auto range = itemsByName().equal_range(unassignedItemName);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->treeWidget() == treeWidget) {
+        items.insert(it->second);
+      }
+    }
+  }
+
+  for (ModelObjectTreeItem* item : items) {
+    if (!item->isDirty()) {
+      item->makeDirty();
+      if (recursive) {
+        QTimer::singleShot(0, item, SLOT(refresh()));
+      } else {
+        QTimer::singleShot(0, item, SLOT(refreshMembership()));
+      }
+    }
+  }
+}
+
+void ModelObjectTreeItem::addFilterCandidate(const std::string& itemName, const model::ModelObject& object) {
+  auto range = itemsByName().equal_range(itemName);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (auto filteredItem = dynamic_cast<FilteredObjectsTreeItem*>(it->second)) {
+      filteredItem->addCandidate(object);
+    }
+  }
+}
+
 void ModelObjectTreeItem::change() {
   boost::optional<model::ModelObject> modelObject = this->modelObject();
   OS_ASSERT(modelObject);
@@ -396,6 +485,9 @@ void ModelObjectTreeItem::change() {
   // these objects have 'type' fields that are not relationships but change tree structure
   switch (modelObject->iddObjectType().value()) {
     case IddObjectType::OS_ShadingSurfaceGroup:
+      // the group may have become a site or building one
+      addFilterCandidate(SiteShadingTreeItem::itemName(), *modelObject);
+      addFilterCandidate(BuildingShadingTreeItem::itemName(), *modelObject);
       refreshTree();
       break;
     case IddObjectType::OS_InteriorPartitionSurfaceGroup:
@@ -435,9 +527,32 @@ void ModelObjectTreeItem::changeRelationship(int index, Handle newHandle, Handle
       }
       break;
     case IddObjectType::OS_Space:
-      if (index == OS_SpaceFields::BuildingStoryName || index == OS_SpaceFields::SpaceTypeName || index == OS_SpaceFields::ThermalZoneName ||
-          index == OS_SpaceFields::DesignSpecificationOutdoorAirObjectName) {
-        refreshTree();
+      // the space moves from its old parent to its new one, the rest of the tree is unchanged
+      if (index == OS_SpaceFields::BuildingStoryName) {
+        if (newHandle.isNull()) {
+          addFilterCandidate(NoBuildingStoryTreeItem::itemName(), *modelObject);
+        }
+        refreshParents({oldHandle, newHandle}, NoBuildingStoryTreeItem::itemName(), false);
+      } else if (index == OS_SpaceFields::ThermalZoneName) {
+        if (newHandle.isNull()) {
+          addFilterCandidate(NoThermalZoneTreeItem::itemName(), *modelObject);
+        }
+        refreshParents({oldHandle, newHandle}, NoThermalZoneTreeItem::itemName(), false);
+      } else if (index == OS_SpaceFields::SpaceTypeName) {
+        if (newHandle.isNull()) {
+          addFilterCandidate(NoSpaceTypeTreeItem::itemName(), *modelObject);
+        }
+        std::vector<Handle> parents{oldHandle, newHandle};
+        // spaces without a space type inherit the building's one
+        boost::optional<model::Building> building = this->model().getOptionalUniqueModelObject<model::Building>();
+        if (building && building->spaceType()) {
+          parents.push_back(building->spaceType()->handle());
+        }
+        refreshParents(parents, NoSpaceTypeTreeItem::itemName(), false);
+        // the space type's loads are listed with the space
+        refreshParents({modelObject->handle()}, std::string(), true);
+      } else if (index == OS_SpaceFields::DesignSpecificationOutdoorAirObjectName) {
+        refreshParents({modelObject->handle()}, std::string(), true);
       }
       break;
     case IddObjectType::OS_ShadingSurfaceGroup:
@@ -445,7 +560,7 @@ void ModelObjectTreeItem::changeRelationship(int index, Handle newHandle, Handle
       break;
     case IddObjectType::OS_ShadingSurface:
       if (index == OS_ShadingSurfaceFields::ShadingSurfaceGroupName) {
-        refreshTree();
+        refreshParents({oldHandle, newHandle}, std::string(), false);
       }
       break;
     case IddObjectType::OS_InteriorPartitionSurfaceGroup:
@@ -453,13 +568,14 @@ void ModelObjectTreeItem::changeRelationship(int index, Handle newHandle, Handle
       break;
     case IddObjectType::OS_InteriorPartitionSurface:
       if (index == OS_InteriorPartitionSurfaceFields::InteriorPartitionSurfaceGroupName) {
-        refreshTree();
+        refreshParents({oldHandle, newHandle}, std::string(), false);
       }
       break;
     case IddObjectType::OS_Surface:
       // handle in onChange
       if (index == OS_SurfaceFields::SpaceName) {
-        refreshTree();
+        // surfaces are listed in containers below their space
+        refreshParents({oldHandle, newHandle}, std::string(), true);
       }
       break;
     case IddObjectType::OS_SubSurface:
@@ -467,12 +583,12 @@ void ModelObjectTreeItem::changeRelationship(int index, Handle newHandle, Handle
       break;
     case IddObjectType::OS_Daylighting_Control:
       if (index == OS_Daylighting_ControlFields::SpaceName) {
-        refreshTree();
+        refreshParents({oldHandle, newHandle}, std::string(), true);
       }
       break;
     case IddObjectType::OS_IlluminanceMap:
       if (index == OS_IlluminanceMapFields::SpaceName) {
-        refreshTree();
+        refreshParents({oldHandle, newHandle}, std::string(), true);
       }
       break;
     case IddObjectType::OS_InternalMass:
@@ -585,10 +701,79 @@ void ModelObjectTreeItem::changeName() {
   }
 }
 
+///////////////////// FilteredObjects ////////////////////////////////////////////////
+
+FilteredObjectsTreeItem::FilteredObjectsTreeItem(const std::string& name, const openstudio::model::Model& model,
+                                                 const openstudio::IddObjectType& objectType,
+                                                 const boost::optional<openstudio::IddObjectType>& parentType, QTreeWidgetItem* parent)
+  : ModelObjectTreeItem(name, model, parent), m_objectType(objectType), m_parentType(parentType) {
+  model.getImpl<model::detail::Model_Impl>().get()->addWorkspaceObject.connect<FilteredObjectsTreeItem, &FilteredObjectsTreeItem::onAddWorkspaceObject>(
+    this);
+  model.getImpl<model::detail::Model_Impl>()
+    .get()
+    ->removeWorkspaceObject.connect<FilteredObjectsTreeItem, &FilteredObjectsTreeItem::onRemoveWorkspaceObject>(this);
+}
+
+void FilteredObjectsTreeItem::addCandidate(const model::ModelObject& object) {
+  if (m_indexed && object.iddObjectType() == m_objectType) {
+    m_candidates.emplace(object.handle(), object);
+  }
+}
+
+bool FilteredObjectsTreeItem::isCandidate(const model::ModelObject& object) const {
+  return isChild(object);
+}
+
+void FilteredObjectsTreeItem::onAddWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType,
+                                                   const openstudio::UUID& handle) {
+  // it may no longer qualify by the time the children are read
+  if (iddObjectType == m_objectType) {
+    addCandidate(object.cast<model::ModelObject>());
+  }
+}
+
+void FilteredObjectsTreeItem::onRemoveWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType,
+                                                      const openstudio::UUID& handle) {
+  if (iddObjectType == m_objectType) {
+    m_candidates.erase(handle);
+  } else if (m_parentType && iddObjectType == *m_parentType) {
+    // the parent is still in the model, its children are about to lose it
+    for (const WorkspaceObject& child : object.getSources(m_objectType)) {
+      addCandidate(child.cast<model::ModelObject>());
+    }
+  }
+}
+
+std::vector<model::ModelObject> FilteredObjectsTreeItem::modelObjectChildren() const {
+  if (!m_indexed) {
+    for (const WorkspaceObject& object : this->model().getObjectsByType(m_objectType)) {
+      auto modelObject = object.cast<model::ModelObject>();
+      if (isCandidate(modelObject)) {
+        m_candidates.emplace(modelObject.handle(), modelObject);
+      }
+    }
+    m_indexed = true;
+  }
+
+  std::vector<model::ModelObject> result;
+  for (auto it = m_candidates.begin(); it != m_candidates.end();) {
+    if (!isCandidate(it->second)) {
+      it = m_candidates.erase(it);
+    } else {
+      if (isChild(it->second)) {
+        result.push_back(it->second);
+      }
+      ++it;
+    }
+  }
+  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
+  return result;
+}
+
 ///////////////////// SiteShading ////////////////////////////////////////////////
 
 SiteShadingTreeItem::SiteShadingTreeItem(const openstudio::model::Model& model, QTreeWidgetItem* parent)
-  : ModelObjectTreeItem(SiteShadingTreeItem::itemName(), model, parent) {
+  : FilteredObjectsTreeItem(SiteShadingTreeItem::itemName(), model, IddObjectType::OS_ShadingSurfaceGroup, boost::none, parent) {
   this->setStyle(1, "");
   this->makeChildren();
 }
@@ -597,15 +782,8 @@ std::string SiteShadingTreeItem::itemName() {
   return "Site Shading";
 }
 
-std::vector<model::ModelObject> SiteShadingTreeItem::modelObjectChildren() const {
-  std::vector<model::ModelObject> result;
-  for (const model::ShadingSurfaceGroup& shadingSurfaceGroup : this->model().getConcreteModelObjects<model::ShadingSurfaceGroup>()) {
-    if (openstudio::istringEqual("Site", shadingSurfaceGroup.shadingSurfaceType())) {
-      result.push_back(shadingSurfaceGroup);
-    }
-  }
-  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
-  return result;
+bool SiteShadingTreeItem::isChild(const model::ModelObject& object) const {
+  return openstudio::istringEqual("Site", object.cast<model::ShadingSurfaceGroup>().shadingSurfaceType());
 }
 
 void SiteShadingTreeItem::addModelObjectChild(const model::ModelObject& child, bool isDefaulted) {
@@ -723,7 +901,7 @@ void BuildingTreeItem::addNonModelObjectChild(const std::string& child) {
 ///////////////////// BuildingShading ////////////////////////////////////////////////
 
 BuildingShadingTreeItem::BuildingShadingTreeItem(const openstudio::model::Model& model, QTreeWidgetItem* parent)
-  : ModelObjectTreeItem(BuildingShadingTreeItem::itemName(), model, parent) {
+  : FilteredObjectsTreeItem(BuildingShadingTreeItem::itemName(), model, IddObjectType::OS_ShadingSurfaceGroup, boost::none, parent) {
   this->setStyle(2, "");
   this->makeChildren();
 }
@@ -732,15 +910,8 @@ std::string BuildingShadingTreeItem::itemName() {
   return "Building Shading";
 }
 
-std::vector<model::ModelObject> BuildingShadingTreeItem::modelObjectChildren() const {
-  std::vector<model::ModelObject> result;
-  for (const model::ShadingSurfaceGroup& shadingSurfaceGroup : this->model().getConcreteModelObjects<model::ShadingSurfaceGroup>()) {
-    if (openstudio::istringEqual("Building", shadingSurfaceGroup.shadingSurfaceType())) {
-      result.push_back(shadingSurfaceGroup);
-    }
-  }
-  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
-  return result;
+bool BuildingShadingTreeItem::isChild(const model::ModelObject& object) const {
+  return openstudio::istringEqual("Building", object.cast<model::ShadingSurfaceGroup>().shadingSurfaceType());
 }
 
 void BuildingShadingTreeItem::addModelObjectChild(const model::ModelObject& child, bool isDefaulted) {
@@ -782,7 +953,8 @@ void BuildingStoryTreeItem::addModelObjectChild(const model::ModelObject& child,
 }
 
 NoBuildingStoryTreeItem::NoBuildingStoryTreeItem(const openstudio::model::Model& model, QTreeWidgetItem* parent)
-  : ModelObjectTreeItem(NoBuildingStoryTreeItem::itemName(), model, parent) {
+  : FilteredObjectsTreeItem(NoBuildingStoryTreeItem::itemName(), model, IddObjectType::OS_Space, IddObjectType(IddObjectType::OS_BuildingStory),
+                            parent) {
   this->makeChildren();
 }
 
@@ -790,16 +962,8 @@ std::string NoBuildingStoryTreeItem::itemName() {
   return "Unassigned Building Story";
 }
 
-std::vector<model::ModelObject> NoBuildingStoryTreeItem::modelObjectChildren() const {
-  model::Model model = this->model();
-  std::vector<model::ModelObject> result;
-  for (const model::Space& space : model.getConcreteModelObjects<model::Space>()) {
-    if (!space.buildingStory()) {
-      result.push_back(space);
-    }
-  }
-  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
-  return result;
+bool NoBuildingStoryTreeItem::isChild(const model::ModelObject& object) const {
+  return !object.cast<model::Space>().buildingStory();
 }
 
 void NoBuildingStoryTreeItem::addModelObjectChild(const model::ModelObject& child, bool isDefaulted) {
@@ -854,7 +1018,8 @@ void ThermalZoneTreeItem::addModelObjectChild(const model::ModelObject& child, b
 }
 
 NoThermalZoneTreeItem::NoThermalZoneTreeItem(const openstudio::model::Model& model, QTreeWidgetItem* parent)
-  : ModelObjectTreeItem(NoThermalZoneTreeItem::itemName(), model, parent) {
+  : FilteredObjectsTreeItem(NoThermalZoneTreeItem::itemName(), model, IddObjectType::OS_Space, IddObjectType(IddObjectType::OS_ThermalZone),
+                            parent) {
   this->setStyle(2, "#F15A24");
   this->makeChildren();
 }
@@ -863,16 +1028,8 @@ std::string NoThermalZoneTreeItem::itemName() {
   return "Unassigned Thermal Zone";
 }
 
-std::vector<model::ModelObject> NoThermalZoneTreeItem::modelObjectChildren() const {
-  model::Model model = this->model();
-  std::vector<model::ModelObject> result;
-  for (const model::Space& space : model.getConcreteModelObjects<model::Space>()) {
-    if (!space.thermalZone()) {
-      result.push_back(space);
-    }
-  }
-  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
-  return result;
+bool NoThermalZoneTreeItem::isChild(const model::ModelObject& object) const {
+  return !object.cast<model::Space>().thermalZone();
 }
 
 void NoThermalZoneTreeItem::addModelObjectChild(const model::ModelObject& child, bool isDefaulted) {
@@ -945,7 +1102,7 @@ void SpaceTypeTreeItem::addModelObjectChild(const model::ModelObject& child, boo
 }
 
 NoSpaceTypeTreeItem::NoSpaceTypeTreeItem(const openstudio::model::Model& model, QTreeWidgetItem* parent)
-  : ModelObjectTreeItem(NoSpaceTypeTreeItem::itemName(), model, parent) {
+  : FilteredObjectsTreeItem(NoSpaceTypeTreeItem::itemName(), model, IddObjectType::OS_Space, IddObjectType(IddObjectType::OS_SpaceType), parent) {
   this->makeChildren();
 }
 
@@ -953,16 +1110,13 @@ std::string NoSpaceTypeTreeItem::itemName() {
   return "Unassigned Space Type";
 }
 
-std::vector<model::ModelObject> NoSpaceTypeTreeItem::modelObjectChildren() const {
-  model::Model model = this->model();
-  std::vector<model::ModelObject> result;
-  for (const model::Space& space : model.getConcreteModelObjects<model::Space>()) {
-    if (!space.spaceType()) {
-      result.push_back(space);
-    }
-  }
-  std::sort(result.begin(), result.end(), WorkspaceObjectNameLess());
-  return result;
+bool NoSpaceTypeTreeItem::isChild(const model::ModelObject& object) const {
+  return !object.cast<model::Space>().spaceType();
+}
+
+bool NoSpaceTypeTreeItem::isCandidate(const model::ModelObject& object) const {
+  // the building's space type may change without touching the space
+  return object.cast<model::Space>().isSpaceTypeDefaulted();
 }
 
 void NoSpaceTypeTreeItem::addModelObjectChild(const model::ModelObject& child, bool isDefaulted) {
@@ -39,6 +39,8 @@
 #include <QTreeWidgetItem>
 #include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
 
+#include <map>
+
 class QPushButton;
 class QLabel;
 
@@ -92,6 +94,9 @@ class ModelObjectTreeItem : public QObject, public QTreeWidgetItem, public Nano:
 
   void refresh();
 
+  // Update which children this item has, without refreshing the children it keeps
+  void refreshMembership();
+
   void refreshTree();
 
   void change();
@@ -120,6 +125,13 @@ class ModelObjectTreeItem : public QObject, public QTreeWidgetItem, public Nano:
   // called after makeChildren or refresh
   virtual void finalize();
 
+  // Queue a refresh of the items of this tree representing parents, instead of refreshing the whole tree when a relationship
+  // change only moves an object from a parent to another. A null parent stands for the unassigned item named unassignedItemName.
+  void refreshParents(const std::vector<Handle>& parents, const std::string& unassignedItemName, bool recursive);
+
+  // Tell the FilteredObjectsTreeItems named itemName, in every tree, that object may now be one of their children
+  static void addFilterCandidate(const std::string& itemName, const model::ModelObject& object);
+
   static const OSItemType m_type;
 
   static OSItemType initializeOSItemType();
@@ -129,6 +141,12 @@ class ModelObjectTreeItem : public QObject, public QTreeWidgetItem, public Nano:
   void changeName();
 
  private:
+  void updateChildren(bool recursive);
+
+  // items of all trees by the model object they represent, and container items by name
+  static std::multimap<Handle, ModelObjectTreeItem*>& itemsByHandle();
+  static std::multimap<std::string, ModelObjectTreeItem*>& itemsByName();
+
   boost::optional<openstudio::Handle> m_handle;
   boost::optional<openstudio::model::ModelObject> m_modelObject;
   openstudio::model::Model m_model;
@@ -137,9 +155,52 @@ class ModelObjectTreeItem : public QObject, public QTreeWidgetItem, public Nano:
   bool m_dirty;
 };
 
+///////////////////// FilteredObjects ////////////////////////////////////////////////
+
+/// Container item listing the objects of one type which meet a condition (no building story, site shading, ...).
+///
+/// The candidates are indexed once, then kept up to date from the model signals instead of scanning every object of the
+/// type on each refresh: added objects become candidates, and so do the children of a removed parent. Candidates which
+/// no longer qualify are dropped when the children are read; whatever makes them qualify again must call
+/// addFilterCandidate (see changeRelationship and change).
+class FilteredObjectsTreeItem : public ModelObjectTreeItem
+{
+  Q_OBJECT
+
+ public:
+  virtual ~FilteredObjectsTreeItem() {}
+
+  void addCandidate(const model::ModelObject& object);
+
+ protected:
+  // parentType is the type whose removal leaves its children of objectType without a parent, if any
+  FilteredObjectsTreeItem(const std::string& name, const openstudio::model::Model& model, const openstudio::IddObjectType& objectType,
+                          const boost::optional<openstudio::IddObjectType>& parentType, QTreeWidgetItem* parent = nullptr);
+
+  // Whether this candidate is listed
+  virtual bool isChild(const model::ModelObject& object) const = 0;
+
+  // Whether this object should stay a candidate, by default only the children do
+  virtual bool isCandidate(const model::ModelObject& object) const;
+
+  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+
+ private:
+  void onAddWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+
+  void onRemoveWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+
+  openstudio::IddObjectType m_objectType;
+  boost::optional<openstudio::IddObjectType> m_parentType;
+
+  // Built on the first read, isChild and isCandidate can't be called from this constructor
+  mutable bool m_indexed = false;
+  mutable std::map<Handle, model::ModelObject> m_candidates;
+};
+
 ///////////////////// SiteShading ////////////////////////////////////////////////
 
-class SiteShadingTreeItem : public ModelObjectTreeItem
+class SiteShadingTreeItem : public FilteredObjectsTreeItem
 {
   Q_OBJECT
 
@@ -149,7 +210,7 @@ class SiteShadingTreeItem : public ModelObjectTreeItem
   static std::string itemName();
 
  protected:
-  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+  virtual bool isChild(const model::ModelObject& object) const override;
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
 };
 
@@ -190,7 +251,7 @@ class BuildingTreeItem : public ModelObjectTreeItem
 
 ///////////////////// BuildingShading ////////////////////////////////////////////////
 
-class BuildingShadingTreeItem : public ModelObjectTreeItem
+class BuildingShadingTreeItem : public FilteredObjectsTreeItem
 {
   Q_OBJECT
 
@@ -200,7 +261,7 @@ class BuildingShadingTreeItem : public ModelObjectTreeItem
   static std::string itemName();
 
  protected:
-  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+  virtual bool isChild(const model::ModelObject& object) const override;
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
 };
 
@@ -219,7 +280,7 @@ class BuildingStoryTreeItem : public ModelObjectTreeItem
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
 };
 
-class NoBuildingStoryTreeItem : public ModelObjectTreeItem
+class NoBuildingStoryTreeItem : public FilteredObjectsTreeItem
 {
   Q_OBJECT
 
@@ -229,7 +290,7 @@ class NoBuildingStoryTreeItem : public ModelObjectTreeItem
   static std::string itemName();
 
  protected:
-  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+  virtual bool isChild(const model::ModelObject& object) const override;
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
   virtual void finalize() override;
 };
@@ -249,7 +310,7 @@ class ThermalZoneTreeItem : public ModelObjectTreeItem
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
 };
 
-class NoThermalZoneTreeItem : public ModelObjectTreeItem
+class NoThermalZoneTreeItem : public FilteredObjectsTreeItem
 {
   Q_OBJECT
 
@@ -259,7 +320,7 @@ class NoThermalZoneTreeItem : public ModelObjectTreeItem
   static std::string itemName();
 
  protected:
-  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+  virtual bool isChild(const model::ModelObject& object) const override;
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
   virtual void finalize() override;
 };
@@ -280,7 +341,7 @@ class SpaceTypeTreeItem : public ModelObjectTreeItem
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
 };
 
-class NoSpaceTypeTreeItem : public ModelObjectTreeItem
+class NoSpaceTypeTreeItem : public FilteredObjectsTreeItem
 {
   Q_OBJECT
 
@@ -290,7 +351,9 @@ class NoSpaceTypeTreeItem : public ModelObjectTreeItem
   static std::string itemName();
 
  protected:
-  virtual std::vector<model::ModelObject> modelObjectChildren() const override;
+  virtual bool isChild(const model::ModelObject& object) const override;
+  // Spaces without a space type of their own, they have none if the building has none either
+  virtual bool isCandidate(const model::ModelObject& object) const override;
   virtual void addModelObjectChild(const model::ModelObject& child, bool isDefaulted) override;
   virtual void finalize() override;
 };
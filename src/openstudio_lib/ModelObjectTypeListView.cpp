@@ -28,6 +28,7 @@
 ***********************************************************************************************************************/
 
 #include "ModelObjectTypeListView.hpp"
+#include "ComponentLibrary.hpp"
 #include "ModelObjectTypeItem.hpp"
 #include "ModelObjectItem.hpp"
 #include "ModelObjectListView.hpp"
@@ -61,6 +62,9 @@ ModelObjectTypeListView::ModelObjectTypeListView(const std::vector<std::pair<Idd
 }
 
 void ModelObjectTypeListView::addModelObjectType(const IddObjectType& iddObjectType, const std::string& name) {
+  // The component library is loaded on demand, make sure objects of this type are there before listing them
+  ComponentLibrary::load(m_model, iddObjectType);
+
   OSCollapsibleItemHeader* collapsibleItemHeader = new OSCollapsibleItemHeader(name, OSItemId("", "", false), m_headerType);
   auto modelObjectListView = new ModelObjectListView(iddObjectType, m_model, false, m_showLocalBCL);
   auto modelObjectTypeItem = new ModelObjectTypeItem(collapsibleItemHeader, modelObjectListView);
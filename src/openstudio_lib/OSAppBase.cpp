@@ -49,6 +49,7 @@
 #include <QDir>
 #include <QEvent>
 #include <QMessageBox>
+#include <QMetaMethod>
 #include <QTimer>
 
 namespace openstudio {
@@ -109,24 +110,39 @@ void OSAppBase::showMeasureUpdateDlg() {
 //  }
 //}
 
+// The views subscribe with queued connections, each emit posts an event per subscriber holding the object. Views that
+// moved to ModelChangeBus no longer subscribe, skip the signals no one listens to
+
 void OSAppBase::addWorkspaceObject(const WorkspaceObject& workspaceObject, const openstudio::IddObjectType& type, const openstudio::UUID& uuid) {
-  // Emit QT Signal
-  emit workspaceObjectAdded(workspaceObject, type, uuid);
+  static const QMetaMethod signal = QMetaMethod::fromSignal(&OSAppBase::workspaceObjectAdded);
+  if (isSignalConnected(signal)) {
+    // Emit QT Signal
+    emit workspaceObjectAdded(workspaceObject, type, uuid);
+  }
 }
 
 void OSAppBase::addWorkspaceObjectPtr(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
                                       const openstudio::UUID& uuid) {
-  // Emit QT Signal
-  emit workspaceObjectAddedPtr(wPtr, type, uuid);
+  static const QMetaMethod signal = QMetaMethod::fromSignal(&OSAppBase::workspaceObjectAddedPtr);
+  if (isSignalConnected(signal)) {
+    // Emit QT Signal
+    emit workspaceObjectAddedPtr(wPtr, type, uuid);
+  }
 }
 
 void OSAppBase::removeWorkspaceObject(const WorkspaceObject& workspaceObject, const openstudio::IddObjectType& type, const openstudio::UUID& uuid) {
-  emit workspaceObjectRemoved(workspaceObject, type, uuid);
+  static const QMetaMethod signal = QMetaMethod::fromSignal(&OSAppBase::workspaceObjectRemoved);
+  if (isSignalConnected(signal)) {
+    emit workspaceObjectRemoved(workspaceObject, type, uuid);
+  }
 }
 
 void OSAppBase::removeWorkspaceObjectPtr(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl> wPtr, const openstudio::IddObjectType& type,
                                          const openstudio::UUID& uuid) {
-  emit workspaceObjectRemovedPtr(wPtr, type, uuid);
+  static const QMetaMethod signal = QMetaMethod::fromSignal(&OSAppBase::workspaceObjectRemovedPtr);
+  if (isSignalConnected(signal)) {
+    emit workspaceObjectRemovedPtr(wPtr, type, uuid);
+  }
 }
 
 QWidget* OSAppBase::mainWidget() {
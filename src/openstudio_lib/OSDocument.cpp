@@ -30,6 +30,7 @@
 #include "OSDocument.hpp"
 
 #include "ApplyMeasureNowDialog.hpp"
+#include "ComponentLibrary.hpp"
 #include "ConstructionsTabController.hpp"
 #include "GeometryTabController.hpp"
 #include "FacilityTabController.hpp"
@@ -1517,7 +1518,8 @@ boost::optional<model::ModelObject> OSDocument::getModelObject(const OSItemId& i
   else if (fromComponentLibrary(itemId)) {
     if (itemId.sourceId() == modelToSourceId(m_compLibrary)) {
       Handle handle(toUUID(itemId.itemId()));
-      return m_compLibrary.getModelObject<model::ModelObject>(handle);
+      // The library holding it may not be loaded yet
+      return ComponentLibrary::getModelObject(m_compLibrary, handle);
     }
   }
   // TODO: should we handle BCL objects here?
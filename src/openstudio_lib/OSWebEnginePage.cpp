@@ -46,6 +46,17 @@ bool OSWebEnginePage::acceptNavigationRequest(const QUrl& url, QWebEnginePage::N
   return true;
 }
 
+void OSWebEnginePage::javaScriptConsoleMessage(QWebEnginePage::JavaScriptConsoleMessageLevel level, const QString& message, int lineNumber,
+                                               const QString& sourceID) {
+  // pushed by the page, lets the application react without polling it through runJavaScript
+  if (message.startsWith(notificationPrefix)) {
+    QString notification = message.mid(QString(notificationPrefix).size());
+    emit scriptNotification(notification.section(':', 0, 0), notification.section(':', 1));
+    return;
+  }
+  QWebEnginePage::javaScriptConsoleMessage(level, message, lineNumber, sourceID);
+}
+
 bool OSWebEnginePage::certificateError(const QWebEngineCertificateError& certificateError) {
   // Ignore error
   LOG(Warn, "SSL error: " << certificateError.errorDescription().toStdString());
@@ -43,9 +43,18 @@ class OSWebEnginePage : public QWebEnginePage
  public:
   OSWebEnginePage(QObject* parent = 0) : QWebEnginePage(parent) {}
 
+  // Prefix of the console messages a page uses to notify the application, e.g. console.info("openstudio:name:payload")
+  static constexpr const char* notificationPrefix = "openstudio:";
+
+ signals:
+
+  void scriptNotification(const QString& name, const QString& payload);
+
  protected:
   virtual bool certificateError(const QWebEngineCertificateError& certificateError) override;
   virtual bool acceptNavigationRequest(const QUrl& url, QWebEnginePage::NavigationType type, bool isMainFrame) override;
+  virtual void javaScriptConsoleMessage(QWebEnginePage::JavaScriptConsoleMessageLevel level, const QString& message, int lineNumber,
+                                        const QString& sourceID) override;
 
  private:
   REGISTER_LOGGER("openstudio::OSWebEnginePage");
@@ -0,0 +1,147 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "RunProgressParser.hpp"
+
+#include <QHash>
+
+namespace openstudio {
+
+namespace {
+
+struct Message
+{
+  RunProgressParser::State state;
+  RunProgressParser::Style style;
+  const char* text;
+};
+
+// Messages are matched on the trimmed, lower cased line. Lines not listed here are logged as is.
+const QHash<QString, Message>& messages() {
+  using State = RunProgressParser::State;
+  using Style = RunProgressParser::Style;
+  static const QHash<QString, Message> result{
+    {"started", {State::stopped, Style::Normal, nullptr}},
+    {"starting state initialization", {State::initialization, Style::Heading, "Initializing workflow."}},
+    {"returned from state initialization", {State::stopped, Style::Normal, nullptr}},
+    {"starting state os_measures", {State::os_measures, Style::Heading, "Processing OpenStudio Measures."}},
+    {"returned from state os_measures", {State::stopped, Style::Normal, nullptr}},
+    {"starting state translator", {State::translator, Style::Heading, "Translating the OpenStudio Model to EnergyPlus."}},
+    {"returned from state translator", {State::stopped, Style::Normal, nullptr}},
+    {"starting state ep_measures", {State::ep_measures, Style::Heading, "Processing EnergyPlus Measures."}},
+    {"returned from state ep_measures", {State::stopped, Style::Normal, nullptr}},
+    // preprocess only moves the progress bar
+    {"starting state preprocess", {State::preprocess, Style::Normal, nullptr}},
+    {"returned from state preprocess", {State::stopped, Style::Normal, nullptr}},
+    {"starting state simulation", {State::simulation, Style::Heading, "Starting Simulation."}},
+    {"returned from state simulation", {State::stopped, Style::Normal, nullptr}},
+    {"starting state reporting_measures", {State::reporting_measures, Style::Heading, "Processing Reporting Measures."}},
+    {"returned from state reporting_measures", {State::stopped, Style::Normal, nullptr}},
+    {"starting state postprocess", {State::postprocess, Style::Heading, "Gathering Reports."}},
+    {"returned from state postprocess", {State::stopped, Style::Normal, nullptr}},
+    {"complete", {State::stopped, Style::Heading, "Completed."}},
+    {"failure", {State::stopped, Style::Error, "Failed."}},
+  };
+  return result;
+}
+
+}  // namespace
+
+std::vector<RunProgressParser::Event> RunProgressParser::feed(const QByteArray& data) {
+  std::vector<Event> result;
+
+  int start = 0;
+  int end = data.indexOf('\n');
+  while (end >= 0) {
+    Event event;
+    if (m_partialLine.isEmpty()) {
+      if (parseLine(data.mid(start, end - start), event)) {
+        result.push_back(event);
+      }
+    } else {
+      m_partialLine.append(data.constData() + start, end - start);
+      if (parseLine(m_partialLine, event)) {
+        result.push_back(event);
+      }
+      m_partialLine.clear();
+    }
+    start = end + 1;
+    end = data.indexOf('\n', start);
+  }
+  m_partialLine.append(data.constData() + start, data.size() - start);
+
+  return result;
+}
+
+std::vector<RunProgressParser::Event> RunProgressParser::finish() {
+  std::vector<Event> result;
+  Event event;
+  if (parseLine(m_partialLine, event)) {
+    result.push_back(event);
+  }
+  m_partialLine.clear();
+  return result;
+}
+
+void RunProgressParser::reset() {
+  m_partialLine.clear();
+}
+
+bool RunProgressParser::parseLine(const QByteArray& line, Event& event) {
+  // lines are decoded once complete, so multi-byte characters split across reads survive
+  QString text = QString::fromUtf8(line);
+  if (text.endsWith('\r')) {
+    text.chop(1);
+  }
+
+  QString key = text.trimmed().toLower();
+  if (key.isEmpty()) {
+    return false;
+  }
+
+  auto it = messages().constFind(key);
+  if (it != messages().constEnd()) {
+    event.state = it->state;
+    event.style = it->style;
+    if (it->text) {
+      event.text = QString(it->text);
+    }
+  } else if (key.startsWith("applying")) {
+    event.style = Style::Subheading;
+    event.text = text;
+  } else if (key.startsWith("applied")) {
+    return false;
+  } else {
+    event.text = text;
+  }
+
+  return (event.state != State::stopped) || !event.text.isEmpty();
+}
+
+}  // namespace openstudio
@@ -0,0 +1,99 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_RUNPROGRESSPARSER_HPP
+#define OPENSTUDIO_RUNPROGRESSPARSER_HPP
+
+#include "OpenStudioAPI.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <vector>
+
+namespace openstudio {
+
+/***
+* RunProgressParser decodes the progress messages the workflow writes to the run socket,
+* see openstudio-workflow-gem\lib\openstudio\workflow\adapters\output\socket.rb.
+*
+* Data is fed as it arrives, a line split across reads is kept until its end arrives. Complete lines are matched against
+* a table of known messages and turned into events for RunView.
+**/
+class OPENSTUDIO_API RunProgressParser
+{
+ public:
+  enum State
+  {
+    stopped = 0,
+    initialization = 1,
+    os_measures = 2,
+    translator = 3,
+    ep_measures = 4,
+    preprocess = 5,
+    simulation = 6,
+    reporting_measures = 7,
+    postprocess = 8,
+    complete = 9
+  };
+
+  enum class Style
+  {
+    Normal,
+    Heading,
+    Subheading,
+    Error
+  };
+
+  struct Event
+  {
+    // state entered, stopped if the line does not change state
+    State state = State::stopped;
+    // text to log, empty if the line is not shown
+    QString text;
+    Style style = Style::Normal;
+  };
+
+  // Parse the complete lines in data, a trailing partial line is kept for the next call
+  std::vector<Event> feed(const QByteArray& data);
+
+  // Parse what is left once the connection is closed
+  std::vector<Event> finish();
+
+  void reset();
+
+ private:
+  static bool parseLine(const QByteArray& line, Event& event);
+
+  QByteArray m_partialLine;
+};
+
+}  // namespace openstudio
+
+#endif  // OPENSTUDIO_RUNPROGRESSPARSER_HPP
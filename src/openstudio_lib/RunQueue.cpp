@@ -0,0 +1,317 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "RunQueue.hpp"
+
+#include "../model_editor/Utilities.hpp"
+
+#include <openstudio/utilities/core/Assert.hpp>
+#include <openstudio/utilities/filetypes/WorkflowJSON.hpp>
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace openstudio {
+
+// a job which has not connected to its run server by then is shown as running, its progress shows up if it connects later
+const int RUNSTARTTIMEOUTMSEC = 60000;
+
+RunQueue::RunQueue(const QString& program, const QProcessEnvironment& environment, QObject* parent)
+  : QObject(parent), m_program(program), m_environment(environment), m_maxJobs(defaultMaxJobs()) {}
+
+RunQueue::~RunQueue() {
+  for (auto& entry : m_jobs) {
+    QProcess* process = entry.second.process;
+    if (process) {
+      process->disconnect(this);
+      process->kill();
+      process->waitForFinished();
+    }
+  }
+}
+
+int RunQueue::defaultMaxJobs() {
+  return std::max(1, QThread::idealThreadCount());
+}
+
+int RunQueue::maxJobs() const {
+  return m_maxJobs;
+}
+
+void RunQueue::setMaxJobs(int maxJobs) {
+  m_maxJobs = std::max(1, maxJobs);
+  startNext();
+}
+
+int RunQueue::addJob(const QString& name, const openstudio::path& workflowPath) {
+  int id = m_nextId++;
+  Job& job = m_jobs[id];
+  job.name = name;
+  job.workflowPath = workflowPath;
+  m_queuedJobs.push_back(id);
+
+  emit jobStatusChanged(id, JobStatus::Queued);
+
+  startNext();
+
+  return id;
+}
+
+void RunQueue::cancel(int id) {
+  auto it = m_jobs.find(id);
+  if (it == m_jobs.end()) {
+    return;
+  }
+
+  Job& job = it->second;
+  if (job.status == JobStatus::Queued) {
+    m_queuedJobs.erase(std::remove(m_queuedJobs.begin(), m_queuedJobs.end(), id), m_queuedJobs.end());
+    setStatus(id, job, JobStatus::Canceled);
+  } else if (job.process) {
+    // status is set once the process is gone
+    job.canceled = true;
+    job.process->kill();
+  }
+}
+
+void RunQueue::cancelAll() {
+  std::vector<int> ids;
+  for (const auto& entry : m_jobs) {
+    ids.push_back(entry.first);
+  }
+  for (int id : ids) {
+    cancel(id);
+  }
+}
+
+RunQueue::JobStatus RunQueue::status(int id) const {
+  auto it = m_jobs.find(id);
+  OS_ASSERT(it != m_jobs.end());
+  return it->second.status;
+}
+
+openstudio::path RunQueue::jobDirectory(int id) const {
+  auto it = m_jobs.find(id);
+  OS_ASSERT(it != m_jobs.end());
+  return it->second.workflowPath.parent_path();
+}
+
+int RunQueue::activeJobCount() const {
+  int result = 0;
+  for (const auto& entry : m_jobs) {
+    if (entry.second.process) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+void RunQueue::startNext() {
+  while (!m_queuedJobs.empty() && (activeJobCount() < m_maxJobs)) {
+    int id = m_queuedJobs.front();
+    m_queuedJobs.pop_front();
+    startJob(id, m_jobs[id]);
+  }
+}
+
+void RunQueue::startJob(int id, Job& job) {
+  openstudio::path directory = job.workflowPath.parent_path();
+  openstudio::path stdoutPath = directory / "stdout";
+  openstudio::path stderrPath = directory / "stderr";
+  if (exists(stdoutPath)) {
+    remove(stdoutPath);
+  }
+  if (exists(stderrPath)) {
+    remove(stderrPath);
+  }
+
+  job.server = new QTcpServer(this);
+  job.server->listen();
+  connect(job.server, &QTcpServer::newConnection, this, [this, id]() { onJobConnection(id); });
+
+  QStringList arguments;
+  arguments << "run"
+            << "-s" << QString::number(job.server->serverPort()) << "-w" << toQString(job.workflowPath);
+
+  LOG(Debug, "Starting run '" << toString(job.name) << "': " << toString(m_program) << " " << arguments.join(" ").toStdString());
+
+  job.process = new QProcess(this);
+  job.process->setProcessEnvironment(m_environment);
+  job.process->setStandardOutputFile(toQString(stdoutPath));
+  job.process->setStandardErrorFile(toQString(stderrPath));
+  connect(job.process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+          [this, id](int exitCode, QProcess::ExitStatus exitStatus) { onJobFinished(id, exitCode, exitStatus); });
+  connect(job.process, &QProcess::errorOccurred, this, [this, id](QProcess::ProcessError error) {
+    if (error == QProcess::FailedToStart) {
+      onJobFinished(id, -1, QProcess::CrashExit);
+    }
+  });
+
+  // dropped with the server once the job is done
+  QTimer::singleShot(RUNSTARTTIMEOUTMSEC, job.server, [this, id]() { onStartTimeout(id); });
+  setStatus(id, job, JobStatus::Starting);
+
+  job.process->start(m_program, arguments);
+}
+
+void RunQueue::onJobConnection(int id) {
+  Job& job = m_jobs[id];
+  while (job.server && job.server->hasPendingConnections()) {
+    QTcpSocket* socket = job.server->nextPendingConnection();
+    if (job.socket) {
+      LOG(Warn, "Unexpected connection to the run server of '" << toString(job.name) << "'");
+      socket->deleteLater();
+      continue;
+    }
+
+    job.socket = socket;
+    connect(socket, &QTcpSocket::readyRead, this, [this, id]() { onJobDataReady(id); });
+
+    // the socket stays open, no other connection is expected
+    job.server->close();
+
+    if (job.status == JobStatus::Starting) {
+      setStatus(id, job, JobStatus::Running);
+    }
+  }
+}
+
+void RunQueue::onStartTimeout(int id) {
+  Job& job = m_jobs[id];
+  if (job.status == JobStatus::Starting) {
+    LOG(Warn, "Run '" << toString(job.name) << "' did not connect to the run server yet, its progress is shown once it does");
+    setStatus(id, job, JobStatus::Running);
+  }
+}
+
+void RunQueue::onJobDataReady(int id) {
+  Job& job = m_jobs[id];
+  if (job.socket) {
+    std::vector<RunProgressParser::Event> events = job.parser.feed(job.socket->readAll());
+    if (!events.empty()) {
+      emit jobEvents(id, events);
+    }
+  }
+}
+
+void RunQueue::onJobFinished(int id, int exitCode, QProcess::ExitStatus exitStatus) {
+  Job& job = m_jobs[id];
+  if (!job.process) {
+    return;
+  }
+
+  LOG(Debug, "Run '" << toString(job.name) << "' finished with exit code " << exitCode);
+
+  // the last line may not have been terminated
+  std::vector<RunProgressParser::Event> events;
+  if (job.socket) {
+    events = job.parser.feed(job.socket->readAll());
+    job.socket->deleteLater();
+    job.socket = nullptr;
+  }
+  std::vector<RunProgressParser::Event> lastEvents = job.parser.finish();
+  events.insert(events.end(), lastEvents.begin(), lastEvents.end());
+  if (!events.empty()) {
+    emit jobEvents(id, events);
+  }
+
+  job.process->deleteLater();
+  job.process = nullptr;
+
+  if (job.server) {
+    job.server->deleteLater();
+    job.server = nullptr;
+  }
+
+  if (job.canceled) {
+    setStatus(id, job, JobStatus::Canceled);
+  } else if ((exitStatus == QProcess::NormalExit) && (exitCode == 0)) {
+    setStatus(id, job, JobStatus::Succeeded);
+  } else {
+    setStatus(id, job, JobStatus::Failed);
+  }
+
+  startNext();
+}
+
+void RunQueue::setStatus(int id, Job& job, JobStatus status) {
+  job.status = status;
+  emit jobStatusChanged(id, status);
+}
+
+boost::optional<openstudio::path> RunQueue::prepareWorkflow(const openstudio::path& workflowPath, const openstudio::path& directory,
+                                                            const boost::optional<openstudio::path>& weatherFile) {
+  boost::optional<WorkflowJSON> workflow = WorkflowJSON::load(workflowPath);
+  if (!workflow) {
+    return boost::none;
+  }
+
+  openstudio::filesystem::create_directories(directory);
+
+  WorkflowJSON result = workflow->clone();
+
+  // paths relative to the original workflow would not resolve from the new directory
+  result.resetMeasurePaths();
+  for (const auto& measurePath : workflow->absoluteMeasurePaths()) {
+    result.addMeasurePath(measurePath);
+  }
+  for (const auto& filePath : workflow->absoluteFilePaths()) {
+    result.addFilePath(filePath);
+  }
+
+  if (boost::optional<openstudio::path> seedFile = workflow->seedFile()) {
+    boost::optional<openstudio::path> absoluteSeedFile = workflow->findFile(*seedFile);
+    if (!absoluteSeedFile) {
+      return boost::none;
+    }
+    openstudio::path copiedSeedFile = directory / absoluteSeedFile->filename();
+    openstudio::filesystem::copy_file(*absoluteSeedFile, copiedSeedFile, openstudio::filesystem::copy_option::overwrite_if_exists);
+    result.setSeedFile(copiedSeedFile);
+  }
+
+  if (weatherFile) {
+    result.setWeatherFile(*weatherFile);
+  } else if (boost::optional<openstudio::path> originalWeatherFile = workflow->weatherFile()) {
+    if (boost::optional<openstudio::path> absoluteWeatherFile = workflow->findFile(*originalWeatherFile)) {
+      result.setWeatherFile(*absoluteWeatherFile);
+    }
+  }
+
+  openstudio::path resultPath = directory / "workflow.osw";
+  if (!result.saveAs(resultPath)) {
+    return boost::none;
+  }
+  return resultPath;
+}
+
+}  // namespace openstudio
@@ -0,0 +1,155 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_RUNQUEUE_HPP
+#define OPENSTUDIO_RUNQUEUE_HPP
+
+#include "RunProgressParser.hpp"
+
+#include <openstudio/utilities/core/Logger.hpp>
+#include <openstudio/utilities/core/Path.hpp>
+
+#include <boost/optional.hpp>
+
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+
+#include <deque>
+#include <map>
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace openstudio {
+
+/***
+* RunQueue runs workflows with the OpenStudio CLI, up to maxJobs() at once.
+*
+* Every job reports its progress over the run server socket protocol, the CLI is passed a server port and connects
+* back when the workflow starts. The protocol does not identify the job, so each job gets a server of its own: whatever
+* connects to it, however late, belongs to that job and jobs are started without waiting on each other.
+**/
+class RunQueue : public QObject
+{
+  Q_OBJECT
+
+ public:
+  enum class JobStatus
+  {
+    Queued,
+    Starting,
+    Running,
+    Succeeded,
+    Failed,
+    Canceled
+  };
+
+  RunQueue(const QString& program, const QProcessEnvironment& environment, QObject* parent = nullptr);
+
+  // kills the jobs still running
+  virtual ~RunQueue();
+
+  // One job per core by default
+  static int defaultMaxJobs();
+
+  int maxJobs() const;
+
+  void setMaxJobs(int maxJobs);
+
+  // Queue a workflow, it runs in the run directory of the workflow. Returns the job id
+  int addJob(const QString& name, const openstudio::path& workflowPath);
+
+  // Cancel a job, a running job is killed
+  void cancel(int id);
+
+  void cancelAll();
+
+  JobStatus status(int id) const;
+
+  // Directory containing the job's workflow
+  openstudio::path jobDirectory(int id) const;
+
+  // Jobs started and not finished yet
+  int activeJobCount() const;
+
+  // Write a copy of workflowPath in directory which can run independently of the original, using weatherFile if given.
+  // The seed model is copied so that later changes to the original do not affect the run.
+  static boost::optional<openstudio::path> prepareWorkflow(const openstudio::path& workflowPath, const openstudio::path& directory,
+                                                           const boost::optional<openstudio::path>& weatherFile);
+
+ signals:
+
+  void jobStatusChanged(int id, RunQueue::JobStatus status);
+
+  void jobEvents(int id, const std::vector<RunProgressParser::Event>& events);
+
+ private:
+  REGISTER_LOGGER("openstudio::RunQueue");
+
+  struct Job
+  {
+    QString name;
+    openstudio::path workflowPath;
+    JobStatus status = JobStatus::Queued;
+    QProcess* process = nullptr;
+    // the run server the job's process reports to
+    QTcpServer* server = nullptr;
+    QTcpSocket* socket = nullptr;
+    RunProgressParser parser;
+    bool canceled = false;
+  };
+
+  void startNext();
+
+  void startJob(int id, Job& job);
+
+  void onJobConnection(int id);
+
+  void onStartTimeout(int id);
+
+  void onJobDataReady(int id);
+
+  void onJobFinished(int id, int exitCode, QProcess::ExitStatus exitStatus);
+
+  void setStatus(int id, Job& job, JobStatus status);
+
+  QString m_program;
+  QProcessEnvironment m_environment;
+  int m_maxJobs;
+
+  int m_nextId = 1;
+  std::map<int, Job> m_jobs;
+  std::deque<int> m_queuedJobs;
+};
+
+}  // namespace openstudio
+
+#endif  // OPENSTUDIO_RUNQUEUE_HPP
@@ -69,7 +69,9 @@
 
 #include <QButtonGroup>
 #include <QDir>
+#include <QFileDialog>
 #include <QGroupBox>
+#include <QHBoxLayout>
 #include <QLabel>
 #include <QMessageBox>
 #include <QPainter>
@@ -79,28 +81,39 @@
 #include <QRadioButton>
 #include <QScrollArea>
 #include <QStackedWidget>
+#include <QScrollBar>
+#include <QSettings>
+#include <QSpinBox>
 #include <QStyleOption>
 #include <QSysInfo>
 #include <QTimer>
 #include <QToolButton>
+#include <QTreeWidget>
 #include <QVBoxLayout>
+#include <QTextCharFormat>
+#include <QTextCursor>
 #include <QTextEdit>
 #include <QProcess>
 #include <QProcessEnvironment>
 #include <QStandardPaths>
 #include <QFileSystemWatcher>
 #include <QDesktopServices>
-#include <QTcpServer>
 #include <QTcpSocket>
 
 namespace openstudio {
 
+// lines kept in the run log, older lines are dropped
+const int MAXRUNLOGLINES = 10000;
+
+// run output is written to the log at most this often
+const int RUNLOGFLUSHMSEC = 100;
+
 RunTabView::RunTabView(const model::Model& model, QWidget* parent)
   : MainTabView("Run Simulation", MainTabView::MAIN_TAB, parent), m_runView(new RunView()) {
   addTabWidget(m_runView);
 }
 
-RunView::RunView() : QWidget(), m_runSocket(nullptr) {
+RunView::RunView() : QWidget() {
   auto mainLayout = new QGridLayout();
   mainLayout->setContentsMargins(10, 10, 10, 10);
   mainLayout->setSpacing(5);
@@ -138,12 +151,52 @@ RunView::RunView() : QWidget(), m_runSocket(nullptr) {
   connect(m_openSimDirButton, &QPushButton::clicked, this, &RunView::onOpenSimDirClicked);
   mainLayout->addWidget(m_openSimDirButton, 0, 2);
 
-  m_textInfo = new QTextEdit();
+  // QPlainTextEdit only lays out the visible lines, a long run output stays cheap to show
+  m_textInfo = new QPlainTextEdit();
   m_textInfo->setReadOnly(true);
+  m_textInfo->setMaximumBlockCount(MAXRUNLOGLINES);
   mainLayout->addWidget(m_textInfo, 1, 0, 1, 3);
 
-  m_runProcess = new QProcess(this);
-  connect(m_runProcess, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this, &RunView::onRunProcessFinished);
+  m_logFlushTimer = new QTimer(this);
+  m_logFlushTimer->setSingleShot(true);
+  m_logFlushTimer->setInterval(RUNLOGFLUSHMSEC);
+  connect(m_logFlushTimer, &QTimer::timeout, this, &RunView::flushLog);
+
+  // Weather file runs
+  m_runWeatherFilesButton = new QPushButton("Run Weather Files...");
+  m_runWeatherFilesButton->setToolTip("Run the current model with each selected weather file, in parallel");
+  connect(m_runWeatherFilesButton, &QPushButton::clicked, this, &RunView::runWeatherFilesClicked);
+
+  m_cancelJobsButton = new QPushButton("Cancel Runs");
+  m_cancelJobsButton->setToolTip("Cancel the selected weather file runs, or all of them if none is selected");
+  connect(m_cancelJobsButton, &QPushButton::clicked, this, &RunView::cancelJobsClicked);
+
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  m_maxJobsSpinBox = new QSpinBox();
+  m_maxJobsSpinBox->setRange(1, RunQueue::defaultMaxJobs());
+  m_maxJobsSpinBox->setValue(settings.value("runQueueMaxJobs", RunQueue::defaultMaxJobs()).toInt());
+
+  auto jobsLayout = new QHBoxLayout();
+  jobsLayout->addWidget(m_runWeatherFilesButton);
+  jobsLayout->addWidget(m_cancelJobsButton);
+  jobsLayout->addStretch();
+  jobsLayout->addWidget(new QLabel("Parallel runs:"));
+  jobsLayout->addWidget(m_maxJobsSpinBox);
+  mainLayout->addLayout(jobsLayout, 2, 0, 1, 3);
+
+  m_jobsView = new QTreeWidget();
+  m_jobsView->setColumnCount(3);
+  m_jobsView->setHeaderLabels(QStringList() << "Weather File"
+                                            << "Status"
+                                            << "Progress");
+  m_jobsView->setRootIsDecorated(false);
+  m_jobsView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  m_jobsView->setToolTip("Double click a run to open its directory");
+  connect(m_jobsView, &QTreeWidget::itemDoubleClicked, this, &RunView::onJobDoubleClicked);
+  mainLayout->addWidget(m_jobsView, 3, 0, 1, 3);
+
+  mainLayout->setRowStretch(1, 3);
+  mainLayout->setRowStretch(3, 1);
 
   QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
 
@@ -162,11 +215,15 @@ RunView::RunView() : QWidget(), m_runSocket(nullptr) {
     env.insert("PERL_EXE_PATH", toQString(perlExecutablePath));
   }
 
-  m_runProcess->setProcessEnvironment(env);
+  // Use OpenStudioApplicationPathHelpers to find the CLI
+  QString openstudioExePath = toQString(openstudio::getOpenStudioCoreCLI());
+  LOG(Debug, "openstudioExePath='" << toString(openstudioExePath) << "'");
 
-  m_runTcpServer = new QTcpServer();
-  m_runTcpServer->listen();
-  connect(m_runTcpServer, &QTcpServer::newConnection, this, &RunView::onNewConnection);
+  m_runQueue = new RunQueue(openstudioExePath, env, this);
+  m_runQueue->setMaxJobs(m_maxJobsSpinBox->value());
+  connect(m_runQueue, &RunQueue::jobStatusChanged, this, &RunView::onJobStatusChanged);
+  connect(m_runQueue, &RunQueue::jobEvents, this, &RunView::onJobEvents);
+  connect(m_maxJobsSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &RunView::onMaxJobsChanged);
 }
 
 void RunView::onOpenSimDirClicked() {
@@ -178,8 +235,12 @@ void RunView::onOpenSimDirClicked() {
   }
 }
 
-void RunView::onRunProcessFinished(int exitCode, QProcess::ExitStatus status) {
+void RunView::onRunFinished() {
   LOG(Debug, "run finished");
+
+  flushLog();
+
+  m_mainJobId = -1;
   m_playButton->setChecked(false);
   m_state = State::stopped;
   m_progressBar->setValue(State::complete);
@@ -188,11 +249,6 @@ void RunView::onRunProcessFinished(int exitCode, QProcess::ExitStatus status) {
   osdocument->save();
   osdocument->enableTabsAfterRun();
   m_openSimDirButton->setEnabled(true);
-
-  if (m_runSocket) {
-    delete m_runSocket;
-  }
-  m_runSocket = nullptr;
 }
 
 void RunView::playButtonClicked(bool t_checked) {
@@ -212,9 +268,6 @@ void RunView::playButtonClicked(bool t_checked) {
       }
     }
 
-    // Use OpenStudioApplicationPathHelpers to find the CLI
-    QString openstudioExePath = toQString(openstudio::getOpenStudioCoreCLI());
-
     // run in save dir
     //auto basePath = getCompanionFolder( toPath(osdocument->savePath()) );
 
@@ -222,144 +275,230 @@ void RunView::playButtonClicked(bool t_checked) {
     auto basePath = toPath(osdocument->modelTempDir()) / toPath("resources");
 
     auto workflowPath = basePath / "workflow.osw";
-    auto stdoutPath = basePath / "stdout";
-    auto stderrPath = basePath / "stderr";
 
     OS_ASSERT(exists(workflowPath));
 
-    auto workflowJSONPath = QString::fromStdString(workflowPath.string());
-    QStringList arguments;
-    arguments << "run"
-              << "-s" << QString::number(m_runTcpServer->serverPort()) << "-w" << workflowJSONPath;
-
-    LOG(Debug, "openstudioExePath='" << toString(openstudioExePath) << "'");
-    LOG(Debug, "run arguments" << arguments.join(";").toStdString());
-
     osdocument->disableTabsDuringRun();
     m_openSimDirButton->setEnabled(false);
 
-    if (exists(stdoutPath)) {
-      remove(stdoutPath);
-    }
-    if (exists(stderrPath)) {
-      remove(stderrPath);
-    }
-
     m_progressBar->setValue(0);
     m_state = State::stopped;
+    m_pendingLog.clear();
+    m_logFlushTimer->stop();
     m_textInfo->clear();
-    m_runProcess->setStandardOutputFile(toQString(stdoutPath));
-    m_runProcess->setStandardErrorFile(toQString(stderrPath));
-    m_runProcess->start(openstudioExePath, arguments);
+
+    // weather file runs may be using the cores, the current model waits for its turn like they do
+    m_mainJobId = m_runQueue->addJob("Current model", workflowPath);
+    RunQueue::JobStatus status = m_runQueue->status(m_mainJobId);
+    if ((status == RunQueue::JobStatus::Failed) || (status == RunQueue::JobStatus::Canceled)) {
+      // the CLI could not even be started
+      onRunFinished();
+    }
   } else {
     // stop running
     LOG(Debug, "Kill Simulation");
-    m_runProcess->kill();
+    m_runQueue->cancel(m_mainJobId);
   }
 }
 
-void RunView::onNewConnection() {
-  m_runSocket = m_runTcpServer->nextPendingConnection();
-  connect(m_runSocket, &QTcpSocket::readyRead, this, &RunView::onRunDataReady);
+void RunView::onJobStatusChanged(int id, RunQueue::JobStatus status) {
+  bool done = (status == RunQueue::JobStatus::Succeeded) || (status == RunQueue::JobStatus::Failed) || (status == RunQueue::JobStatus::Canceled);
+
+  if (id == m_mainJobId) {
+    if (done) {
+      onRunFinished();
+    }
+    return;
+  }
+
+  auto it = m_jobItems.find(id);
+  if (it == m_jobItems.end()) {
+    return;
+  }
+
+  QString text;
+  switch (status) {
+    case RunQueue::JobStatus::Queued:
+      text = "Queued";
+      break;
+    case RunQueue::JobStatus::Starting:
+      text = "Starting";
+      break;
+    case RunQueue::JobStatus::Running:
+      text = "Running";
+      break;
+    case RunQueue::JobStatus::Succeeded:
+      text = "Completed";
+      break;
+    case RunQueue::JobStatus::Failed:
+      text = "Failed";
+      break;
+    case RunQueue::JobStatus::Canceled:
+      text = "Canceled";
+      break;
+  }
+  it->second->setText(1, text);
+  it->second->setForeground(1, (status == RunQueue::JobStatus::Failed) ? Qt::red : Qt::black);
+
+  if (done) {
+    if (auto progressBar = qobject_cast<QProgressBar*>(m_jobsView->itemWidget(it->second, 2))) {
+      progressBar->setValue(State::complete);
+    }
+  }
 }
 
-void RunView::onRunDataReady() {
-  auto appendErrorText = [&](const QString& text) {
-    m_textInfo->setTextColor(Qt::red);
-    m_textInfo->setFontPointSize(18);
-    m_textInfo->append(text);
-  };
-
-  auto appendNormalText = [&](const QString& text) {
-    m_textInfo->setTextColor(Qt::black);
-    m_textInfo->setFontPointSize(12);
-    m_textInfo->append(text);
-  };
-
-  auto appendH1Text = [&](const QString& text) {
-    m_textInfo->setTextColor(Qt::black);
-    m_textInfo->setFontPointSize(18);
-    m_textInfo->append(text);
-  };
-
-  auto appendH2Text = [&](const QString& text) {
-    m_textInfo->setTextColor(Qt::black);
-    m_textInfo->setFontPointSize(15);
-    m_textInfo->append(text);
-  };
-
-  QString data = m_runSocket->readAll();
-  QStringList lines = data.split("\n");
-
-  for (const auto& line : lines) {
-    //std::cout << data.toStdString() << std::endl;
-
-    QString trimmedLine = line.trimmed();
-
-    // DLM: coordinate with openstudio-workflow-gem\lib\openstudio\workflow\adapters\output\socket.rb
-    if (trimmedLine.isEmpty()) {
+void RunView::onJobEvents(int id, const std::vector<RunProgressParser::Event>& events) {
+  if (id == m_mainJobId) {
+    processRunEvents(events);
+    return;
+  }
+
+  // weather file runs only show their progress, their output is in their directory
+  auto it = m_jobItems.find(id);
+  if (it == m_jobItems.end()) {
+    return;
+  }
+  if (auto progressBar = qobject_cast<QProgressBar*>(m_jobsView->itemWidget(it->second, 2))) {
+    for (const auto& event : events) {
+      if (event.state != State::stopped) {
+        progressBar->setValue(event.state);
+      }
+    }
+  }
+}
+
+void RunView::runWeatherFilesClicked() {
+  std::shared_ptr<OSDocument> osdocument = OSAppBase::instance()->currentDocument();
+
+  // the runs copy the saved model
+  if (osdocument->modified()) {
+    osdocument->save();
+    // save dialog was canceled
+    if (osdocument->modified()) {
+      return;
+    }
+  }
+
+  auto workflowPath = toPath(osdocument->modelTempDir()) / toPath("resources") / toPath("workflow.osw");
+  OS_ASSERT(exists(workflowPath));
+
+  QStringList weatherFiles = QFileDialog::getOpenFileNames(this, tr("Select Weather Files"), QDir::homePath(), tr("EPW (*.epw)"));
+
+  for (const auto& weatherFile : weatherFiles) {
+    openstudio::path weatherPath = toPath(weatherFile);
+    QString name = toQString(weatherPath.stem());
+
+    // runs are kept out of resources, they are not saved with the model
+    openstudio::path directory =
+      toPath(osdocument->modelTempDir()) / toPath("runs") / toPath(QString::number(++m_variantCount) + "_" + name);
+    boost::optional<openstudio::path> variantWorkflowPath = RunQueue::prepareWorkflow(workflowPath, directory, weatherPath);
+    if (!variantWorkflowPath) {
+      QMessageBox::warning(this, "Run Weather Files", "Could not prepare a run for " + weatherFile + ".");
       continue;
-    } else if (QString::compare(trimmedLine, "Starting state initialization", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Initializing workflow.");
-      m_state = State::initialization;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Started", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Returned from state initialization", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state os_measures", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Processing OpenStudio Measures.");
-      m_state = State::os_measures;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state os_measures", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state translator", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Translating the OpenStudio Model to EnergyPlus.");
-      m_state = State::translator;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state translator", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state ep_measures", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Processing EnergyPlus Measures.");
-      m_state = State::ep_measures;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state ep_measures", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state preprocess", Qt::CaseInsensitive) == 0) {
-      // ignore this state
-      m_state = State::preprocess;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state preprocess", Qt::CaseInsensitive) == 0) {
-      // ignore this state
-    } else if (QString::compare(trimmedLine, "Starting state simulation", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Starting Simulation.");
-      m_state = State::simulation;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state simulation", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state reporting_measures", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Processing Reporting Measures.");
-      m_state = State::reporting_measures;
-      m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state reporting_measures", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Starting state postprocess", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Gathering Reports.");
-      m_state = State::postprocess;
+    }
+
+    auto item = new QTreeWidgetItem(m_jobsView);
+    item->setText(0, name);
+    item->setToolTip(0, weatherFile);
+    auto progressBar = new QProgressBar();
+    progressBar->setMaximum(State::complete);
+    progressBar->setValue(0);
+    m_jobsView->setItemWidget(item, 2, progressBar);
+
+    // the job may start right away, its item catches up with its status once registered
+    int id = m_runQueue->addJob(name, *variantWorkflowPath);
+    m_jobItems[id] = item;
+    item->setData(0, Qt::UserRole, id);
+    onJobStatusChanged(id, m_runQueue->status(id));
+  }
+}
+
+void RunView::cancelJobsClicked() {
+  QList<QTreeWidgetItem*> items = m_jobsView->selectedItems();
+  if (items.isEmpty()) {
+    for (const auto& jobItem : m_jobItems) {
+      m_runQueue->cancel(jobItem.first);
+    }
+  } else {
+    for (const auto& item : items) {
+      m_runQueue->cancel(item->data(0, Qt::UserRole).toInt());
+    }
+  }
+}
+
+void RunView::onMaxJobsChanged(int maxJobs) {
+  m_runQueue->setMaxJobs(maxJobs);
+
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.setValue("runQueueMaxJobs", maxJobs);
+}
+
+void RunView::onJobDoubleClicked(QTreeWidgetItem* item, int column) {
+  int id = item->data(0, Qt::UserRole).toInt();
+  QDesktopServices::openUrl(QUrl::fromLocalFile(toQString(m_runQueue->jobDirectory(id) / toPath("run"))));
+}
+
+void RunView::processRunEvents(const std::vector<RunProgressParser::Event>& events) {
+  for (const auto& event : events) {
+    if (event.state != State::stopped) {
+      m_state = event.state;
       m_progressBar->setValue(m_state);
-    } else if (QString::compare(trimmedLine, "Returned from state postprocess", Qt::CaseInsensitive) == 0) {
-      // no-op
-    } else if (QString::compare(trimmedLine, "Failure", Qt::CaseInsensitive) == 0) {
-      appendErrorText("Failed.");
-    } else if (QString::compare(trimmedLine, "Complete", Qt::CaseInsensitive) == 0) {
-      appendH1Text("Completed.");
-    } else if (trimmedLine.startsWith("Applying", Qt::CaseInsensitive)) {
-      appendH2Text(line);
-    } else if (trimmedLine.startsWith("Applied", Qt::CaseInsensitive)) {
-      // no-op
-    } else {
-      appendNormalText(line);
     }
+    if (!event.text.isEmpty()) {
+      m_pendingLog.push_back(event);
+      if (m_pendingLog.size() > static_cast<size_t>(MAXRUNLOGLINES)) {
+        m_pendingLog.pop_front();
+      }
+    }
+  }
+
+  if (!m_pendingLog.empty() && !m_logFlushTimer->isActive()) {
+    m_logFlushTimer->start();
+  }
+}
+
+void RunView::flushLog() {
+  m_logFlushTimer->stop();
+  if (m_pendingLog.empty()) {
+    return;
+  }
+
+  QScrollBar* scrollBar = m_textInfo->verticalScrollBar();
+  bool atBottom = (scrollBar->value() == scrollBar->maximum());
+
+  QTextCursor cursor(m_textInfo->document());
+  cursor.movePosition(QTextCursor::End);
+  cursor.beginEditBlock();
+  for (const auto& event : m_pendingLog) {
+    QTextCharFormat format;
+    format.setForeground(Qt::black);
+    switch (event.style) {
+      case RunProgressParser::Style::Normal:
+        format.setFontPointSize(12);
+        break;
+      case RunProgressParser::Style::Heading:
+        format.setFontPointSize(18);
+        break;
+      case RunProgressParser::Style::Subheading:
+        format.setFontPointSize(15);
+        break;
+      case RunProgressParser::Style::Error:
+        format.setForeground(Qt::red);
+        format.setFontPointSize(18);
+        break;
+    }
+
+    if (!m_textInfo->document()->isEmpty()) {
+      cursor.insertBlock();
+    }
+    cursor.insertText(event.text, format);
+  }
+  cursor.endEditBlock();
+  m_pendingLog.clear();
+
+  // follow the output unless the user scrolled up to read something
+  if (atBottom) {
+    scrollBar->setValue(scrollBar->maximum());
   }
 }
 
@@ -34,9 +34,12 @@
 #include <openstudio/utilities/idf/WorkspaceObject_Impl.hpp>
 #include <boost/smart_ptr.hpp>
 #include "MainTabView.hpp"
+#include "RunQueue.hpp"
 #include <QComboBox>
 #include <QWidget>
 #include <QProcess>
+#include <deque>
+#include <map>
 //#include "../runmanager/lib/ConfigOptions.hpp"
 //#include "../runmanager/lib/RunManager.hpp"
 //#include "../runmanager/lib/Workflow.hpp"
@@ -48,9 +51,12 @@ class QPushButton;
 class QRadioButton;
 class QStackedWidget;
 class QToolButton;
+class QSpinBox;
 class QTextEdit;
+class QTimer;
+class QTreeWidget;
+class QTreeWidgetItem;
 class QFileSystemWatcher;
-class QTcpServer;
 class QTcpSocket;
 
 namespace openstudio {
@@ -69,7 +75,8 @@ class RunView : public QWidget
 
   void playButtonClicked(bool t_checked);
 
-  void onRunProcessFinished(int exitCode, QProcess::ExitStatus status);
+  // The run of the current model is done, whatever the outcome
+  void onRunFinished();
 
   //void onSimDirChanged(const QString &path);
 
@@ -77,34 +84,50 @@ class RunView : public QWidget
 
   void onOpenSimDirClicked();
 
-  void onNewConnection();
+  void onJobStatusChanged(int id, RunQueue::JobStatus status);
 
-  void onRunDataReady();
+  void onJobEvents(int id, const std::vector<RunProgressParser::Event>& events);
+
+  // Queue a run of the current model per weather file, in their own directories
+  void runWeatherFilesClicked();
+
+  // Cancel the selected weather file runs, all of them if none is selected
+  void cancelJobsClicked();
+
+  void onMaxJobsChanged(int maxJobs);
+
+  void onJobDoubleClicked(QTreeWidgetItem* item, int column);
+
+  void processRunEvents(const std::vector<RunProgressParser::Event>& events);
+
+  // Write the queued log lines to m_textInfo in one go
+  void flushLog();
+
+  using State = RunProgressParser::State;
 
   QToolButton* m_playButton;
   QProgressBar* m_progressBar;
   QLabel* m_statusLabel;
-  QTextEdit* m_textInfo;
-  QProcess* m_runProcess;
+  QPlainTextEdit* m_textInfo;
   QPushButton* m_openSimDirButton;
-  QTcpServer* m_runTcpServer;
-  QTcpSocket* m_runSocket;
+  QPushButton* m_runWeatherFilesButton;
+  QPushButton* m_cancelJobsButton;
+  QSpinBox* m_maxJobsSpinBox;
+  QTreeWidget* m_jobsView;
+  RunQueue* m_runQueue;
   //QFileSystemWatcher * m_simDirWatcher;
   //QFileSystemWatcher * m_eperrWatcher;
 
-  enum State
-  {
-    stopped = 0,
-    initialization = 1,
-    os_measures = 2,
-    translator = 3,
-    ep_measures = 4,
-    preprocess = 5,
-    simulation = 6,
-    reporting_measures = 7,
-    postprocess = 8,
-    complete = 9
-  };
+  // job running the current model in the model's resources directory, -1 if not running
+  int m_mainJobId = -1;
+  // weather file runs, by job id
+  std::map<int, QTreeWidgetItem*> m_jobItems;
+  int m_variantCount = 0;
+
+  // lines waiting for the next flush, bounded like m_textInfo
+  std::deque<RunProgressParser::Event> m_pendingLog;
+  QTimer* m_logFlushTimer;
+
   State m_state = State::stopped;
 };
 
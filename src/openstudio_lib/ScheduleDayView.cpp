@@ -50,7 +50,6 @@
 #include <openstudio/utilities/units/QuantityConverter.hpp>
 #include <openstudio/utilities/units/Quantity.hpp>
 #include <openstudio/utilities/units/OSOptionalQuantity.hpp>
-#include <openstudio/utilities/units/OSQuantityVector.hpp>
 
 #include <openstudio/utilities/core/Assert.hpp>
 
@@ -77,6 +76,7 @@
 #include <QVBoxLayout>
 #include <algorithm>
 #include <iterator>
+#include <map>
 
 #include <openstudio/utilities/idd/IddEnums.hxx>
 
@@ -93,6 +93,43 @@ static const double SCENEHEIGHT = 86400;
 static const double LINEWIDTH = 3000;
 static const double PENWIDTH = 500;
 
+// Conversion of schedule values from SI to the displayed units, conversions between OpenStudio units are affine
+struct ValueConversion
+{
+  double scale;
+  double offset;
+};
+
+// Derived once per unit type by converting two values, instead of converting every value of every refresh as a Quantity
+static boost::optional<ValueConversion> valueConversion(const model::ScheduleTypeLimits& scheduleTypeLimits, bool isIP) {
+  if (!isIP) {
+    return boost::none;
+  }
+
+  static std::map<std::string, boost::optional<ValueConversion>> conversions;
+
+  const std::string unitType = scheduleTypeLimits.unitType();
+  auto it = conversions.find(unitType);
+  if (it != conversions.end()) {
+    return it->second;
+  }
+
+  boost::optional<ValueConversion> result;
+
+  boost::optional<Unit> _siUnits = scheduleTypeLimits.units(false);
+  boost::optional<Unit> _toUnits = scheduleTypeLimits.units(true);
+  if (_siUnits && _toUnits && (_siUnits.get() != _toUnits.get())) {
+    OptionalQuantity zero = openstudio::convert(openstudio::Quantity(0.0, _siUnits.get()), _toUnits.get());
+    OptionalQuantity one = openstudio::convert(openstudio::Quantity(1.0, _siUnits.get()), _toUnits.get());
+    OS_ASSERT(zero);
+    OS_ASSERT(one);
+    result = ValueConversion{one->value() - zero->value(), zero->value()};
+  }
+
+  conversions[unitType] = result;
+  return result;
+}
+
 ScheduleDayView::ScheduleDayView(bool isIP, const model::ScheduleDay& scheduleDay, SchedulesView* schedulesView)
   : QWidget(schedulesView),
     m_focusStartTime(0.0),
@@ -972,13 +1009,9 @@ void CalendarSegmentItem::setValue(double value) {
 
   QString tooltip = QString::number(fullscalevalue, 'g', 3);
 
-  boost::optional<Unit> units = scene()->scheduleDayView()->units();
-  if (units) {
-    if (!units->standardString().empty()) {
-      std::stringstream ss;
-      ss << " (" << units->standardString() << ")";
-      tooltip.append(toQString(ss.str()));
-    }
+  QString units = scene()->unitsString();
+  if (!units.isEmpty()) {
+    tooltip.append(" (" + units + ")");
   }
 
   tooltip.append(" - Double click to cut segment");
@@ -1749,8 +1782,6 @@ void DayScheduleScene::scheduleRefresh() {
 
 void DayScheduleScene::refresh() {
   if (m_dirty) {
-    clearSegments();
-
     std::vector<openstudio::Time> times = m_scheduleDay.times();
 
     // Get the values as is
@@ -1758,26 +1789,29 @@ void DayScheduleScene::refresh() {
 
     // Now, if we need and can convert, we do it
     if (boost::optional<model::ScheduleTypeLimits> _scheduleTypeLimits = m_scheduleDay.scheduleTypeLimits()) {
+      if (boost::optional<ValueConversion> conversion = valueConversion(*_scheduleTypeLimits, m_scheduleDayView->schedulesView()->isIP())) {
+        std::transform(realvalues.begin(), realvalues.end(), realvalues.begin(),
+                       [&conversion](double value) { return conversion->scale * value + conversion->offset; });
+      }
+    }
 
-      // Get as SI units for potential conversion
-      boost::optional<Unit> _siUnits = _scheduleTypeLimits->units(false);
-
-      bool isIP = m_scheduleDayView->schedulesView()->isIP();
-      // Get as target units (depends on m_isIP)
-      boost::optional<Unit> _toUnits = _scheduleTypeLimits->units(isIP);
-
-      if (isIP && (_siUnits.get() != _toUnits.get())) {
-        OSQuantityVector quantities(_toUnits.get());
-        for (const auto& value : m_scheduleDay.values()) {
-          // Do conversion:
-          Quantity q = openstudio::Quantity(value, _siUnits.get());
-          OptionalQuantity result = openstudio::convert(q, _toUnits.get());
-          OS_ASSERT(result);
-          quantities.push_back(result.get());
-        }
+    // Shown in the tooltip of every segment
+    m_unitsString.clear();
+    if (boost::optional<Unit> units = m_scheduleDayView->units()) {
+      m_unitsString = toQString(units->standardString());
+    }
 
-        realvalues = quantities.values();
-      }
+    // When only values changed, as while dragging a segment, the segment items are moved rather than rebuilt
+    std::vector<CalendarSegmentItem*> existingSegments = segments();
+    bool sameTimes = (existingSegments.size() == times.size());
+    for (unsigned i = 0; sameTimes && i < times.size(); ++i) {
+      sameTimes = (existingSegments[i]->endTime() == times[i].totalSeconds());
+    }
+
+    if (sameTimes) {
+      clearTypeLimitItems();
+    } else {
+      clearSegments();
     }
 
     // The upper and lower type limits come from the model ScheduleTypeLimits.
@@ -1823,6 +1857,29 @@ void DayScheduleScene::refresh() {
       }
     }
 
+    if (sameTimes) {
+      for (unsigned i = 0; i < existingSegments.size(); ++i) {
+        CalendarSegmentItem* segment = existingSegments[i];
+        bool isOutOfTypeLimits = (upperTypeLimit && (realvalues[i] > *upperTypeLimit)) || (lowerTypeLimit && (realvalues[i] < *lowerTypeLimit));
+        segment->setValue((realvalues[i] - lowerViewLimit) / (upperViewLimit - lowerViewLimit));
+        segment->setIsOutOfTypeLimits(isOutOfTypeLimits);
+        segment->update();
+      }
+
+      // once both of their segments moved
+      for (CalendarSegmentItem* segment : existingSegments) {
+        if (VCalendarSegmentItem* vSegment = segment->previousVCalendarItem()) {
+          vSegment->updateLength();
+        }
+      }
+
+      m_scheduleDayView->update();
+
+      m_dirty = false;
+
+      return;
+    }
+
     int i = 0;
     double lastTime = 0.0;
     CalendarSegmentItem* previousSegment = nullptr;
@@ -1878,6 +1935,10 @@ ScheduleDayView* DayScheduleScene::scheduleDayView() const {
   return m_scheduleDayView;
 }
 
+QString DayScheduleScene::unitsString() const {
+  return m_unitsString;
+}
+
 CalendarSegmentItem* DayScheduleScene::segmentAt(double time) const {
   CalendarSegmentItem* segment = m_firstSegment;
 
@@ -1965,6 +2026,10 @@ void DayScheduleScene::clearSegments() {
 
   m_firstSegment = nullptr;
 
+  clearTypeLimitItems();
+}
+
+void DayScheduleScene::clearTypeLimitItems() {
   if (m_upperScheduleTypeLimitItem) {
     delete m_upperScheduleTypeLimitItem;
   }
@@ -303,6 +303,9 @@ class DayScheduleScene : public QGraphicsScene, public Nano::Observer
 
   model::ScheduleDay scheduleDay() const;
 
+  // units of the displayed values, as of the last refresh
+  QString unitsString() const;
+
   void addSegment(double untilTime, double value);
 
   CalendarSegmentItem* addSegment(double untilTime);
@@ -330,6 +333,8 @@ class DayScheduleScene : public QGraphicsScene, public Nano::Observer
   void refresh();
 
  private:
+  void clearTypeLimitItems();
+
   CalendarSegmentItem* m_firstSegment;
 
   ScheduleTypeLimitItem* m_upperScheduleTypeLimitItem;
@@ -340,6 +345,8 @@ class DayScheduleScene : public QGraphicsScene, public Nano::Observer
 
   model::ScheduleDay m_scheduleDay;
 
+  QString m_unitsString;
+
   bool m_dirty;
 };
 
@@ -118,6 +118,7 @@ SpacesDaylightingGridView::SpacesDaylightingGridView(bool isIP, const model::Mod
 
   m_gridController = new SpacesDaylightingGridController(isIP, "Space", IddObjectType::OS_Space, model, m_spacesModelObjects);
   m_gridView = new OSGridView(m_gridController, "Space", "Drop\nSpace", false, parent);
+  m_gridView->setVirtualized(true);
 
   setGridController(m_gridController);
   setGridView(m_gridView);
@@ -88,6 +88,7 @@ SpacesInteriorPartitionsGridView::SpacesInteriorPartitionsGridView(bool isIP, co
 
   m_gridController = new SpacesInteriorPartitionsGridController(isIP, "Space", IddObjectType::OS_Space, model, m_spacesModelObjects);
   m_gridView = new OSGridView(m_gridController, "Space", "Drop\nSpace", false, parent);
+  m_gridView->setVirtualized(true);
 
   setGridController(m_gridController);
   setGridView(m_gridView);
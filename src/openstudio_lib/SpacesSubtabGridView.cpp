@@ -130,9 +130,12 @@ struct ModelObjectNameSorter
   }
 };
 
-SpacesSubtabGridView::SpacesSubtabGridView(bool isIP, const model::Model& model, QWidget* parent) : GridViewSubTab(isIP, model, parent) {
+SpacesSubtabGridView::SpacesSubtabGridView(bool isIP, const model::Model& model, QWidget* parent)
+  : GridViewSubTab(isIP, model, parent), m_filterIndex(model) {
   m_spacesModelObjects = subsetCastVector<model::ModelObject>(model.getConcreteModelObjects<model::Space>());
 
+  initializeFilterIndex();
+
   // Filters
 
   QLabel* label = nullptr;
@@ -229,9 +232,9 @@ void SpacesSubtabGridView::showSpaceNameFilter() {
 
   m_spaceNameFilter = new QLineEdit();
   m_spaceNameFilter->setFixedWidth(OSItem::ITEM_WIDTH);
-  connect(m_spaceNameFilter, &QLineEdit::editingFinished, this, &openstudio::SpacesSubtabGridView::spaceNameFilterChanged);
-  // Evan note: there are issues with using the signal below (as well as textChanged), related to the design and updating of the gridview (loss of focus, and updates per key stroke)
-  //connect(m_spaceNameFilter, &QLineEdit::textEdited, this, &openstudio::SpacesSubtabGridView::spaceNameFilterChanged);
+  // Filtered as you type: the names are indexed once per grid load and a key stroke only shows or hides the rows whose
+  // match changed, the grid isn't refreshed
+  connect(m_spaceNameFilter, &QLineEdit::textEdited, this, &openstudio::SpacesSubtabGridView::spaceNameFilterChanged);
 
   layout->addWidget(m_spaceNameFilter, Qt::AlignTop | Qt::AlignLeft);
   layout->addStretch();
@@ -520,136 +523,26 @@ void SpacesSubtabGridView::initializeInteriorPartitionGroupFilter() {
 }
 
 void SpacesSubtabGridView::storyFilterChanged(const QString& text) {
-  m_objectsFilteredByStory.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else if (text == UNASSIGNED) {
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      if (obj.cast<model::Space>().buildingStory()) {
-        m_objectsFilteredByStory.insert(obj);
-      }
-    }
-  } else {
-    // OSGridController::m_modelObjects returns the Spaces
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      auto buildingStory = obj.cast<model::Space>().buildingStory();
-      if (!buildingStory || !buildingStory->name() || (buildingStory && buildingStory->name() && buildingStory->name().get().c_str() != text)) {
-        m_objectsFilteredByStory.insert(obj);
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(STORY, text, true);
 }
 
 void SpacesSubtabGridView::thermalZoneFilterChanged(const QString& text) {
-  m_objectsFilteredByThermalZone.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else if (text == UNASSIGNED) {
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      if (obj.cast<model::Space>().thermalZone()) {
-        m_objectsFilteredByThermalZone.insert(obj);
-      }
-    }
-  } else {
-    // OSGridController::m_modelObjects returns the Spaces
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      auto thermalZone = obj.cast<model::Space>().thermalZone();
-      if (!thermalZone || !thermalZone->name() || (thermalZone && thermalZone->name() && thermalZone->name().get().c_str() != text)) {
-        m_objectsFilteredByThermalZone.insert(obj);
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(THERMALZONE, text, true);
 }
 
 void SpacesSubtabGridView::spaceTypeFilterChanged(const QString& text) {
-  m_objectsFilteredBySpaceType.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else if (text == UNASSIGNED) {
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      if (obj.cast<model::Space>().spaceType()) {
-        m_objectsFilteredBySpaceType.insert(obj);
-      }
-    }
-  } else {
-    // OSGridController::m_modelObjects returns the Spaces
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      // LOG(Debug, "spaceTypeFilterChanged, obj=" << obj.briefDescription());
-      auto spaceType = obj.cast<model::Space>().spaceType();
-      if (!spaceType || !spaceType->name() || (spaceType && spaceType->name() && spaceType->name().get().c_str() != text)) {
-        m_objectsFilteredBySpaceType.insert(obj);
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(SPACETYPE, text, true);
 }
 
 void SpacesSubtabGridView::subSurfaceTypeFilterChanged(const QString& text) {
-  m_objectsFilteredBySubSurfaceType.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else {
-
-    // It's possible that "fixedwindow" might be returned when querying later, instead of "FixedWindow" returned
-    // by SubSurface::validSubSurfaceTypes(), so we'll do a case-insensitive string comparison later
-    std::string subSurfaceTypeToKeep = openstudio::toString(text);
-
-    // ObjectSelector::m_selectorObjects returns SubSurfaces directly
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      // LOG(Debug, "subSurfaceTypeFilterChanged, obj=" << obj.briefDescription());
-      auto subsurface = obj.optionalCast<model::SubSurface>();
-      if (subsurface) {
-        auto subsurfaceType = subsurface->subSurfaceType();
-        // Case insensitive
-        if (!openstudio::istringEqual(subsurfaceType, subSurfaceTypeToKeep)) {
-          // LOG(Debug, "Adding obj=" << obj.briefDescription());
-          m_objectsFilteredBySubSurfaceType.insert(obj);
-        }
-      }
-    }
-
-    // Alternatively, we could have done this:
-    //for (auto obj : this->m_gridController->m_modelObjects) {
-    //LOG(Debug, "subSurfaceTypeFilterChanged, obj=" << obj.briefDescription());
-    //auto surfaces = obj.cast<model::Space>().surfaces();
-    //for (auto surface : surfaces) {
-    //auto subsurfaces = surface.subSurfaces();
-    //for (auto subsurface : subsurfaces) {
-    //auto subsurfaceType = subsurface.subSurfaceType();
-    //if (!openstudio::istringEqual(subsurfaceType, subSurfaceTypeToKeep)) {
-    //LOG(Debug, "Adding obj=" << obj.briefDescription());
-    //m_objectsFilteredBySubSurfaceType.insert(obj);
-    //}
-    //}
-    //}
-    //}
-  }
-
-  filterChanged();
+  // It's possible that "fixedwindow" might be returned when querying, instead of "FixedWindow" returned
+  // by SubSurface::validSubSurfaceTypes(), so the filter is case-insensitive
+  selectFilterValue(SUBSURFACETYPE, text, false);
 }
 
 void SpacesSubtabGridView::spaceNameFilterChanged() {
-  m_objectsFilteredBySpaceName.clear();
-
-  if (m_spaceNameFilter->text().isEmpty()) {
-    // nothing to filter
-  } else {
-    for (auto obj : this->m_gridController->m_modelObjects) {
-      QString objName(obj.name().get().c_str());
-      if (!objName.contains(m_spaceNameFilter->text(), Qt::CaseInsensitive)) {
-        m_objectsFilteredBySpaceName.insert(obj);
-      }
-    }
-  }
+  // An empty text shows all
+  filterIndex().showContaining(SPACENAME, openstudio::toString(m_spaceNameFilter->text()));
 
   filterChanged();
 }
@@ -701,212 +594,124 @@ void SpacesSubtabGridView::loadTypeFilterChanged(const QString& text) {
 }
 
 void SpacesSubtabGridView::windExposureFilterChanged(const QString& text) {
-  m_objectsFilteredByWindExposure.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else {
-    // For a case-insensitive comparison later
-    std::string windExposureToKeep = openstudio::toString(text);
-
-    // ObjectSelector::m_selectorObjects returns Surfaces directly
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      // LOG(Debug, "windExposureFilterChanged, obj=" << obj.briefDescription());
-      auto surface = obj.optionalCast<model::Surface>();
-      if (surface) {
-        auto windExposure = surface->windExposure();
-        if (windExposure.empty() || !openstudio::istringEqual(windExposure, windExposureToKeep)) {
-          m_objectsFilteredByWindExposure.insert(obj);
-        }
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(WINDEXPOSURE, text, false);
 }
 
 void SpacesSubtabGridView::sunExposureFilterChanged(const QString& text) {
-  m_objectsFilteredBySunExposure.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else {
-    // For a case-insensitive comparison later
-    std::string sunExposureToKeep = openstudio::toString(text);
-
-    // ObjectSelector::m_selectorObjects returns Surfaces directly
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      // LOG(Debug, "sunExposureFilterChanged, obj=" << obj.briefDescription());
-      auto surface = obj.optionalCast<model::Surface>();
-      if (surface) {
-        auto sunExposure = surface->sunExposure();
-        if (sunExposure.empty() || !openstudio::istringEqual(sunExposure, sunExposureToKeep)) {
-          m_objectsFilteredBySunExposure.insert(obj);
-        }
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(SUNEXPOSURE, text, false);
 }
 
 void SpacesSubtabGridView::outsideBoundaryConditionFilterChanged(const QString& text) {
-  m_objectsFilteredByOutsideBoundaryCondition.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else {
-    // For a case-insensitive comparison later
-    std::string outsideBoundCondToKeep = openstudio::toString(text);
-
-    // ObjectSelector::m_selectorObjects returns either Surfaces or SubSurfaces directly, depending on the subtab it's on
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      // LOG(Debug, "outsideBoundaryConditionFilterChanged, obj=" << obj.briefDescription());
-      std::string outsideBoundaryCondition;
-      if (auto surface = obj.optionalCast<model::Surface>()) {
-        outsideBoundaryCondition = surface->outsideBoundaryCondition();
-      } else if (auto subSurface = obj.optionalCast<model::SubSurface>()) {
-        outsideBoundaryCondition = subSurface->outsideBoundaryCondition();
-      }
-      if (outsideBoundaryCondition.empty() || !openstudio::istringEqual(outsideBoundaryCondition, outsideBoundCondToKeep)) {
-        m_objectsFilteredByOutsideBoundaryCondition.insert(obj);
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(OUTSIDEBOUNDARYCONDITION, text, false);
 }
 
 void SpacesSubtabGridView::surfaceTypeFilterChanged(const QString& text) {
-  m_objectsFilteredBySurfaceType.clear();
-
-  if (text == ALL) {
-    // nothing to filter
-  } else {
-    // For a case-insensitive comparison later
-    std::string surfaceTypeToKeep = openstudio::toString(text);
-
-    // ObjectSelector::m_selectorObjects Surfaces directly
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      // LOG(Debug, "surfaceTypeFilterChanged, obj=" << obj.briefDescription());
-      auto surface = obj.optionalCast<model::Surface>();
-      if (surface) {
-        auto surfaceType = surface->surfaceType();
-        if (!openstudio::istringEqual(surfaceType, surfaceTypeToKeep)) {
-          m_objectsFilteredBySurfaceType.insert(obj);
-        }
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(SURFACETYPE, text, false);
 }
 
 void SpacesSubtabGridView::interiorPartitionGroupFilterChanged(const QString& text) {
-  m_objectsFilteredByInteriorPartitionGroup.clear();
-
-  if (m_interiorPartitionGroupFilter->currentText() == ALL) {
-    // nothing to filter
-  } else {
-    for (auto obj : this->m_gridController->getObjectSelector()->m_selectorObjects) {
-      auto interiorPartitionSurfaceGroup = obj.optionalCast<model::InteriorPartitionSurfaceGroup>();
-      if (interiorPartitionSurfaceGroup) {
-        if (!interiorPartitionSurfaceGroup->name() ||
-            (interiorPartitionSurfaceGroup->name() && interiorPartitionSurfaceGroup->name().get().c_str() != text)) {
-          m_objectsFilteredByInteriorPartitionGroup.insert(obj);
-        }
-      }
-    }
-  }
-
-  filterChanged();
+  selectFilterValue(INTERIORPARTITIONGROUP, text, false);
 }
 
-void SpacesSubtabGridView::filterChanged() {
-  // Note: JM 2018-08-21
-  // The distinction between these two is especially needed for the "Loads" Subtab
-  // because it can't match SpaceLoadInstances to a Space if the load is inherited from a SpaceType rather than the space
+void SpacesSubtabGridView::initializeFilterIndex() {
+  using Level = GridFilterIndex::Level;
+
+  auto nonEmpty = [](const std::string& value) { return value.empty() ? boost::optional<std::string>() : boost::optional<std::string>(value); };
 
   /****************************************************************************
      * Filters that should apply at the ROW level because they are Space-related
+     * OSGridController::m_modelObjects returns the Spaces
      ***************************************************************************/
-  std::set<openstudio::model::ModelObject> spaceFilteredObjects = m_objectsFilteredByStory;
-
-  for (auto obj : m_objectsFilteredByThermalZone) {
-    if (spaceFilteredObjects.count(obj) == 0) {
-      spaceFilteredObjects.insert(obj);
+  m_filterIndex.addFilter(STORY, Level::Row, nullptr, [](const model::ModelObject& obj) {
+    if (auto buildingStory = obj.cast<model::Space>().buildingStory()) {
+      return buildingStory->name();
     }
-  }
+    return boost::optional<std::string>();
+  });
 
-  for (auto obj : m_objectsFilteredBySpaceType) {
-    if (spaceFilteredObjects.count(obj) == 0) {
-      spaceFilteredObjects.insert(obj);
+  m_filterIndex.addFilter(THERMALZONE, Level::Row, nullptr, [](const model::ModelObject& obj) {
+    if (auto thermalZone = obj.cast<model::Space>().thermalZone()) {
+      return thermalZone->name();
     }
-  }
+    return boost::optional<std::string>();
+  });
 
-  for (auto obj : m_objectsFilteredBySpaceName) {
-    if (spaceFilteredObjects.count(obj) == 0) {
-      spaceFilteredObjects.insert(obj);
+  m_filterIndex.addFilter(SPACETYPE, Level::Row, nullptr, [](const model::ModelObject& obj) {
+    if (auto spaceType = obj.cast<model::Space>().spaceType()) {
+      return spaceType->name();
     }
-  }
+    return boost::optional<std::string>();
+  });
+
+  m_filterIndex.addTextFilter(SPACENAME, Level::Row, nullptr, [](const model::ModelObject& obj) { return obj.name(); });
 
   /***********************************************************************************
      * Filters that should apply at the SUBROW level because they are DataObject-related
+     * ObjectSelector::m_selectorObjects returns the Surfaces, SubSurfaces... directly
      ***********************************************************************************/
-  std::set<openstudio::model::ModelObject> allFilteredObjects;
+  m_filterIndex.addFilter(
+    SUBSURFACETYPE, Level::SubRow, [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::SubSurface>()); },
+    [](const model::ModelObject& obj) { return boost::optional<std::string>(obj.cast<model::SubSurface>().subSurfaceType()); }, false);
+
+  m_filterIndex.addFilter(
+    WINDEXPOSURE, Level::SubRow, [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::Surface>()); },
+    [nonEmpty](const model::ModelObject& obj) { return nonEmpty(obj.cast<model::Surface>().windExposure()); }, false);
+
+  m_filterIndex.addFilter(
+    SUNEXPOSURE, Level::SubRow, [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::Surface>()); },
+    [nonEmpty](const model::ModelObject& obj) { return nonEmpty(obj.cast<model::Surface>().sunExposure()); }, false);
+
+  // Either Surfaces or SubSurfaces, depending on the subtab it's on
+  m_filterIndex.addFilter(
+    OUTSIDEBOUNDARYCONDITION, Level::SubRow, nullptr,
+    [nonEmpty](const model::ModelObject& obj) {
+      if (auto surface = obj.optionalCast<model::Surface>()) {
+        return nonEmpty(surface->outsideBoundaryCondition());
+      } else if (auto subSurface = obj.optionalCast<model::SubSurface>()) {
+        return nonEmpty(subSurface->outsideBoundaryCondition());
+      }
+      return boost::optional<std::string>();
+    },
+    false);
 
-  for (auto obj : m_objectsFilteredBySubSurfaceType) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
-  }
+  m_filterIndex.addFilter(
+    SURFACETYPE, Level::SubRow, [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::Surface>()); },
+    [](const model::ModelObject& obj) { return boost::optional<std::string>(obj.cast<model::Surface>().surfaceType()); }, false);
 
-  for (auto obj : m_objectsFilteredByWindExposure) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
-  }
+  m_filterIndex.addFilter(
+    INTERIORPARTITIONGROUP, Level::SubRow,
+    [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::InteriorPartitionSurfaceGroup>()); },
+    [](const model::ModelObject& obj) { return obj.name(); });
+}
 
-  for (auto obj : m_objectsFilteredBySunExposure) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
-  }
+GridFilterIndex& SpacesSubtabGridView::filterIndex() {
+  m_filterIndex.setObjects(this->m_gridController->m_modelObjects, this->m_gridController->getObjectSelector()->m_selectorObjects);
+  return m_filterIndex;
+}
 
-  for (auto obj : m_objectsFilteredByOutsideBoundaryCondition) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
-  }
+void SpacesSubtabGridView::selectFilterValue(const std::string& filter, const QString& text, bool hasUnassigned) {
+  auto& filterIndex = this->filterIndex();
 
-  for (auto obj : m_objectsFilteredBySurfaceType) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
+  if (text == ALL) {
+    // nothing to filter
+    filterIndex.showAll(filter);
+  } else if (hasUnassigned && text == UNASSIGNED) {
+    filterIndex.showUnassigned(filter);
+  } else {
+    filterIndex.showValue(filter, openstudio::toString(text));
   }
 
-  for (auto obj : m_objectsFilteredByInteriorPartitionGroup) {
-    if (allFilteredObjects.count(obj) == 0) {
-      allFilteredObjects.insert(obj);
-    }
-  }
+  filterChanged();
+}
 
-  if (this->hasSubRows()) {
-    // We do it in two steps, the row level stuff (=space related)
-    bool isRowLevel = true;
-    this->m_gridController->getObjectSelector()->m_filteredObjects = spaceFilteredObjects;
-    this->m_gridController->getObjectSelector()->updateWidgets(isRowLevel);
-    // The subrow level stuff, that could link to Space and/or Space Type
-    isRowLevel = false;
-    this->m_gridController->getObjectSelector()->m_filteredObjects = allFilteredObjects;
-    this->m_gridController->getObjectSelector()->updateWidgets(isRowLevel);
-  } else {
-    // One step
-    bool isRowLevel = false;
-    allFilteredObjects.insert(spaceFilteredObjects.begin(), spaceFilteredObjects.end());
-    this->m_gridController->getObjectSelector()->m_filteredObjects = allFilteredObjects;
-    this->m_gridController->getObjectSelector()->updateWidgets(isRowLevel);
-  }
+void SpacesSubtabGridView::filterChanged() {
+  // Note: JM 2018-08-21
+  // The distinction between the row and sub row filters is especially needed for the "Loads" Subtab
+  // because it can't match SpaceLoadInstances to a Space if the load is inherited from a SpaceType rather than the space
+  //
+  // With sub rows, the row level filters (=space related) hide whole rows and the sub row level ones the DataObjects,
+  // otherwise they all apply to the rows. Only the objects whose filtering changed are updated
+  m_filterIndex.apply(*this->m_gridController->getObjectSelector(), this->hasSubRows());
 }
 
 void SpacesSubtabGridView::addObject(const IddObjectType& iddObjectType) {
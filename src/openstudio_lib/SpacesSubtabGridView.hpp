@@ -30,6 +30,7 @@
 #ifndef OPENSTUDIO_SPACESSUBTABGRIDVIEW_HPP
 #define OPENSTUDIO_SPACESSUBTABGRIDVIEW_HPP
 
+#include "../shared_gui_components/GridFilterIndex.hpp"
 #include "../shared_gui_components/OSGridController.hpp"
 
 #include "GridViewSubTab.hpp"
@@ -126,29 +127,19 @@ class SpacesSubtabGridView : public GridViewSubTab
 
   void initializeInteriorPartitionGroupFilter();
 
-  void filterChanged();
-
-  // All these sets will store the objects that DO NEED to be hidden
-  // So if the set is empty -> show all
-  std::set<openstudio::model::ModelObject> m_objectsFilteredByStory;
-
-  std::set<openstudio::model::ModelObject> m_objectsFilteredByThermalZone;
-
-  std::set<openstudio::model::ModelObject> m_objectsFilteredBySpaceType;
+  // Register the filters of all the subtabs, each one is only indexed once it is used
+  void initializeFilterIndex();
 
-  std::set<openstudio::model::ModelObject> m_objectsFilteredBySubSurfaceType;
+  // The filter index, up to date with the rows and sub rows of the grid
+  GridFilterIndex& filterIndex();
 
-  std::set<openstudio::model::ModelObject> m_objectsFilteredBySpaceName;
+  // Select the value of a combo box filter, ALL shows everything
+  void selectFilterValue(const std::string& filter, const QString& text, bool hasUnassigned);
 
-  std::set<openstudio::model::ModelObject> m_objectsFilteredByWindExposure;
-
-  std::set<openstudio::model::ModelObject> m_objectsFilteredBySunExposure;
-
-  std::set<openstudio::model::ModelObject> m_objectsFilteredByOutsideBoundaryCondition;
-
-  std::set<openstudio::model::ModelObject> m_objectsFilteredBySurfaceType;
+  void filterChanged();
 
-  std::set<openstudio::model::ModelObject> m_objectsFilteredByInteriorPartitionGroup;
+  // The objects hidden by each filter, by filter label (STORY, THERMALZONE...)
+  GridFilterIndex m_filterIndex;
 
   QGridLayout* m_filterGridLayout = nullptr;
 
@@ -90,6 +90,7 @@ SpacesSurfacesGridView::SpacesSurfacesGridView(bool isIP, const model::Model& mo
 
   m_gridController = new SpacesSurfacesGridController(isIP, "Space", IddObjectType::OS_Space, model, m_spacesModelObjects);
   m_gridView = new OSGridView(m_gridController, "Space", "Drop\nSpace", false, parent);
+  m_gridView->setVirtualized(true);
 
   setGridController(m_gridController);
   setGridView(m_gridView);
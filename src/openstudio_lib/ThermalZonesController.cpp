@@ -29,6 +29,7 @@
 
 #include "ThermalZonesController.hpp"
 
+#include "ComponentLibrary.hpp"
 #include "OSAppBase.hpp"
 #include "OSDocument.hpp"
 #include "OSItemSelectorButtons.hpp"
@@ -154,7 +155,10 @@ void ThermalZonesController::addComponentToZone(model::ThermalZone& zone, Handle
   boost::optional<model::ZoneHVACComponent> libraryComp;
 
   model::Model library = OSAppBase::instance()->currentDocument()->componentLibrary();
-  libraryComp = library.getModelObject<model::ZoneHVACComponent>(h);
+  // The library holding it may not be loaded yet
+  if (boost::optional<model::ModelObject> libraryObject = ComponentLibrary::getModelObject(library, h)) {
+    libraryComp = libraryObject->optionalCast<model::ZoneHVACComponent>();
+  }
 
   if (libraryComp) {
     std::vector<model::ModelObject> existingComps;
@@ -34,6 +34,7 @@
 #include <openstudio/model/ModelObject_Impl.hpp>
 #include <openstudio/model/OutputVariable_Impl.hpp>
 
+#include "../model_editor/ModelChangeBus.hpp"
 #include "../model_editor/Utilities.hpp"
 
 #include <openstudio/utilities/sql/SqlFileEnums.hpp>
@@ -41,15 +42,20 @@
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
-#include <QScrollArea>
+#include <QListWidget>
 #include <QComboBox>
 #include <QPushButton>
+#include <QScrollBar>
 #include <QTimer>
 
 #include "../shared_gui_components/OSSwitch.hpp"
 #include "../shared_gui_components/OSComboBox.hpp"
 
 #include <openstudio/utilities/idd/IddEnums.hxx>
+#include <openstudio/utilities/core/Assert.hpp>
+
+#include <algorithm>
+#include <iterator>
 
 namespace openstudio {
 
@@ -86,19 +92,7 @@ VariableListItem::VariableListItem(const std::string& t_name, const std::string&
   onOffClicked(m_variable.is_initialized());
 }
 
-VariablesList::~VariablesList() {
-
-  for (auto itr = m_variables.begin(); itr != m_variables.end(); ++itr) {
-    //(*itr)->setParent(0);
-    //(*itr)->setStyleSheet("");
-    m_listLayout->removeWidget(*itr);
-    delete (*itr);
-  }
-
-  delete m_allOnBtn;
-  delete m_allOffBtn;
-  delete m_listLayout;
-}
+VariablesList::~VariablesList() {}
 
 void VariableListItem::indexChanged(const QString& t_frequency) {
   if (m_variable) {
@@ -106,6 +100,10 @@ void VariableListItem::indexChanged(const QString& t_frequency) {
   }
 }
 
+boost::optional<openstudio::model::OutputVariable> VariableListItem::variable() const {
+  return m_variable;
+}
+
 void VariableListItem::setVariableEnabled(bool t_enabled) {
   m_onOffButton->setChecked(t_enabled);
   onOffClicked(t_enabled);
@@ -137,10 +135,12 @@ void VariableListItem::onOffClicked(bool t_on) {
   }
 }
 
-VariablesList::VariablesList(openstudio::model::Model t_model) : m_model(t_model), m_dirty(true) {
-  t_model.getImpl<openstudio::model::detail::Model_Impl>().get()->addWorkspaceObject.connect<VariablesList, &VariablesList::onAdded>(this);
+VariablesList::VariablesList(openstudio::model::Model t_model)
+  : m_model(t_model), m_modelChangeBus(ModelChangeBus::get(t_model)), m_rowHeight(0), m_visibleItemsDirty(false) {
+  // The objects added before this point are counted by buildVariableList, not by the next batch
+  m_modelChangeBus->flush();
+  connect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &VariablesList::onModelChanges);
 
-  t_model.getImpl<openstudio::model::detail::Model_Impl>().get()->removeWorkspaceObject.connect<VariablesList, &VariablesList::onRemoved>(this);
   auto vbox = new QVBoxLayout();
   vbox->setContentsMargins(10, 10, 10, 10);
   vbox->setSpacing(10);
@@ -166,10 +166,21 @@ VariablesList::VariablesList(openstudio::model::Model t_model) : m_model(t_model
 
   vbox->addLayout(outerbox);
 
-  m_listLayout = new QVBoxLayout();
-  vbox->addLayout(m_listLayout);
-
-  updateVariableList();
+  m_listWidget = new QListWidget();
+  m_listWidget->setUniformItemSizes(true);
+  m_listWidget->setSelectionMode(QAbstractItemView::NoSelection);
+  m_listWidget->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+  m_listWidget->setFrameShape(QFrame::NoFrame);
+  m_listWidget->setStyleSheet("QListWidget { background: transparent; } QListWidget::item { border-top: 1px solid #C3C3C3; }");
+  connect(m_listWidget->verticalScrollBar(), &QScrollBar::valueChanged, this, &VariablesList::scheduleUpdateVisibleItems);
+  connect(m_listWidget->verticalScrollBar(), &QScrollBar::rangeChanged, this, &VariablesList::scheduleUpdateVisibleItems);
+  vbox->addWidget(m_listWidget, 1);
+
+  // all rows look the same, measure one
+  VariableListItem sample("", "*", boost::none, m_model);
+  m_rowHeight = sample.sizeHint().height();
+
+  buildVariableList();
 }
 
 void VariablesList::allOnClicked() {
@@ -181,64 +192,54 @@ void VariablesList::allOffClicked() {
 }
 
 void VariablesList::enableAll(bool t_enabled) {
-  for (std::vector<VariableListItem*>::const_iterator itr = m_variables.begin(); itr != m_variables.end(); ++itr) {
-    (*itr)->setVariableEnabled(t_enabled);
+  for (auto& [variableNameKeyValue, row] : m_rows) {
+    if (row.widget) {
+      row.widget->setVariableEnabled(t_enabled);
+      row.variable = row.widget->variable();
+    } else if (t_enabled && !row.variable) {
+      // same as VariableListItem::onOffClicked
+      openstudio::model::OutputVariable outputVariable(row.name, m_model);
+      outputVariable.setReportingFrequency("Hourly");
+      outputVariable.setKeyValue(row.keyValue);
+      row.variable = outputVariable;
+    } else if (!t_enabled && row.variable) {
+      row.variable->remove();
+      row.variable = boost::none;
+    }
   }
 }
 
-void VariablesList::onAdded(const WorkspaceObject&, const openstudio::IddObjectType& type, const openstudio::UUID&) {
-  LOG(Debug, "onAdded: " << type.valueName());
-
-  /// \todo if the user is able to add an output variable through some other means it will not show up here and now
-  if (type != openstudio::IddObjectType::OS_Output_Variable) {
-    if (!m_dirty) {
-      m_dirty = true;
-      QTimer::singleShot(0, this, SLOT(updateVariableList()));
+void VariablesList::onModelChanges(const openstudio::ModelChangeBatch& batch) {
+  // Additions first, so that a type whose objects are replaced in one batch keeps its rows
+  /// \todo if the user is able to add or remove an output variable through some other means it will not show up here and now
+  for (const auto& [type, objects] : batch.added) {
+    if (type == openstudio::IddObjectType::OS_Output_Variable) {
+      continue;
+    }
+    LOG(Debug, "onModelChanges: " << objects.size() << " " << type.valueName() << " added");
+    for (const auto& impl : objects) {
+      if (boost::optional<model::ModelObject> modelObject = impl->getObject<WorkspaceObject>().optionalCast<model::ModelObject>()) {
+        addModelObject(*modelObject);
+      }
     }
   }
-}
-
-void VariablesList::onRemoved(const WorkspaceObject&, const openstudio::IddObjectType& type, const openstudio::UUID&) {
-  LOG(Debug, "onRemoved " << type.valueName());
 
-  /// \todo if the user is remove to add an output variable through some other means it will not show up here and now
-  if (type != openstudio::IddObjectType::OS_Output_Variable) {
-    if (!m_dirty) {
-      m_dirty = true;
-      QTimer::singleShot(0, this, SLOT(updateVariableList()));
+  for (const auto& [type, handles] : batch.removed) {
+    if (type == openstudio::IddObjectType::OS_Output_Variable) {
+      continue;
+    }
+    LOG(Debug, "onModelChanges: " << handles.size() << " " << type.valueName() << " removed");
+    for (size_t i = 0; i < handles.size(); ++i) {
+      removeObjectType(type);
     }
   }
 }
 
-struct PotentialOutputVariable
-{
-  std::string name;
-  std::string keyValue;
-  boost::optional<openstudio::model::OutputVariable> variable;
-};
-
-void VariablesList::updateVariableList() {
-  m_variables.clear();
-  while (m_listLayout->count() > 0) {
-    QLayoutItem* qli = m_listLayout->takeAt(0);
-    delete qli->widget();
-    delete qli;
-  }
-
-  // map of variable name + keyValue to PotentialOutputVariable
-  std::map<std::string, PotentialOutputVariable> potentialOutputVariableMap;
-
+void VariablesList::buildVariableList() {
   // make list of all potential variables
   for (const openstudio::model::ModelObject& modelObject : m_model.getModelObjects<openstudio::model::ModelObject>()) {
-    for (const std::string& variableName : modelObject.outputVariableNames()) {
-      //LOG(Debug, "Found variableName: " << variableName);
-      std::string variableNameKeyValue = variableName + "*";
-      if (potentialOutputVariableMap.count(variableNameKeyValue) == 0) {
-        PotentialOutputVariable pov;
-        pov.name = variableName;
-        pov.keyValue = "*";
-        potentialOutputVariableMap.insert(std::pair<std::string, PotentialOutputVariable>(variableNameKeyValue, pov));
-      }
+    if (modelObject.iddObjectType() != openstudio::IddObjectType::OS_Output_Variable) {
+      addModelObject(modelObject);
     }
   }
 
@@ -246,64 +247,176 @@ void VariablesList::updateVariableList() {
   for (openstudio::model::OutputVariable outputVariable : m_model.getConcreteModelObjects<openstudio::model::OutputVariable>()) {
     std::string variableName = outputVariable.variableName();
     std::string keyValue = outputVariable.keyValue();
-    std::string variableNameKeyValue = variableName + keyValue;
 
-    if (potentialOutputVariableMap.count(variableNameKeyValue) == 0) {
+    auto it = m_rows.find(variableName + keyValue);
+    if (it == m_rows.end()) {
       // DLM: this was causing too much trouble because it kept deleting variables added by users
       // there is no place for this outputvariable with the current objects, delete it.
       //outputVariable.remove();
 
       // user defined variable, add it to the list
-      PotentialOutputVariable pov;
-      pov.name = outputVariable.variableName();
-      pov.keyValue = outputVariable.keyValue();
-      pov.variable = outputVariable;
-      potentialOutputVariableMap.insert(std::pair<std::string, PotentialOutputVariable>(variableNameKeyValue, pov));
-
+      addRow(variableName, keyValue, outputVariable);
+    } else if (it->second.variable) {
+      // already have output variable for this name + keyName, then remove this object
+      outputVariable.remove();
     } else {
+      // this is a predefined variable
+      it->second.variable = outputVariable;
+    }
+  }
+}
 
-      if (potentialOutputVariableMap[variableNameKeyValue].variable) {
-        // already have output variable for this name + keyName, then remove this object
-        outputVariable.remove();
-      } else {
-        // this is a predefined variable
+void VariablesList::addModelObject(const openstudio::model::ModelObject& modelObject) {
+  openstudio::IddObjectType type = modelObject.iddObjectType();
+  if (m_objectCounts[type]++ > 0) {
+    return;
+  }
 
-        // make sure that key value is set to '*'
-        // DLM: we know this is already '*' because all predefined variables are set to '*'
-        //outputVariable.setKeyValue("*");
+  // the variables an object can report only depend on its type
+  auto names = m_variableNamesByType.find(type);
+  if (names == m_variableNamesByType.end()) {
+    names = m_variableNamesByType.emplace(type, modelObject.outputVariableNames()).first;
+  }
 
-        potentialOutputVariableMap[variableNameKeyValue].variable = outputVariable;
+  for (const std::string& variableName : names->second) {
+    if (m_variableNameCounts[variableName]++ == 0) {
+      if (m_rows.find(variableName + "*") == m_rows.end()) {
+        addRow(variableName, "*", boost::none);
       }
     }
   }
+}
 
-  for (std::map<std::string, PotentialOutputVariable>::const_iterator itr = potentialOutputVariableMap.begin();
-       itr != potentialOutputVariableMap.end(); ++itr) {
-    auto hline = new QFrame();
-    hline->setFrameShape(QFrame::HLine);
-    hline->setFrameShadow(QFrame::Sunken);
-    m_listLayout->addWidget(hline);
+void VariablesList::removeObjectType(const openstudio::IddObjectType& type) {
+  auto count = m_objectCounts.find(type);
+  if (count == m_objectCounts.end()) {
+    return;
+  }
+  if (--count->second > 0) {
+    return;
+  }
+  m_objectCounts.erase(count);
 
-    PotentialOutputVariable pov = itr->second;
+  for (const std::string& variableName : m_variableNamesByType[type]) {
+    auto nameCount = m_variableNameCounts.find(variableName);
+    if (nameCount == m_variableNameCounts.end() || --nameCount->second > 0) {
+      continue;
+    }
+    m_variableNameCounts.erase(nameCount);
 
-    //LOG(Debug, "Creating VariableListItem for: " << pov.name << ", " << pov.keyValue);
-    auto li = new VariableListItem(pov.name, pov.keyValue, pov.variable, m_model);
-    m_listLayout->addWidget(li);
-    m_variables.push_back(li);
+    auto it = m_rows.find(variableName + "*");
+    if (it != m_rows.end()) {
+      VariableRow& row = it->second;
+      if (row.widget) {
+        row.variable = row.widget->variable();
+      }
+      // an enabled variable stays listed, like a user defined one
+      if (!row.variable) {
+        removeRow(it->first);
+      }
+    }
+  }
+}
+
+void VariablesList::addRow(const std::string& name, const std::string& keyValue, const boost::optional<openstudio::model::OutputVariable>& variable) {
+  auto [it, inserted] = m_rows.emplace(name + keyValue, VariableRow{name, keyValue, variable});
+  if (!inserted) {
+    return;
   }
 
-  m_listLayout->addStretch();
+  auto item = new QListWidgetItem();
+  item->setData(Qt::UserRole, toQString(it->first));
+  item->setSizeHint(QSize(0, m_rowHeight));
+  m_listWidget->insertItem(std::distance(m_rows.begin(), it), item);
+  it->second.item = item;
+
+  scheduleUpdateVisibleItems();
+}
 
-  m_dirty = false;
+void VariablesList::removeRow(const std::string& variableNameKeyValue) {
+  auto it = m_rows.find(variableNameKeyValue);
+  if (it == m_rows.end()) {
+    return;
+  }
+
+  deleteWidget(it->second);
+  delete it->second.item;
+  m_rows.erase(it);
+
+  scheduleUpdateVisibleItems();
+}
+
+void VariablesList::deleteWidget(VariableRow& row) {
+  if (row.widget) {
+    row.variable = row.widget->variable();
+    m_listWidget->removeItemWidget(row.item);
+    row.widget = nullptr;
+  }
+  m_rowsWithWidget.erase(row.name + row.keyValue);
+}
+
+void VariablesList::resizeEvent(QResizeEvent* event) {
+  QWidget::resizeEvent(event);
+  scheduleUpdateVisibleItems();
+}
+
+void VariablesList::scheduleUpdateVisibleItems() {
+  if (!m_visibleItemsDirty) {
+    m_visibleItemsDirty = true;
+    QTimer::singleShot(0, this, &VariablesList::updateVisibleItems);
+  }
+}
+
+void VariablesList::updateVisibleItems() {
+  m_visibleItemsDirty = false;
+
+  std::set<std::string> visibleRows;
+  int count = m_listWidget->count();
+  if (count > 0) {
+    QRect viewport = m_listWidget->viewport()->rect();
+    int first = m_listWidget->indexAt(viewport.topLeft()).row();
+    int last = m_listWidget->indexAt(viewport.bottomLeft()).row();
+    if (first < 0) {
+      first = 0;
+    }
+    if (last < 0) {
+      last = count - 1;
+    }
+
+    // a few rows ahead so that scrolling does not show empty rows
+    const int margin = 5;
+    first = std::max(0, first - margin);
+    last = std::min(count - 1, last + margin);
+
+    for (int i = first; i <= last; ++i) {
+      QListWidgetItem* item = m_listWidget->item(i);
+      std::string variableNameKeyValue = toString(item->data(Qt::UserRole).toString());
+      auto it = m_rows.find(variableNameKeyValue);
+      OS_ASSERT(it != m_rows.end());
+
+      VariableRow& row = it->second;
+      if (!row.widget) {
+        //LOG(Debug, "Creating VariableListItem for: " << row.name << ", " << row.keyValue);
+        row.widget = new VariableListItem(row.name, row.keyValue, row.variable, m_model);
+        m_listWidget->setItemWidget(item, row.widget);
+        m_rowsWithWidget.insert(variableNameKeyValue);
+      }
+      visibleRows.insert(variableNameKeyValue);
+    }
+  }
+
+  std::vector<std::string> hiddenRows;
+  std::set_difference(m_rowsWithWidget.begin(), m_rowsWithWidget.end(), visibleRows.begin(), visibleRows.end(), std::back_inserter(hiddenRows));
+  for (const std::string& variableNameKeyValue : hiddenRows) {
+    deleteWidget(m_rows[variableNameKeyValue]);
+  }
 }
 
 VariablesTabView::VariablesTabView(openstudio::model::Model t_model, QWidget* parent)
   : MainTabView("Output Variables", MainTabView::MAIN_TAB, parent) {
-  auto scrollarea = new QScrollArea();
+  // VariablesList scrolls its rows itself
   VariablesList* vl = new VariablesList(t_model);
-  scrollarea->setWidget(vl);
-  scrollarea->setWidgetResizable(true);
-  addTabWidget(scrollarea);
+  addTabWidget(vl);
   vl->setAutoFillBackground(false);
 }
 
@@ -37,11 +37,19 @@
 #include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
 #include <boost/optional.hpp>
 
+#include <map>
+#include <memory>
+#include <set>
+
 class QComboBox;
+class QListWidget;
+class QListWidgetItem;
 class QPushButton;
 class QVBoxLayout;
 
 namespace openstudio {
+class ModelChangeBus;
+struct ModelChangeBatch;
 class OSSwitch2;
 class OSComboBox2;
 
@@ -55,6 +63,9 @@ class VariableListItem : public QWidget, public Nano::Observer
 
   virtual ~VariableListItem() {}
 
+  // the output variable, if the item is on
+  boost::optional<openstudio::model::OutputVariable> variable() const;
+
  public slots:
   void setVariableEnabled(bool);
 
@@ -74,6 +85,12 @@ class VariableListItem : public QWidget, public Nano::Observer
   OSSwitch2* m_onOffButton;
 };
 
+/** VariablesList lists the output variables the objects of the model can report.
+  *
+  * The variable names of each object type are asked to the first object of the type and cached, the list then follows the
+  * number of objects of each type as objects are added and removed. Rows only get a VariableListItem while they are in
+  * view.
+  **/
 class VariablesList : public QWidget, public Nano::Observer
 {
   Q_OBJECT;
@@ -82,24 +99,63 @@ class VariablesList : public QWidget, public Nano::Observer
   VariablesList(openstudio::model::Model t_model);
   virtual ~VariablesList();
 
+ protected:
+  virtual void resizeEvent(QResizeEvent* event) override;
+
  private slots:
-  void onAdded(const WorkspaceObject&, const openstudio::IddObjectType&, const openstudio::UUID&);
-  void onRemoved(const WorkspaceObject&, const openstudio::IddObjectType&, const openstudio::UUID&);
+  void onModelChanges(const openstudio::ModelChangeBatch& batch);
 
   void allOnClicked();
   void allOffClicked();
 
   void enableAll(bool);
-  void updateVariableList();
+
+  // create the widgets of the rows in view, delete the others
+  void updateVisibleItems();
 
  private:
   REGISTER_LOGGER("openstudio.VariablesList");
+
+  struct VariableRow
+  {
+    std::string name;
+    std::string keyValue;
+    boost::optional<openstudio::model::OutputVariable> variable;
+    QListWidgetItem* item = nullptr;
+    VariableListItem* widget = nullptr;
+  };
+
+  void buildVariableList();
+
+  void addModelObject(const openstudio::model::ModelObject& modelObject);
+
+  void removeObjectType(const openstudio::IddObjectType& type);
+
+  void addRow(const std::string& name, const std::string& keyValue, const boost::optional<openstudio::model::OutputVariable>& variable);
+
+  void removeRow(const std::string& variableNameKeyValue);
+
+  void deleteWidget(VariableRow& row);
+
+  void scheduleUpdateVisibleItems();
+
   openstudio::model::Model m_model;
+  std::shared_ptr<ModelChangeBus> m_modelChangeBus;
   QPushButton* m_allOnBtn;
   QPushButton* m_allOffBtn;
-  QVBoxLayout* m_listLayout;
-  bool m_dirty;
-  std::vector<VariableListItem*> m_variables;
+  QListWidget* m_listWidget;
+  int m_rowHeight;
+  bool m_visibleItemsDirty;
+
+  // output variable names of each object type
+  std::map<openstudio::IddObjectType, std::vector<std::string>> m_variableNamesByType;
+  // number of objects of each type, and number of types present offering each variable name
+  std::map<openstudio::IddObjectType, unsigned> m_objectCounts;
+  std::map<std::string, unsigned> m_variableNameCounts;
+
+  // by variable name + key value, in display order
+  std::map<std::string, VariableRow> m_rows;
+  std::set<std::string> m_rowsWithWidget;
 };
 
 class VariablesTabView : public MainTabView
@@ -0,0 +1,236 @@
+// Keeps track of the floorplan last exchanged with FloorspaceEditor so that only the stories, spaces and assignments
+// which changed cross the bridge. Entries are split as in FloorplanJSDelta.cpp, keep both in sync.
+// Also notifies FloorspaceEditor of changes through OSWebEnginePage, so the application does not poll window.versionNumber.
+window.osFloorplanSync = (function () {
+  var snapshot = {};
+  // window.versionNumber when snapshot was last in sync with the store, nothing to export until it moves
+  var snapshotVersion = null;
+  var applying = false;
+  var notificationQueued = false;
+
+  // called by the store on every commit, a burst of commits results in a single notification
+  var onChange = window.api.config.onChange;
+  window.api.config.onChange = function () {
+    onChange();
+    if (applying || notificationQueued) {
+      return;
+    }
+    notificationQueued = true;
+    setTimeout(function () {
+      notificationQueued = false;
+      console.info('openstudio:floorplanChanged:' + window.versionNumber);
+    }, 0);
+  };
+
+  function idString(id) {
+    if (typeof id === 'string' || typeof id === 'number') {
+      return String(id);
+    }
+    return null;
+  }
+
+  function isCollection(value) {
+    return Array.isArray(value) && value.every(function (item) {
+      return item !== null && typeof item === 'object' && !Array.isArray(item) && idString(item.id) !== null;
+    });
+  }
+
+  function entries(floorplan) {
+    var result = {};
+    Object.keys(floorplan || {}).forEach(function (name) {
+      var value = floorplan[name];
+      if (!isCollection(value)) {
+        result[name] = value;
+        return;
+      }
+      result['@' + name] = value.map(function (item) { return item.id; });
+      value.forEach(function (item) {
+        var key = name + '/' + idString(item.id);
+        if (name === 'stories' && isCollection(item.spaces)) {
+          result[key + '/@spaces'] = item.spaces.map(function (space) { return space.id; });
+          item.spaces.forEach(function (space) {
+            result[key + '/spaces/' + idString(space.id)] = space;
+          });
+          var story = Object.assign({}, item);
+          delete story.spaces;
+          result[key] = story;
+        } else {
+          result[key] = item;
+        }
+      });
+    });
+    return result;
+  }
+
+  function assemble(entries) {
+    var result = {};
+    Object.keys(entries).forEach(function (key) {
+      if (key.length === 0 || key.indexOf('/') !== -1) {
+        return;
+      }
+      if (key[0] !== '@') {
+        result[key] = entries[key];
+        return;
+      }
+      var name = key.substr(1);
+      result[name] = [];
+      entries[key].forEach(function (id) {
+        var itemKey = name + '/' + idString(id);
+        if (!(itemKey in entries)) {
+          return;
+        }
+        var item = Object.assign({}, entries[itemKey]);
+        var spaceIds = entries[itemKey + '/@spaces'];
+        if (spaceIds) {
+          item.spaces = [];
+          spaceIds.forEach(function (spaceId) {
+            var space = entries[itemKey + '/spaces/' + idString(spaceId)];
+            if (space !== undefined) {
+              item.spaces.push(space);
+            }
+          });
+        }
+        result[name].push(item);
+      });
+    });
+    return result;
+  }
+
+  // Changes made in the editor since the last exchange, as a JSON string
+  function exportDelta() {
+    if (snapshotVersion !== null && window.versionNumber === snapshotVersion) {
+      return JSON.stringify({ changed: {}, removed: [] });
+    }
+    var current = entries(window.api.exportFloorplan());
+    var delta = { changed: {}, removed: [] };
+    var next = {};
+    Object.keys(current).forEach(function (key) {
+      var value = JSON.stringify(current[key]);
+      if (snapshot[key] !== value) {
+        delta.changed[key] = current[key];
+      }
+      next[key] = value;
+    });
+    Object.keys(snapshot).forEach(function (key) {
+      if (!(key in next)) {
+        delta.removed.push(key);
+      }
+    });
+    snapshot = next;
+    snapshotVersion = window.versionNumber;
+    return JSON.stringify(delta);
+  }
+
+  // Forget what was exchanged, returns the whole floorplan as a delta
+  function reset() {
+    snapshot = {};
+    snapshotVersion = null;
+    return exportDelta();
+  }
+
+  function isScalar(value) {
+    return value === null || typeof value !== 'object';
+  }
+
+  // Library collections whose items are updated in place by the models/updateObjectWithData mutation
+  var libraryCollections = ['building_units', 'thermal_zones', 'space_types', 'construction_sets'];
+
+  // Store object an entry was exported from, if it can be updated in place
+  function storeObject(key) {
+    var models = window.application.$store.state.models;
+    var parts = key.split('/');
+    if (parts.length === 2 && parts[0] === 'stories') {
+      return { mutation: 'models/updateStoryWithData', name: 'story', object: models.stories.find(function (story) { return idString(story.id) === parts[1]; }) };
+    }
+    if (parts.length === 4 && parts[0] === 'stories' && parts[2] === 'spaces') {
+      var story = models.stories.find(function (item) { return idString(item.id) === parts[1]; });
+      return { mutation: 'models/updateSpaceWithData', name: 'space', object: story && story.spaces.find(function (space) { return idString(space.id) === parts[3]; }) };
+    }
+    if (parts.length === 2 && libraryCollections.indexOf(parts[0]) !== -1) {
+      return { mutation: 'models/updateObjectWithData', name: 'object', object: models.library[parts[0]].find(function (item) { return idString(item.id) === parts[1]; }) };
+    }
+    return null;
+  }
+
+  // Commit each changed property of existing stories, spaces and library objects, which is what updates from the model
+  // usually are (handles and names). Returns false without touching the store if anything else changed.
+  function applyInPlace(delta) {
+    if (delta.removed.length > 0) {
+      return false;
+    }
+    var updates = [];
+    var inPlace = Object.keys(delta.changed).every(function (key) {
+      if (!(key in snapshot)) {
+        return false;
+      }
+      var target = storeObject(key);
+      if (!target || !target.object) {
+        return false;
+      }
+      var before = JSON.parse(snapshot[key]);
+      var after = delta.changed[key];
+      var properties = {};
+      var keys = Object.keys(before).concat(Object.keys(after));
+      for (var i = 0; i < keys.length; ++i) {
+        var name = keys[i];
+        if (JSON.stringify(before[name]) === JSON.stringify(after[name])) {
+          continue;
+        }
+        if (!(name in before) || !(name in after) || !(name in target.object) || !isScalar(after[name])) {
+          return false;
+        }
+        properties[name] = after[name];
+      }
+      properties[target.name] = target.object;
+      updates.push({ mutation: target.mutation, properties: properties });
+      return true;
+    });
+    if (!inPlace) {
+      return false;
+    }
+    updates.forEach(function (update) {
+      window.application.$store.commit(update.mutation, update.properties);
+    });
+    return true;
+  }
+
+  // Merge changes made on the model side, edits made in the editor meanwhile are kept and reported by the next exportDelta.
+  // Property changes are committed to the store in place, anything else re-imports the merged floorplan.
+  function applyDelta(delta) {
+    // changes coming from the model are not edits to report back
+    applying = true;
+    try {
+      var inSync = snapshotVersion !== null && window.versionNumber === snapshotVersion;
+      if (applyInPlace(delta)) {
+        Object.keys(delta.changed).forEach(function (key) {
+          snapshot[key] = JSON.stringify(delta.changed[key]);
+        });
+        if (inSync) {
+          snapshotVersion = window.versionNumber;
+        }
+        return true;
+      }
+    } finally {
+      applying = false;
+    }
+
+    var current = entries(window.api.exportFloorplan());
+    delta.removed.forEach(function (key) {
+      delete current[key];
+      delete snapshot[key];
+    });
+    Object.keys(delta.changed).forEach(function (key) {
+      current[key] = delta.changed[key];
+      snapshot[key] = JSON.stringify(delta.changed[key]);
+    });
+    applying = true;
+    try {
+      return window.api.openFloorplan(JSON.stringify(assemble(current)), { noReloadGrid: true });
+    } finally {
+      applying = false;
+      snapshotVersion = null;
+    }
+  }
+
+  return { exportDelta: exportDelta, reset: reset, applyDelta: applyDelta };
+})();
@@ -0,0 +1,98 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../../shared_gui_components/BCLDownloadManager.hpp"
+
+#include <QEventLoop>
+#include <QTimer>
+
+#include <algorithm>
+
+using namespace openstudio;
+
+// Finishes each download after a delay instead of going to the BCL
+class DelayedBCLDownloadManager : public BCLDownloadManager
+{
+ public:
+  explicit DelayedBCLDownloadManager(int latencyMs) : m_latencyMs(latencyMs) {}
+
+  int running = 0;
+  int maxRunning = 0;
+  std::vector<std::string> failingUids;
+
+ protected:
+  virtual bool startDownload(int worker, const std::string& uid, DownloadType type) override {
+    if (std::find(failingUids.begin(), failingUids.end(), uid) != failingUids.end()) {
+      return false;
+    }
+    ++running;
+    maxRunning = std::max(maxRunning, running);
+    QTimer::singleShot(m_latencyMs, this, [this, uid]() {
+      --running;
+      onComponentDownloaded(uid, boost::none);
+    });
+    return true;
+  }
+
+ private:
+  int m_latencyMs;
+};
+
+TEST_F(OpenStudioLibFixture, BCLDownloadManager_BoundedDownloads) {
+  DelayedBCLDownloadManager manager(20);
+  manager.setMaxDownloads(3);
+  manager.failingUids.push_back("uid_5");
+
+  std::vector<std::string> downloaded;
+  QObject::connect(&manager, &BCLDownloadManager::componentDownloaded,
+                   [&downloaded](const std::string& uid, const boost::optional<BCLComponent>&) { downloaded.push_back(uid); });
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(manager.download("uid_" + std::to_string(i), BCLDownloadManager::DownloadType::Component));
+  }
+  // already queued
+  EXPECT_FALSE(manager.download("uid_9", BCLDownloadManager::DownloadType::Component));
+
+  EXPECT_EQ(10, manager.requestedCount());
+  EXPECT_EQ(3, manager.running);
+
+  QEventLoop loop;
+  QObject::connect(&manager, &BCLDownloadManager::idle, &loop, &QEventLoop::quit);
+  QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+  loop.exec();
+
+  EXPECT_EQ(0, manager.pendingCount());
+  EXPECT_EQ(10, manager.finishedCount());
+  EXPECT_EQ(3, manager.maxRunning);
+  EXPECT_EQ(10u, downloaded.size());
+}
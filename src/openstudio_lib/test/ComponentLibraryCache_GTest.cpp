@@ -0,0 +1,158 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../ComponentLibraryCache.hpp"
+#include "../../model_editor/Utilities.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Space.hpp>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSettings>
+#include <QTemporaryDir>
+
+using namespace openstudio;
+
+// Saves a library holding numSpaces spaces
+static openstudio::path saveLibrary(const QTemporaryDir& tempDir, const QString& name, int numSpaces) {
+  model::Model model;
+  for (int i = 0; i < numSpaces; ++i) {
+    model::Space space(model);
+  }
+  openstudio::path result = toPath(tempDir.filePath(name));
+  EXPECT_TRUE(model.save(result, true));
+  return result;
+}
+
+TEST_F(OpenStudioLibFixture, ComponentLibraryCache_UpToDate) {
+  QTemporaryDir tempDir;
+  ASSERT_TRUE(tempDir.isValid());
+
+  openstudio::path libraryPath = saveLibrary(tempDir, "library.osm", 3);
+  ComponentLibraryCache cache(toPath(tempDir.filePath("cache")));
+
+  EXPECT_FALSE(cache.find(libraryPath));
+  EXPECT_FALSE(cache.types(libraryPath));
+  EXPECT_FALSE(cache.handles(libraryPath));
+
+  // Loading a library caches its translated copy, its types and its handles
+  boost::optional<model::Model> loaded = cache.loadLibrary(libraryPath);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(3u, loaded->getConcreteModelObjects<model::Space>().size());
+
+  boost::optional<model::Model> cached = cache.find(libraryPath);
+  ASSERT_TRUE(cached);
+  EXPECT_EQ(3u, cached->getConcreteModelObjects<model::Space>().size());
+  boost::optional<std::set<IddObjectType>> types = cache.types(libraryPath);
+  ASSERT_TRUE(types);
+  EXPECT_EQ(1u, types->count(IddObjectType::OS_Space));
+  boost::optional<std::set<Handle>> handles = cache.handles(libraryPath);
+  ASSERT_TRUE(handles);
+  for (const auto& space : cached->getConcreteModelObjects<model::Space>()) {
+    EXPECT_EQ(1u, handles->count(space.handle()));
+  }
+
+  QStringList iniFiles = QDir(toQString(cache.cacheDir())).entryList({"*.ini"}, QDir::Files);
+  ASSERT_EQ(1, iniFiles.size());
+  const QString iniPath = QDir(toQString(cache.cacheDir())).filePath(iniFiles[0]);
+
+  // A library modified since it was cached is a miss
+  {
+    QFile libraryFile(toQString(libraryPath));
+    ASSERT_TRUE(libraryFile.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(libraryFile.setFileTime(QDateTime::currentDateTime().addSecs(3600), QFileDevice::FileModificationTime));
+  }
+  EXPECT_FALSE(cache.find(libraryPath));
+  EXPECT_FALSE(cache.types(libraryPath));
+  EXPECT_FALSE(cache.handles(libraryPath));
+
+  ASSERT_TRUE(cache.loadLibrary(libraryPath));
+  EXPECT_TRUE(cache.find(libraryPath));
+
+  // So is a copy translated by another version of OpenStudio
+  {
+    QSettings settings(iniPath, QSettings::IniFormat);
+    settings.setValue("openstudio_version", "0.0.1");
+  }
+  EXPECT_FALSE(cache.find(libraryPath));
+  EXPECT_FALSE(cache.types(libraryPath));
+
+  // Another library is cached separately
+  openstudio::path otherPath = saveLibrary(tempDir, "other.osm", 1);
+  EXPECT_FALSE(cache.find(otherPath));
+  ASSERT_TRUE(cache.loadLibrary(otherPath));
+  ASSERT_TRUE(cache.find(otherPath));
+  EXPECT_EQ(1u, cache.find(otherPath)->getConcreteModelObjects<model::Space>().size());
+  EXPECT_FALSE(cache.find(libraryPath));
+}
+
+TEST_F(OpenStudioLibFixture, ComponentLibraryCache_LoadLibraries) {
+  QTemporaryDir tempDir;
+  ASSERT_TRUE(tempDir.isValid());
+
+  const int numLibraries = 8;
+  std::vector<openstudio::path> libraryPaths;
+  for (int i = 0; i < numLibraries; ++i) {
+    libraryPaths.push_back(saveLibrary(tempDir, QString("library_%1.osm").arg(i), i + 1));
+  }
+  libraryPaths.push_back(toPath(tempDir.filePath("missing.osm")));
+
+  ComponentLibraryCache cache(toPath(tempDir.filePath("cache")));
+
+  // Translated concurrently, each result stays with its path
+  std::vector<boost::optional<model::Model>> loaded = cache.loadLibraries(libraryPaths);
+  ASSERT_EQ(libraryPaths.size(), loaded.size());
+  for (int i = 0; i < numLibraries; ++i) {
+    ASSERT_TRUE(loaded[i]);
+    EXPECT_EQ(static_cast<size_t>(i + 1), loaded[i]->getConcreteModelObjects<model::Space>().size());
+  }
+  EXPECT_FALSE(loaded.back());
+
+  // Every library got its own cached copy
+  EXPECT_EQ(numLibraries, QDir(toQString(cache.cacheDir())).entryList({"*.ini"}, QDir::Files).size());
+  for (int i = 0; i < numLibraries; ++i) {
+    boost::optional<model::Model> cached = cache.find(libraryPaths[i]);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(static_cast<size_t>(i + 1), cached->getConcreteModelObjects<model::Space>().size());
+  }
+  EXPECT_FALSE(cache.find(libraryPaths.back()));
+
+  // Loading them again gives the same libraries, from the cached copies
+  loaded = cache.loadLibraries(libraryPaths);
+  for (int i = 0; i < numLibraries; ++i) {
+    ASSERT_TRUE(loaded[i]);
+    EXPECT_EQ(static_cast<size_t>(i + 1), loaded[i]->getConcreteModelObjects<model::Space>().size());
+  }
+}
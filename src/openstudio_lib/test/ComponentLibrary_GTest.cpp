@@ -0,0 +1,151 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../ComponentLibrary.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Construction.hpp>
+#include <openstudio/model/StandardOpaqueMaterial.hpp>
+#include <openstudio/model/SpaceType.hpp>
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, ComponentLibrary_LoadOnDemand) {
+  int constructionLoads = 0;
+  int spaceTypeLoads = 0;
+
+  model::Model libraryModel;
+  std::shared_ptr<ComponentLibrary> library = ComponentLibrary::create(libraryModel);
+
+  library->addPendingLibrary("constructions", {IddObjectType::OS_Construction, IddObjectType::OS_Material}, [&constructionLoads]() {
+    ++constructionLoads;
+    model::Model model;
+    model::StandardOpaqueMaterial material(model);
+    model::Construction construction(model);
+    std::vector<model::Material> layers{material};
+    construction.setLayers(layers);
+    return boost::optional<model::Model>(model);
+  });
+
+  library->addPendingLibrary("space types", {IddObjectType::OS_SpaceType}, [&spaceTypeLoads]() {
+    ++spaceTypeLoads;
+    model::Model model;
+    model::SpaceType spaceType(model);
+    return boost::optional<model::Model>(model);
+  });
+
+  EXPECT_EQ(2u, library->pendingLibraryCount());
+  EXPECT_TRUE(libraryModel.getConcreteModelObjects<model::Construction>().empty());
+
+  // Types nobody provides don't load anything
+  ComponentLibrary::load(libraryModel, IddObjectType::OS_Schedule_Ruleset);
+  EXPECT_EQ(0, constructionLoads);
+  EXPECT_EQ(0, spaceTypeLoads);
+
+  // Requesting a type through the model loads the library providing it, along with the objects it references
+  ComponentLibrary::load(libraryModel, IddObjectType::OS_Construction);
+  EXPECT_EQ(1, constructionLoads);
+  EXPECT_EQ(0, spaceTypeLoads);
+  EXPECT_EQ(1u, libraryModel.getConcreteModelObjects<model::Construction>().size());
+  EXPECT_EQ(1u, libraryModel.getConcreteModelObjects<model::StandardOpaqueMaterial>().size());
+  EXPECT_EQ(1u, library->pendingLibraryCount());
+
+  // Libraries are only loaded once
+  ComponentLibrary::load(libraryModel, IddObjectType::OS_Material);
+  EXPECT_EQ(1, constructionLoads);
+
+  // Other models are not affected
+  model::Model otherModel;
+  ComponentLibrary::load(otherModel, IddObjectType::OS_SpaceType);
+  EXPECT_EQ(0, spaceTypeLoads);
+
+  EXPECT_TRUE(library->loadAll().empty());
+  EXPECT_EQ(1, spaceTypeLoads);
+  EXPECT_EQ(1u, libraryModel.getConcreteModelObjects<model::SpaceType>().size());
+  EXPECT_EQ(0u, library->pendingLibraryCount());
+}
+
+TEST_F(OpenStudioLibFixture, ComponentLibrary_GetModelObject) {
+  int loads = 0;
+
+  model::Model constructionsModel;
+  model::Construction construction(constructionsModel);
+  Handle handle = construction.handle();
+
+  model::Model libraryModel;
+  std::shared_ptr<ComponentLibrary> library = ComponentLibrary::create(libraryModel);
+  library->addPendingLibrary(
+    "constructions", {IddObjectType::OS_Construction},
+    [&loads, constructionsModel]() {
+      ++loads;
+      return boost::optional<model::Model>(constructionsModel);
+    },
+    {handle});
+
+  // Unknown handles don't load anything
+  EXPECT_FALSE(ComponentLibrary::getModelObject(libraryModel, createUUID()));
+  EXPECT_EQ(0, loads);
+
+  // A dropped library item is found even if its type was never listed
+  boost::optional<model::ModelObject> object = ComponentLibrary::getModelObject(libraryModel, handle);
+  ASSERT_TRUE(object);
+  EXPECT_EQ(IddObjectType(IddObjectType::OS_Construction), object->iddObjectType());
+  EXPECT_EQ(1, loads);
+  EXPECT_EQ(0u, library->pendingLibraryCount());
+
+  EXPECT_TRUE(ComponentLibrary::getModelObject(libraryModel, handle));
+  EXPECT_EQ(1, loads);
+}
+
+TEST_F(OpenStudioLibFixture, ComponentLibrary_LoadFailed) {
+  model::Model libraryModel;
+  std::shared_ptr<ComponentLibrary> library = ComponentLibrary::create(libraryModel);
+
+  library->addPendingLibrary("missing", {IddObjectType::OS_Construction}, []() { return boost::optional<model::Model>(); });
+
+  std::vector<std::string> reported;
+  QObject::connect(library.get(), &ComponentLibrary::loadFailed, [&reported](const std::vector<std::string>& failed) { reported = failed; });
+
+  // Libraries failing to load on demand are returned and reported to whoever shows them
+  std::vector<std::string> failed = ComponentLibrary::load(libraryModel, IddObjectType::OS_Construction);
+  ASSERT_EQ(1u, failed.size());
+  EXPECT_EQ("missing", failed[0]);
+  EXPECT_EQ(failed, reported);
+  EXPECT_EQ(0u, library->pendingLibraryCount());
+
+  // Once the library is gone, requests for its model do nothing
+  library.reset();
+  reported.clear();
+  EXPECT_TRUE(ComponentLibrary::load(libraryModel, IddObjectType::OS_Construction).empty());
+  EXPECT_TRUE(reported.empty());
+}
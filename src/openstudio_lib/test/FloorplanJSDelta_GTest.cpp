@@ -0,0 +1,84 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../FloorplanJSDelta.hpp"
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, FloorplanJSDelta) {
+  std::string json = R"({
+    "project": {"config": {"units": "si"}},
+    "stories": [
+      {"id": "1", "name": "Story 1", "geometry": {"vertices": []},
+       "spaces": [{"id": "2", "name": "Space 1", "thermal_zone_id": "5"}, {"id": "3", "name": "Space 2"}]},
+      {"id": "4", "name": "Story 2", "geometry": {"vertices": []}, "spaces": []}
+    ],
+    "thermal_zones": [{"id": "5", "name": "Zone 1"}],
+    "space_types": []
+  })";
+
+  boost::optional<Json::Value> floorplan = FloorplanJSDelta::parse(json);
+  ASSERT_TRUE(floorplan);
+
+  FloorplanJSDelta::Entries before = FloorplanJSDelta::entries(*floorplan);
+  EXPECT_EQ(1u, before.count("project"));
+  EXPECT_EQ(1u, before.count("stories/1"));
+  EXPECT_FALSE(before["stories/1"].isMember("spaces"));
+  EXPECT_EQ(1u, before.count("stories/1/spaces/3"));
+  EXPECT_EQ(1u, before.count("thermal_zones/5"));
+  EXPECT_EQ(1u, before.count("@space_types"));
+  EXPECT_EQ(*floorplan, FloorplanJSDelta::assemble(before));
+
+  // Nothing changed, nothing to send
+  EXPECT_TRUE(FloorplanJSDelta::isEmpty(FloorplanJSDelta::diff(before, before)));
+
+  // Renaming a space and removing another only sends those spaces, not their story
+  Json::Value edited = *floorplan;
+  edited["stories"][0]["spaces"][0]["name"] = "Office";
+  edited["stories"][0]["spaces"].removeIndex(1, nullptr);
+  FloorplanJSDelta::Entries after = FloorplanJSDelta::entries(edited);
+
+  Json::Value delta = FloorplanJSDelta::diff(before, after);
+  EXPECT_FALSE(FloorplanJSDelta::isEmpty(delta));
+  EXPECT_EQ(2u, delta["changed"].size());
+  EXPECT_TRUE(delta["changed"].isMember("stories/1/spaces/2"));
+  EXPECT_TRUE(delta["changed"].isMember("stories/1/@spaces"));
+  ASSERT_EQ(1u, delta["removed"].size());
+  EXPECT_EQ("stories/1/spaces/3", delta["removed"][0].asString());
+
+  // The delta survives serialization and rebuilds the edited floorplan on the other side
+  boost::optional<Json::Value> received = FloorplanJSDelta::parse(FloorplanJSDelta::toJSON(delta));
+  ASSERT_TRUE(received);
+  FloorplanJSDelta::apply(before, *received);
+  EXPECT_EQ(edited, FloorplanJSDelta::assemble(before));
+}
@@ -0,0 +1,153 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../../shared_gui_components/GridFilterIndex.hpp"
+
+#include <openstudio/model/BuildingStory.hpp>
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Space.hpp>
+#include <openstudio/model/Surface.hpp>
+
+#include <openstudio/utilities/geometry/Point3d.hpp>
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, GridFilterIndex_Filters) {
+  model::Model model;
+  model::BuildingStory story(model);
+  story.setName("Story 1");
+
+  model::Space space1(model);
+  space1.setBuildingStory(story);
+  model::Space space2(model);
+  space2.setBuildingStory(story);
+  model::Space space3(model);
+
+  std::vector<Point3d> vertices{Point3d(0, 0, 1), Point3d(0, 0, 0), Point3d(1, 0, 0), Point3d(1, 0, 1)};
+  model::Surface wall(vertices, model);
+  wall.setSurfaceType("Wall");
+  model::Surface floor(vertices, model);
+  floor.setSurfaceType("Floor");
+
+  GridFilterIndex index(model);
+  index.addFilter("Story", GridFilterIndex::Level::Row, nullptr, [](const model::ModelObject& obj) {
+    if (auto buildingStory = obj.cast<model::Space>().buildingStory()) {
+      return buildingStory->name();
+    }
+    return boost::optional<std::string>();
+  });
+  index.addFilter(
+    "Surface Type", GridFilterIndex::Level::SubRow,
+    [](const model::ModelObject& obj) { return static_cast<bool>(obj.optionalCast<model::Surface>()); },
+    [](const model::ModelObject& obj) { return boost::optional<std::string>(obj.cast<model::Surface>().surfaceType()); }, false);
+
+  std::vector<model::ModelObject> spaces{space1, space2, space3};
+  std::set<model::ModelObject> surfaces{wall, floor};
+  index.setObjects(spaces, surfaces);
+  EXPECT_EQ(5u, index.objectCount());
+
+  EXPECT_TRUE(index.hidden(GridFilterIndex::Level::Row).none());
+
+  index.showValue("Story", "Story 1");
+  EXPECT_EQ(1u, index.hidden(GridFilterIndex::Level::Row).count());
+
+  index.showUnassigned("Story");
+  EXPECT_EQ(2u, index.hidden(GridFilterIndex::Level::Row).count());
+
+  // Values nobody has hide everything the filter applies to
+  index.showValue("Story", "Story 2");
+  EXPECT_EQ(3u, index.hidden(GridFilterIndex::Level::Row).count());
+
+  // Row filters don't hide sub rows
+  EXPECT_TRUE(index.hidden(GridFilterIndex::Level::SubRow).none());
+
+  // Case insensitive
+  index.showValue("Surface Type", "wall");
+  EXPECT_EQ(1u, index.hidden(GridFilterIndex::Level::SubRow).count());
+
+  // A model change is picked up by the next setObjects, the selected values are kept
+  space3.setBuildingStory(story);
+  index.showAll("Story");
+  index.setObjects(spaces, surfaces);
+  index.showUnassigned("Story");
+  EXPECT_EQ(3u, index.hidden(GridFilterIndex::Level::Row).count());
+  EXPECT_EQ(1u, index.hidden(GridFilterIndex::Level::SubRow).count());
+}
+
+TEST_F(OpenStudioLibFixture, GridFilterIndex_NameFilter) {
+  const int numSpaces = 10000;
+
+  model::Model model;
+  std::vector<model::ModelObject> spaces;
+  for (int i = 0; i < numSpaces; ++i) {
+    model::Space space(model);
+    space.setName("Office Space " + std::to_string(i));
+    spaces.push_back(space);
+  }
+
+  GridFilterIndex index(model);
+  index.addTextFilter("Space Name", GridFilterIndex::Level::Row, nullptr, [](const model::ModelObject& obj) { return obj.name(); });
+  index.setObjects(spaces, std::set<model::ModelObject>());
+
+  // Built on first use
+  index.showContaining("Space Name", "");
+  EXPECT_TRUE(index.hidden(GridFilterIndex::Level::Row).none());
+
+  // Typing "space 123", as the name filter does on each key stroke
+  const std::string typed = "SPACE 123";
+  const std::vector<size_t> expectedShown{10000, 10000, 10000, 10000, 10000, 10000, 1111, 111, 11};
+  size_t previousShown = numSpaces;
+  for (size_t length = 1; length <= typed.size(); ++length) {
+    index.showContaining("Space Name", typed.substr(0, length));
+    size_t shown = numSpaces - index.hidden(GridFilterIndex::Level::Row).count();
+    EXPECT_EQ(expectedShown[length - 1], shown) << typed.substr(0, length);
+    // Extending the query only compares the matches of the previous one
+    EXPECT_LE(index.comparedTexts("Space Name"), previousShown) << typed.substr(0, length);
+    previousShown = shown;
+  }
+  // The trigrams rule out everything but the matches
+  EXPECT_EQ(11u, index.comparedTexts("Space Name"));
+
+  // Deleting a character widens the search again, the trigrams still rule out the spaces that can't match
+  index.showContaining("Space Name", "space 12");
+  EXPECT_EQ(111u, numSpaces - index.hidden(GridFilterIndex::Level::Row).count());
+  EXPECT_EQ(111u, index.comparedTexts("Space Name"));
+
+  // Renames are picked up, only the renamed space is indexed again
+  spaces.front().setName("Lobby");
+  index.setObjects(spaces, std::set<model::ModelObject>());
+  index.showContaining("Space Name", "lob");
+  EXPECT_EQ(1u, numSpaces - index.hidden(GridFilterIndex::Level::Row).count());
+  index.showContaining("Space Name", "space 0");
+  EXPECT_EQ(0u, numSpaces - index.hidden(GridFilterIndex::Level::Row).count());
+}
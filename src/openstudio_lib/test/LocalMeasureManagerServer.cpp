@@ -0,0 +1,155 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "LocalMeasureManagerServer.hpp"
+
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <algorithm>
+
+LocalMeasureManagerServer::LocalMeasureManagerServer(int latencyMs)
+  : m_server(new QTcpServer()),
+    m_argumentsReply("{\"arguments\": []}"),
+    m_latencyMs(latencyMs),
+    m_requestCount(0),
+    m_concurrentRequests(0),
+    m_maxConcurrentRequests(0) {
+  QObject::connect(m_server, &QTcpServer::newConnection, [this]() { onNewConnection(); });
+
+  m_server->moveToThread(&m_thread);
+  m_thread.start();
+}
+
+LocalMeasureManagerServer::~LocalMeasureManagerServer() {
+  // Sockets are children of the server
+  QMetaObject::invokeMethod(m_server, [this]() { delete m_server; }, Qt::BlockingQueuedConnection);
+
+  m_thread.quit();
+  m_thread.wait();
+}
+
+bool LocalMeasureManagerServer::listen() {
+  bool result = false;
+  QMetaObject::invokeMethod(m_server, [this, &result]() { result = m_server->listen(QHostAddress::LocalHost); }, Qt::BlockingQueuedConnection);
+  return result;
+}
+
+QUrl LocalMeasureManagerServer::url() const {
+  quint16 port = 0;
+  QMetaObject::invokeMethod(m_server, [this, &port]() { port = m_server->serverPort(); }, Qt::BlockingQueuedConnection);
+
+  QUrl result;
+  result.setScheme("http");
+  result.setHost("127.0.0.1");
+  result.setPort(port);
+  return result;
+}
+
+void LocalMeasureManagerServer::setArgumentsReply(const QByteArray& json) {
+  m_argumentsReply = json;
+}
+
+int LocalMeasureManagerServer::requestCount() const {
+  return m_requestCount;
+}
+
+int LocalMeasureManagerServer::maxConcurrentRequests() const {
+  return m_maxConcurrentRequests;
+}
+
+void LocalMeasureManagerServer::onNewConnection() {
+  while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+    m_buffers[socket] = QByteArray();
+    QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { onReadyRead(socket); });
+    QObject::connect(socket, &QTcpSocket::disconnected, [this, socket]() {
+      m_buffers.erase(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void LocalMeasureManagerServer::onReadyRead(QTcpSocket* socket) {
+  QByteArray& buffer = m_buffers[socket];
+  buffer.append(socket->readAll());
+
+  // Several (pipelined) requests may be in the buffer
+  while (true) {
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+      return;
+    }
+
+    QByteArray header = buffer.left(headerEnd);
+    int contentLength = 0;
+    for (const QByteArray& line : header.split('\n')) {
+      if (line.toLower().startsWith("content-length:")) {
+        contentLength = line.mid(line.indexOf(':') + 1).trimmed().toInt();
+      }
+    }
+
+    int requestSize = headerEnd + 4 + contentLength;
+    if (buffer.size() < requestSize) {
+      return;
+    }
+
+    // Request line is "METHOD /path HTTP/1.1"
+    QList<QByteArray> requestLine = header.left(header.indexOf("\r\n")).split(' ');
+    QByteArray path = requestLine.size() > 1 ? requestLine[1] : QByteArray("/");
+    buffer.remove(0, requestSize);
+
+    ++m_requestCount;
+    ++m_concurrentRequests;
+    m_maxConcurrentRequests = std::max(m_maxConcurrentRequests.load(), m_concurrentRequests.load());
+
+    QTimer::singleShot(m_latencyMs, socket, [this, socket, path]() { reply(socket, path); });
+  }
+}
+
+void LocalMeasureManagerServer::reply(QTcpSocket* socket, const QByteArray& path) {
+  --m_concurrentRequests;
+
+  QByteArray body;
+  if (path == "/") {
+    body = "{\"status\": \"running\"}";
+  } else if (path == "/compute_arguments") {
+    body = m_argumentsReply;
+  } else {
+    body = "{}";
+  }
+
+  QByteArray response = "HTTP/1.1 200 OK\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Connection: keep-alive\r\n"
+                        "Content-Length: "
+                        + QByteArray::number(body.size()) + "\r\n\r\n" + body;
+  socket->write(response);
+}
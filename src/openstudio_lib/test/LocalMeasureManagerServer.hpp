@@ -0,0 +1,86 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef OPENSTUDIO_TEST_LOCALMEASUREMANAGERSERVER_HPP
+#define OPENSTUDIO_TEST_LOCALMEASUREMANAGERSERVER_HPP
+
+#include <QByteArray>
+#include <QThread>
+#include <QUrl>
+
+#include <atomic>
+#include <map>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Minimal stand-in for the measure manager server, used to measure the latency and throughput of the client in tests.
+// It speaks just enough HTTP/1.1 (keep-alive, Content-Length bodies) and answers every request after a fixed latency,
+// without blocking, so concurrent requests overlap like they would with the real server.
+// It runs in its own thread, like the real server runs in its own process, so it keeps answering while the test thread
+// is blocked on a synchronous request.
+class LocalMeasureManagerServer
+{
+ public:
+  explicit LocalMeasureManagerServer(int latencyMs = 0);
+
+  ~LocalMeasureManagerServer();
+
+  // Listen on a free port of the loopback interface
+  bool listen();
+
+  QUrl url() const;
+
+  // Body returned for POST /compute_arguments, to be set before sending requests
+  void setArgumentsReply(const QByteArray& json);
+
+  int requestCount() const;
+
+  // Highest number of requests the server was handling at the same time
+  int maxConcurrentRequests() const;
+
+ private:
+  void onNewConnection();
+
+  void onReadyRead(QTcpSocket* socket);
+
+  void reply(QTcpSocket* socket, const QByteArray& path);
+
+  QThread m_thread;
+  // Lives in m_thread, along with its sockets
+  QTcpServer* m_server;
+  std::map<QTcpSocket*, QByteArray> m_buffers;
+  QByteArray m_argumentsReply;
+  int m_latencyMs;
+  std::atomic<int> m_requestCount;
+  std::atomic<int> m_concurrentRequests;
+  std::atomic<int> m_maxConcurrentRequests;
+};
+
+#endif  // OPENSTUDIO_TEST_LOCALMEASUREMANAGERSERVER_HPP
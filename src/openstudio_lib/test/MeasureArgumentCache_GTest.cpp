@@ -0,0 +1,97 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../../shared_gui_components/MeasureArgumentCache.hpp"
+#include "../../model_editor/Utilities.hpp"
+
+#include <openstudio/utilities/bcl/BCLMeasure.hpp>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, MeasureArgumentCache) {
+  QTemporaryDir tempDir;
+  ASSERT_TRUE(tempDir.isValid());
+
+  openstudio::path cacheDir = toPath(tempDir.path()) / toPath("cache");
+  openstudio::path measureDir = toPath(tempDir.path()) / toPath("my_measure");
+  BCLMeasure measure("My Measure", "MyMeasure", measureDir, "Envelope.Opaque", MeasureType::ModelMeasure, "Description", "Modeler Description");
+
+  const std::string replyA = R"({"arguments": [{"name": "zone_count", "type": "Integer", "default_value": 3}]})";
+  const std::string replyB = R"({"arguments": [{"name": "zone_count", "type": "Integer", "default_value": 5}]})";
+
+  {
+    MeasureArgumentCache cache(cacheDir);
+    EXPECT_FALSE(cache.find(measure, "model_a"));
+
+    cache.insert(measure, "model_a", replyA);
+    ASSERT_TRUE(cache.find(measure, "model_a"));
+    EXPECT_EQ(replyA, cache.find(measure, "model_a").get());
+    EXPECT_FALSE(cache.find(measure, "model_b"));
+
+    // Defaults computed from the model can coincide on two models, that says nothing about a third one
+    cache.insert(measure, "model_b", replyA);
+    EXPECT_FALSE(cache.find(measure, "model_c"));
+  }
+
+  {
+    // Persisted across sessions
+    MeasureArgumentCache cache(cacheDir);
+    ASSERT_TRUE(cache.find(measure, "model_b"));
+    EXPECT_EQ(replyA, cache.find(measure, "model_b").get());
+    EXPECT_FALSE(cache.find(measure, "model_c"));
+
+    // Computing again for a model replaces its reply only
+    cache.insert(measure, "model_b", replyB);
+    EXPECT_EQ(replyA, cache.find(measure, "model_a").get());
+    EXPECT_EQ(replyB, cache.find(measure, "model_b").get());
+
+    cache.invalidate(measureDir);
+    EXPECT_FALSE(cache.find(measure, "model_a"));
+    EXPECT_FALSE(cache.find(measure, "model_b"));
+
+    cache.insert(measure, "model_a", replyA);
+  }
+
+  // Editing the measure invalidates its arguments
+  QFile script(toQString(measureDir / toPath("measure.rb")));
+  ASSERT_TRUE(script.open(QIODevice::Append));
+  script.write("\n# edited\n");
+  script.close();
+
+  MeasureArgumentCache cache(cacheDir);
+  EXPECT_FALSE(cache.find(measure, "model_a"));
+  EXPECT_FALSE(cache.find(measure, "model_c"));
+}
@@ -0,0 +1,127 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+#include "LocalMeasureManagerServer.hpp"
+
+#include "../../shared_gui_components/MeasureManager.hpp"
+#include "../../shared_gui_components/MeasureManagerClient.hpp"
+
+#include <QEventLoop>
+#include <QTimer>
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, MeasureManagerClient_ConcurrentRequests) {
+  const int latencyMs = 100;
+  const int numRequests = 20;
+
+  LocalMeasureManagerServer server(latencyMs);
+  ASSERT_TRUE(server.listen());
+
+  MeasureManagerClient client;
+  client.setUrl(server.url());
+
+  int numSucceeded = 0;
+  for (int i = 0; i < numRequests; ++i) {
+    QByteArray data = "{\"measure_dir\": \"measure_" + QByteArray::number(i) + "\", \"osm_path\": \"in.osm\"}";
+    client.post("/compute_arguments", data, [&numSucceeded](bool t_success, const QByteArray&) {
+      if (t_success) {
+        ++numSucceeded;
+      }
+    });
+  }
+
+  // Sending requests does not wait for any of them
+  EXPECT_EQ(numRequests, client.pendingRequests());
+
+  QEventLoop loop;
+  QObject::connect(&client, &MeasureManagerClient::allFinished, &loop, &QEventLoop::quit);
+  QTimer::singleShot(10 * numRequests * latencyMs, &loop, &QEventLoop::quit);
+  loop.exec();
+
+  EXPECT_EQ(0, client.pendingRequests());
+  EXPECT_EQ(numRequests, numSucceeded);
+  EXPECT_EQ(numRequests, server.requestCount());
+
+  // Requests overlap instead of being sent one after the other
+  EXPECT_LT(1, server.maxConcurrentRequests());
+}
+
+TEST_F(OpenStudioLibFixture, MeasureManager_LocalServer) {
+  LocalMeasureManagerServer server(10);
+  ASSERT_TRUE(server.listen());
+
+  MeasureManager measureManager(nullptr);
+  measureManager.setUrl(server.url());
+
+  // Both block this thread, the server answers from its own
+  EXPECT_TRUE(measureManager.waitForStarted(1000));
+  EXPECT_TRUE(measureManager.isStarted());
+  EXPECT_TRUE(measureManager.reset());
+
+  EXPECT_EQ(2, server.requestCount());
+}
+
+TEST_F(OpenStudioLibFixture, MeasureManagerClient_Wait) {
+  LocalMeasureManagerServer server(10);
+  server.setArgumentsReply("{\"arguments\": [1]}");
+  ASSERT_TRUE(server.listen());
+
+  MeasureManagerClient client;
+  client.setUrl(server.url());
+
+  MeasureManagerClient::Result result = client.postAndWait("/compute_arguments", "{}");
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ(QByteArray("{\"arguments\": [1]}"), result.body);
+
+  // Goes through the same network access manager as the asynchronous requests
+  bool asyncSucceeded = false;
+  client.get("/", [&asyncSucceeded](bool t_success, const QByteArray&) { asyncSucceeded = t_success; });
+  EXPECT_TRUE(client.getAndWait("/").success);
+
+  QEventLoop loop;
+  QObject::connect(&client, &MeasureManagerClient::allFinished, &loop, &QEventLoop::quit);
+  QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+  if (client.pendingRequests() > 0) {
+    loop.exec();
+  }
+
+  EXPECT_TRUE(asyncSucceeded);
+  EXPECT_EQ(0, client.pendingRequests());
+  EXPECT_EQ(3, server.requestCount());
+
+  // Nothing listens there anymore
+  QUrl url = server.url();
+  url.setPort(1);
+  client.setUrl(url);
+  EXPECT_FALSE(client.getAndWait("/").success);
+}
@@ -0,0 +1,323 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../SpacesSpacesGridView.hpp"
+#include "../../shared_gui_components/OSGridController.hpp"
+#include "../../shared_gui_components/OSGridView.hpp"
+#include "../../model_editor/Application.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Space.hpp>
+
+#include <QPointer>
+#include <QProgressDialog>
+#include <QScrollArea>
+#include <QScrollBar>
+
+#include <set>
+
+using namespace openstudio;
+
+// Adds one space to a grid of numSpaces spaces, returns the number of cells built by the refresh that follows
+static int addOneSpace(int numSpaces) {
+  model::Model model;
+  for (int i = 0; i < numSpaces; ++i) {
+    model::Space space(model);
+  }
+
+  SpacesSpacesGridView spacesView(true, model);
+  spacesView.show();
+  Application::instance().processEvents();
+
+  auto gridView = spacesView.findChild<OSGridView*>();
+  EXPECT_TRUE(gridView);
+  if (!gridView) {
+    return -1;
+  }
+
+  // The initial refresh builds every row
+  EXPECT_LT(numSpaces, gridView->lastRefreshCellCount());
+
+  model::Space space(model);
+  // One turn for the model change bus to deliver the addition, one for the grid view to refresh
+  Application::instance().processEvents();
+  Application::instance().processEvents();
+
+  return gridView->lastRefreshCellCount();
+}
+
+TEST_F(OpenStudioLibFixture, OSGridView_IncrementalRefresh) {
+  int smallCells = addOneSpace(50);
+  int largeCells = addOneSpace(1000);
+
+  // Only the new row is built, regardless of the size of the grid
+  EXPECT_LT(0, smallCells);
+  EXPECT_EQ(smallCells, largeCells);
+}
+
+// Rows of the grid that currently have widgets, the header row excluded
+static std::set<int> rowsWithWidgets(OSGridController* gridController) {
+  std::set<int> result;
+  auto objectSelector = gridController->getObjectSelector();
+  for (int row = 1; row < gridController->rowCount(); ++row) {
+    for (int column = 0; column < gridController->columnCount(); ++column) {
+      if (objectSelector->getWidget(row, column, boost::none)) {
+        result.insert(row);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+TEST_F(OpenStudioLibFixture, OSGridView_Virtualized) {
+  const int numSpaces = 1000;
+
+  model::Model model;
+  for (int i = 0; i < numSpaces; ++i) {
+    model::Space space(model);
+  }
+
+  SpacesSpacesGridView spacesView(true, model);
+  spacesView.resize(800, 600);
+  spacesView.show();
+
+  auto gridView = spacesView.findChild<OSGridView*>();
+  ASSERT_TRUE(gridView);
+  auto gridController = gridView->findChild<OSGridController*>();
+  ASSERT_TRUE(gridController);
+
+  QScrollArea* scrollArea = nullptr;
+  for (QWidget* widget = gridView->parentWidget(); widget && !scrollArea; widget = widget->parentWidget()) {
+    scrollArea = qobject_cast<QScrollArea*>(widget);
+  }
+  ASSERT_TRUE(scrollArea);
+
+  // The refresh, then the pass that matches the pages to the viewport once they are laid out
+  gridView->setVirtualized(true);
+  for (int i = 0; i < 5; ++i) {
+    Application::instance().processEvents();
+  }
+
+  EXPECT_EQ(numSpaces + 1, gridController->rowCount());
+  EXPECT_LT(0, gridView->lastRefreshCellCount());
+  EXPECT_GT(numSpaces, gridView->lastRefreshCellCount());
+
+  // Only the pages around the top of the grid have widgets
+  auto rows = rowsWithWidgets(gridController);
+  ASSERT_FALSE(rows.empty());
+  EXPECT_EQ(1, *rows.begin());
+  EXPECT_GT(numSpaces / 2, static_cast<int>(rows.size()));
+  EXPECT_EQ(0u, rows.count(numSpaces));
+
+  // Every row stays selectable
+  gridController->getObjectSelector()->selectAll();
+  EXPECT_EQ(static_cast<size_t>(numSpaces), gridController->getObjectSelector()->getSelectedObjects().size());
+  gridController->getObjectSelector()->clearSelection();
+
+  // Scrolling to the bottom builds the last rows and releases the first ones
+  scrollArea->verticalScrollBar()->setValue(scrollArea->verticalScrollBar()->maximum());
+  for (int i = 0; i < 5; ++i) {
+    Application::instance().processEvents();
+  }
+
+  rows = rowsWithWidgets(gridController);
+  ASSERT_FALSE(rows.empty());
+  EXPECT_EQ(1u, rows.count(numSpaces));
+  EXPECT_EQ(0u, rows.count(numSpaces / 2 - 250));
+  EXPECT_GT(numSpaces / 2, static_cast<int>(rows.size()));
+}
+
+TEST_F(OpenStudioLibFixture, OSGridController_ApplyToObjectsCanceled) {
+  const size_t numSpaces = 2 * OSGridController::BULK_EDIT_CHUNK_SIZE + 50;
+
+  model::Model model;
+  for (size_t i = 0; i < numSpaces; ++i) {
+    model::Space space(model);
+  }
+
+  SpacesSpacesGridView spacesView(true, model);
+  spacesView.show();
+  Application::instance().processEvents();
+
+  auto gridView = spacesView.findChild<OSGridView*>();
+  ASSERT_TRUE(gridView);
+  auto gridController = gridView->findChild<OSGridController*>();
+  ASSERT_TRUE(gridController);
+
+  auto spaces = model.getConcreteModelObjects<model::Space>();
+  std::set<model::ModelObject> objects(spaces.begin(), spaces.end());
+  gridController->applyToObjects(objects, [](const model::ModelObject& modelObject) {
+    modelObject.cast<model::Space>().setPartofTotalFloorArea(false);
+  });
+
+  auto countApplied = [&model]() {
+    size_t result = 0;
+    for (const auto& space : model.getConcreteModelObjects<model::Space>()) {
+      if (!space.partofTotalFloorArea()) {
+        ++result;
+      }
+    }
+    return result;
+  };
+
+  // The first chunk is applied right away, the rest waits for the event loop
+  EXPECT_EQ(OSGridController::BULK_EDIT_CHUNK_SIZE, countApplied());
+  EXPECT_FALSE(gridView->updatesEnabled());
+
+  // The progress dialog must not inherit the disabled updates of the grid
+  QPointer<QProgressDialog> progress = spacesView.findChild<QProgressDialog*>();
+  ASSERT_TRUE(progress);
+  EXPECT_TRUE(progress->updatesEnabled());
+
+  progress->cancel();
+  Application::instance().processEvents();
+
+  // The remaining objects are left untouched
+  EXPECT_EQ(OSGridController::BULK_EDIT_CHUNK_SIZE, countApplied());
+  EXPECT_TRUE(gridView->updatesEnabled());
+
+  // Without cancel, every chunk is applied
+  gridController->applyToObjects(objects, [](const model::ModelObject& modelObject) {
+    modelObject.cast<model::Space>().setPartofTotalFloorArea(false);
+  });
+  for (int i = 0; i < 10; ++i) {
+    Application::instance().processEvents();
+  }
+  EXPECT_EQ(numSpaces, countApplied());
+  EXPECT_TRUE(gridView->updatesEnabled());
+}
+
+// Checks the widgets and row registered for every space, nullptr holders stand for removed ones
+static void expectLookups(ObjectSelector& selector, const std::vector<model::Space>& spaces, const std::vector<std::vector<Holder*>>& holders) {
+  for (size_t row = 0; row < spaces.size(); ++row) {
+    bool hasWidgets = false;
+    for (size_t column = 0; column < holders[row].size(); ++column) {
+      Holder* holder = holders[row][column];
+      if (holder) {
+        hasWidgets = true;
+        EXPECT_EQ(holder->widget, selector.getWidget(static_cast<int>(row), static_cast<int>(column), boost::none));
+        auto object = selector.getObject(static_cast<int>(row), static_cast<int>(column), boost::none);
+        ASSERT_TRUE(object);
+        EXPECT_EQ(spaces[row], object.get());
+      } else {
+        EXPECT_FALSE(selector.getWidget(static_cast<int>(row), static_cast<int>(column), boost::none));
+        EXPECT_FALSE(selector.getObject(static_cast<int>(row), static_cast<int>(column), boost::none));
+      }
+    }
+    if (hasWidgets) {
+      ASSERT_TRUE(selector.getRow(spaces[row]));
+      EXPECT_EQ(static_cast<int>(row), selector.getRow(spaces[row]).get());
+    } else {
+      EXPECT_FALSE(selector.getRow(spaces[row]));
+    }
+  }
+}
+
+TEST_F(OpenStudioLibFixture, ObjectSelector_Bookkeeping) {
+  const int numColumns = 4;
+
+  model::Model model;
+  for (int i = 0; i < 10; ++i) {
+    model::Space space(model);
+  }
+  std::vector<model::Space> spaces = model.getConcreteModelObjects<model::Space>();
+
+  ObjectSelector selector(nullptr);
+  auto container = new QWidget();
+  std::vector<std::vector<Holder*>> holders(spaces.size());
+  for (size_t row = 0; row < spaces.size(); ++row) {
+    for (int column = 0; column < numColumns; ++column) {
+      auto holder = new Holder(container);
+      holder->widget = new QWidget(holder);
+      selector.addWidget(spaces[row], holder, static_cast<int>(row), column, boost::none, column == 0);
+      holders[row].push_back(holder);
+    }
+    selector.m_selectedObjects.insert(spaces[row]);
+  }
+  expectLookups(selector, spaces, holders);
+
+  auto selectedWidgets = [&selector](int column) {
+    auto widgets = selector.getColumnsSelectedWidgets(column);
+    return std::set<QWidget*>(widgets.begin(), widgets.end());
+  };
+
+  std::set<QWidget*> expected;
+  for (const auto& rowHolders : holders) {
+    expected.insert(rowHolders[1]->widget);
+  }
+  EXPECT_EQ(expected, selectedWidgets(1));
+
+  // Deleting a cell in the middle of a row leaves the other cells of the row and of the object
+  delete holders[3][1];
+  holders[3][1] = nullptr;
+  expectLookups(selector, spaces, holders);
+
+  // Deleting every cell of a row forgets the row of its object
+  for (auto& holder : holders[5]) {
+    delete holder;
+    holder = nullptr;
+  }
+  expectLookups(selector, spaces, holders);
+
+  // A removed object keeps its holders until the grid is refreshed, but they are no longer tracked
+  selector.objectRemoved(spaces[7]);
+  for (auto& holder : holders[7]) {
+    holder = nullptr;
+  }
+  expectLookups(selector, spaces, holders);
+
+  expected.clear();
+  for (size_t row = 0; row < spaces.size(); ++row) {
+    if (row != 5 && row != 7) {
+      expected.insert(holders[row][2]->widget);
+    }
+  }
+  EXPECT_EQ(expected, selectedWidgets(2));
+
+  // Widgets added back to a row are found again
+  for (int column = 0; column < numColumns; ++column) {
+    auto holder = new Holder(container);
+    holder->widget = new QWidget(holder);
+    selector.addWidget(spaces[5], holder, 5, column, boost::none, column == 0);
+    holders[5][column] = holder;
+  }
+  expectLookups(selector, spaces, holders);
+  expected.insert(holders[5][2]->widget);
+  EXPECT_EQ(expected, selectedWidgets(2));
+
+  delete container;
+  for (const auto& space : spaces) {
+    EXPECT_FALSE(selector.getRow(space));
+  }
+}
@@ -0,0 +1,70 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../RunProgressParser.hpp"
+
+using namespace openstudio;
+
+TEST_F(OpenStudioLibFixture, RunProgressParser) {
+  RunProgressParser parser;
+
+  // a line split across reads is only parsed once complete
+  std::vector<RunProgressParser::Event> events = parser.feed("Started\nStarting state ini");
+  EXPECT_TRUE(events.empty());
+
+  events = parser.feed("tialization\r\nReturned from state initialization\nApplying Set Window To Wall Ratio\nApplied\n");
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(RunProgressParser::State::initialization, events[0].state);
+  EXPECT_EQ(RunProgressParser::Style::Heading, events[0].style);
+  EXPECT_EQ(QString("Initializing workflow."), events[0].text);
+  EXPECT_EQ(RunProgressParser::State::stopped, events[1].state);
+  EXPECT_EQ(RunProgressParser::Style::Subheading, events[1].style);
+  EXPECT_EQ(QString("Applying Set Window To Wall Ratio"), events[1].text);
+
+  // multi-byte characters split across reads are decoded once the line is complete
+  QByteArray measureOutput = QString::fromUtf8("Zone \xC3\xA9tage 1").toUtf8();
+  events = parser.feed(measureOutput.left(6));
+  EXPECT_TRUE(events.empty());
+  events = parser.feed(measureOutput.mid(6) + "\nSTARTING STATE SIMULATION\n");
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(RunProgressParser::Style::Normal, events[0].style);
+  EXPECT_EQ(QString::fromUtf8("Zone \xC3\xA9tage 1"), events[0].text);
+  EXPECT_EQ(RunProgressParser::State::simulation, events[1].state);
+
+  // an unterminated last line is parsed when the run finishes
+  EXPECT_TRUE(parser.feed("Failure").empty());
+  events = parser.finish();
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(RunProgressParser::Style::Error, events[0].style);
+  EXPECT_EQ(QString("Failed."), events[0].text);
+}
@@ -0,0 +1,211 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "OpenStudioLibFixture.hpp"
+
+#include "../RunQueue.hpp"
+#include "../../model_editor/Application.hpp"
+#include "../../model_editor/Utilities.hpp"
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/Space.hpp>
+#include <openstudio/utilities/filetypes/WorkflowJSON.hpp>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <map>
+
+using namespace openstudio;
+
+// Writes a workflow with a seed model in directory
+static openstudio::path saveWorkflow(const openstudio::path& directory) {
+  openstudio::filesystem::create_directories(directory);
+
+  model::Model model;
+  model::Space space(model);
+  EXPECT_TRUE(model.save(directory / toPath("seed.osm"), true));
+
+  WorkflowJSON workflow;
+  workflow.setSeedFile(toPath("seed.osm"));
+  workflow.addMeasurePath(toPath("measures"));
+  openstudio::path result = directory / toPath("workflow.osw");
+  EXPECT_TRUE(workflow.saveAs(result));
+  return result;
+}
+
+TEST_F(OpenStudioLibFixture, RunQueue_PrepareWorkflow) {
+  QTemporaryDir tempDir;
+  ASSERT_TRUE(tempDir.isValid());
+
+  openstudio::path originalDir = toPath(tempDir.filePath("original"));
+  openstudio::path workflowPath = saveWorkflow(originalDir);
+  openstudio::path weatherFile = toPath(tempDir.filePath("weather.epw"));
+
+  openstudio::path runDir1 = toPath(tempDir.filePath("run_1"));
+  openstudio::path runDir2 = toPath(tempDir.filePath("run_2"));
+  boost::optional<openstudio::path> prepared1 = RunQueue::prepareWorkflow(workflowPath, runDir1, boost::none);
+  boost::optional<openstudio::path> prepared2 = RunQueue::prepareWorkflow(workflowPath, runDir2, weatherFile);
+  ASSERT_TRUE(prepared1);
+  ASSERT_TRUE(prepared2);
+  EXPECT_EQ(runDir1 / toPath("workflow.osw"), *prepared1);
+  EXPECT_EQ(runDir2 / toPath("workflow.osw"), *prepared2);
+
+  // Each copy has its own seed model, later changes to the original do not reach it
+  boost::optional<WorkflowJSON> workflow1 = WorkflowJSON::load(*prepared1);
+  ASSERT_TRUE(workflow1);
+  ASSERT_TRUE(workflow1->seedFile());
+  EXPECT_EQ(runDir1 / toPath("seed.osm"), *workflow1->seedFile());
+  EXPECT_TRUE(openstudio::filesystem::exists(runDir1 / toPath("seed.osm")));
+  EXPECT_TRUE(openstudio::filesystem::exists(runDir2 / toPath("seed.osm")));
+
+  model::Model changed;
+  model::Space space1(changed);
+  model::Space space2(changed);
+  ASSERT_TRUE(changed.save(originalDir / toPath("seed.osm"), true));
+  boost::optional<model::Model> seed1 = model::Model::load(runDir1 / toPath("seed.osm"));
+  ASSERT_TRUE(seed1);
+  EXPECT_EQ(1u, seed1->getConcreteModelObjects<model::Space>().size());
+
+  // Paths relative to the original workflow still resolve from the copy
+  std::vector<openstudio::path> measurePaths = workflow1->measurePaths();
+  ASSERT_EQ(1u, measurePaths.size());
+  EXPECT_EQ(originalDir / toPath("measures"), measurePaths[0]);
+
+  EXPECT_FALSE(workflow1->weatherFile());
+  boost::optional<WorkflowJSON> workflow2 = WorkflowJSON::load(*prepared2);
+  ASSERT_TRUE(workflow2);
+  ASSERT_TRUE(workflow2->weatherFile());
+  EXPECT_EQ(weatherFile, *workflow2->weatherFile());
+
+  // A workflow that does not exist is not copied
+  EXPECT_FALSE(RunQueue::prepareWorkflow(toPath(tempDir.filePath("missing.osw")), toPath(tempDir.filePath("run_3")), boost::none));
+}
+
+// Writes a program standing in for the CLI: it records the run server port it was given next to its workflow, then
+// waits a bit so that the jobs overlap
+static QString saveFakeCli(const QTemporaryDir& tempDir) {
+#ifdef Q_OS_WIN
+  QString result = tempDir.filePath("fake_cli.cmd");
+  QFile file(result);
+  EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Text));
+  QTextStream stream(&file);
+  stream << "@echo off\n"
+         << "echo %3> \"%~dp5port\"\n"
+         << "ping -n 2 127.0.0.1 > nul\n";
+#else
+  QString result = tempDir.filePath("fake_cli.sh");
+  QFile file(result);
+  EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Text));
+  QTextStream stream(&file);
+  stream << "#!/bin/sh\n"
+         << "echo \"$3\" > \"$(dirname \"$5\")/port\"\n"
+         << "sleep 1\n";
+#endif
+  stream.flush();
+  file.close();
+  file.setPermissions(file.permissions() | QFileDevice::ExeOwner);
+  return result;
+}
+
+TEST_F(OpenStudioLibFixture, RunQueue_MaxJobs) {
+  QTemporaryDir tempDir;
+  ASSERT_TRUE(tempDir.isValid());
+
+  const int numJobs = 5;
+  const int maxJobs = 2;
+
+  std::vector<openstudio::path> runDirs;
+  std::vector<openstudio::path> workflowPaths;
+  openstudio::path workflowPath = saveWorkflow(toPath(tempDir.filePath("original")));
+  for (int i = 0; i < numJobs; ++i) {
+    runDirs.push_back(toPath(tempDir.filePath(QString("run_%1").arg(i))));
+    boost::optional<openstudio::path> prepared = RunQueue::prepareWorkflow(workflowPath, runDirs.back(), boost::none);
+    ASSERT_TRUE(prepared);
+    workflowPaths.push_back(*prepared);
+  }
+
+  RunQueue queue(saveFakeCli(tempDir), QProcessEnvironment::systemEnvironment());
+  queue.setMaxJobs(maxJobs);
+  EXPECT_EQ(maxJobs, queue.maxJobs());
+
+  int maxActive = 0;
+  int done = 0;
+  std::map<int, RunQueue::JobStatus> statuses;
+  QObject::connect(&queue, &RunQueue::jobStatusChanged, [&](int id, RunQueue::JobStatus status) {
+    statuses[id] = status;
+    maxActive = std::max(maxActive, queue.activeJobCount());
+    if (status == RunQueue::JobStatus::Succeeded || status == RunQueue::JobStatus::Failed || status == RunQueue::JobStatus::Canceled) {
+      ++done;
+    }
+  });
+
+  std::vector<int> ids;
+  for (int i = 0; i < numJobs; ++i) {
+    ids.push_back(queue.addJob(QString("run %1").arg(i), workflowPaths[i]));
+  }
+
+  // The first jobs start right away, the others wait for a slot
+  EXPECT_EQ(maxJobs, queue.activeJobCount());
+  EXPECT_EQ(RunQueue::JobStatus::Starting, queue.status(ids[0]));
+  EXPECT_EQ(RunQueue::JobStatus::Starting, queue.status(ids[1]));
+  EXPECT_EQ(RunQueue::JobStatus::Queued, queue.status(ids[2]));
+
+  QElapsedTimer timer;
+  timer.start();
+  while (done < numJobs && timer.elapsed() < 60000) {
+    Application::instance().processEvents();
+    QThread::msleep(10);
+  }
+
+  ASSERT_EQ(numJobs, done);
+  EXPECT_EQ(maxJobs, maxActive);
+  EXPECT_EQ(0, queue.activeJobCount());
+
+  // Each job ran in its own directory and was given its own run server
+  std::vector<int> ports;
+  for (int i = 0; i < numJobs; ++i) {
+    EXPECT_EQ(RunQueue::JobStatus::Succeeded, statuses[ids[i]]);
+    EXPECT_EQ(runDirs[i], queue.jobDirectory(ids[i]));
+
+    QFile portFile(toQString(runDirs[i] / toPath("port")));
+    ASSERT_TRUE(portFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    ports.push_back(QString::fromUtf8(portFile.readAll()).trimmed().toInt());
+    EXPECT_LT(0, ports.back());
+  }
+
+  // A port can only be reused once the job that had it is done, the jobs running together have different ones
+  EXPECT_NE(ports[0], ports[1]);
+}
@@ -0,0 +1,302 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "BCLDownloadManager.hpp"
+
+#include <openstudio/utilities/core/Filesystem.hpp>
+
+#include <QDateTime>
+#include <QFutureInterface>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace openstudio {
+
+namespace {
+
+// search pages are kept this long, new components do not show up before
+constexpr int SEARCHCACHESECS = 600;
+
+struct CachedSearchPage
+{
+  BCLSearchPage page;
+  QDateTime time;
+};
+
+using SearchKey = std::tuple<std::string, std::string, int, int>;
+
+QMutex searchCacheMutex;
+
+std::map<SearchKey, CachedSearchPage>& searchCache() {
+  static std::map<SearchKey, CachedSearchPage> result;
+  return result;
+}
+
+uintmax_t directorySize(const openstudio::path& directory) {
+  uintmax_t result = 0;
+  try {
+    for (openstudio::filesystem::recursive_directory_iterator it(directory), end; it != end; ++it) {
+      if (openstudio::filesystem::is_regular_file(it->path())) {
+        result += openstudio::filesystem::file_size(it->path());
+      }
+    }
+  } catch (const std::exception&) {
+  }
+  return result;
+}
+
+}  // namespace
+
+BCLDownloadManager::BCLDownloadManager(QObject* parent) : QObject(parent), m_maxDownloads(defaultMaxDownloads()) {}
+
+BCLDownloadManager::~BCLDownloadManager() {}
+
+int BCLDownloadManager::defaultMaxDownloads() {
+  return 4;
+}
+
+int BCLDownloadManager::maxDownloads() const {
+  return m_maxDownloads;
+}
+
+void BCLDownloadManager::setMaxDownloads(int maxDownloads) {
+  m_maxDownloads = std::max(1, maxDownloads);
+  startDownloads();
+}
+
+bool BCLDownloadManager::download(const std::string& uid, DownloadType type) {
+  auto isUid = [&uid](const Download& download) { return download.uid == uid; };
+  if (std::any_of(m_queue.begin(), m_queue.end(), isUid)) {
+    return false;
+  }
+  for (const Worker& worker : m_workers) {
+    if (worker.download && isUid(*worker.download)) {
+      return false;
+    }
+  }
+
+  if (pendingCount() == 0) {
+    m_finishedCount = 0;
+    m_requestedCount = 0;
+    m_bytes = 0;
+    m_elapsed.start();
+  }
+
+  m_queue.push_back(Download{uid, type});
+  ++m_requestedCount;
+
+  startDownloads();
+  emitProgress();
+
+  return true;
+}
+
+int BCLDownloadManager::pendingCount() const {
+  return m_requestedCount - m_finishedCount;
+}
+
+int BCLDownloadManager::finishedCount() const {
+  return m_finishedCount;
+}
+
+int BCLDownloadManager::requestedCount() const {
+  return m_requestedCount;
+}
+
+double BCLDownloadManager::bytesPerSecond() const {
+  if (!m_elapsed.isValid() || m_elapsed.elapsed() <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(m_bytes) * 1000.0 / static_cast<double>(m_elapsed.elapsed());
+}
+
+QFuture<BCLSearchPage> BCLDownloadManager::search(const std::string& filterType, const std::string& searchString, int tid, int pageIdx) {
+  SearchKey key(filterType, searchString, tid, pageIdx);
+
+  {
+    QMutexLocker locker(&searchCacheMutex);
+    auto it = searchCache().find(key);
+    if (it != searchCache().end()) {
+      if (it->second.time.secsTo(QDateTime::currentDateTime()) < SEARCHCACHESECS) {
+        QFutureInterface<BCLSearchPage> result;
+        result.reportStarted();
+        result.reportResult(it->second.page);
+        result.reportFinished();
+        return result.future();
+      }
+      searchCache().erase(it);
+    }
+  }
+
+  return QtConcurrent::run([key]() -> BCLSearchPage {
+    const auto& [filterType, searchString, tid, pageIdx] = key;
+
+    // network objects can't be shared across threads
+    RemoteBCL remoteBCL;
+    BCLSearchPage page;
+    if (filterType == "components") {
+      page.results = remoteBCL.searchComponentLibrary(searchString, tid, pageIdx);
+    } else if (filterType == "measures") {
+      page.results = remoteBCL.searchMeasureLibrary(searchString, tid, pageIdx);
+    }
+    page.totalResults = remoteBCL.lastTotalResults();
+    page.numPages = remoteBCL.numResultPages();
+
+    // an empty page may be a failed request, try again next time
+    if (!page.results.empty()) {
+      QMutexLocker locker(&searchCacheMutex);
+      searchCache()[key] = CachedSearchPage{page, QDateTime::currentDateTime()};
+    }
+
+    return page;
+  });
+}
+
+void BCLDownloadManager::clearSearchCache() {
+  QMutexLocker locker(&searchCacheMutex);
+  searchCache().clear();
+}
+
+bool BCLDownloadManager::startDownload(int worker, const std::string& uid, DownloadType type) {
+  if (type == DownloadType::Component) {
+    return remoteBCL(worker).downloadComponent(uid);
+  }
+  return remoteBCL(worker).downloadMeasure(uid);
+}
+
+RemoteBCL& BCLDownloadManager::remoteBCL(int worker) {
+  std::unique_ptr<RemoteBCL>& result = m_workers[worker].remoteBCL;
+  if (!result) {
+    result = std::make_unique<RemoteBCL>();
+    result->componentDownloaded.connect<BCLDownloadManager, &BCLDownloadManager::onComponentDownloaded>(this);
+    result->measureDownloaded.connect<BCLDownloadManager, &BCLDownloadManager::onMeasureDownloaded>(this);
+  }
+  return *result;
+}
+
+void BCLDownloadManager::onComponentDownloaded(const std::string& uid, const boost::optional<BCLComponent>& component) {
+  QMetaObject::invokeMethod(
+    this,
+    [this, uid, component]() {
+      boost::optional<openstudio::path> directory;
+      if (component) {
+        directory = openstudio::path(component->directory());
+      }
+      finishDownload(uid, directory);
+      emit componentDownloaded(uid, component);
+      startDownloads();
+      emitProgress();
+    },
+    Qt::QueuedConnection);
+}
+
+void BCLDownloadManager::onMeasureDownloaded(const std::string& uid, const boost::optional<BCLMeasure>& measure) {
+  QMetaObject::invokeMethod(
+    this,
+    [this, uid, measure]() {
+      boost::optional<openstudio::path> directory;
+      if (measure) {
+        directory = openstudio::path(measure->directory());
+      }
+      finishDownload(uid, directory);
+      emit measureDownloaded(uid, measure);
+      startDownloads();
+      emitProgress();
+    },
+    Qt::QueuedConnection);
+}
+
+void BCLDownloadManager::startDownloads() {
+  std::vector<Download> failed;
+
+  for (int i = 0; !m_queue.empty() && i < m_maxDownloads; ++i) {
+    if (i == static_cast<int>(m_workers.size())) {
+      m_workers.emplace_back();
+    }
+    if (m_workers[i].download) {
+      continue;
+    }
+
+    Download download = m_queue.front();
+    m_queue.pop_front();
+
+    m_workers[i].download = download;
+    if (!startDownload(i, download.uid, download.type)) {
+      LOG(Error, "Could not start downloading '" << download.uid << "'");
+      m_workers[i].download = boost::none;
+      failed.push_back(download);
+      // try the next queued download on the same worker
+      --i;
+    }
+  }
+
+  // reported later, like any download, so that callers of download() see the failure after it returns
+  for (const Download& download : failed) {
+    ++m_finishedCount;
+    QMetaObject::invokeMethod(
+      this,
+      [this, download]() {
+        if (download.type == DownloadType::Component) {
+          emit componentDownloaded(download.uid, boost::none);
+        } else {
+          emit measureDownloaded(download.uid, boost::none);
+        }
+        emitProgress();
+      },
+      Qt::QueuedConnection);
+  }
+}
+
+void BCLDownloadManager::finishDownload(const std::string& uid, const boost::optional<openstudio::path>& directory) {
+  for (Worker& worker : m_workers) {
+    if (worker.download && worker.download->uid == uid) {
+      worker.download = boost::none;
+      ++m_finishedCount;
+      if (directory) {
+        m_bytes += directorySize(*directory);
+      }
+      return;
+    }
+  }
+  LOG(Warn, "Download of '" << uid << "' finished but was not started by this manager");
+}
+
+void BCLDownloadManager::emitProgress() {
+  emit progress(m_finishedCount, m_requestedCount);
+  if (pendingCount() == 0) {
+    emit idle();
+  }
+}
+
+}  // namespace openstudio
@@ -0,0 +1,163 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef SHAREDGUICOMPONENTS_BCLDOWNLOADMANAGER_HPP
+#define SHAREDGUICOMPONENTS_BCLDOWNLOADMANAGER_HPP
+
+#include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
+#include <openstudio/utilities/bcl/BCLComponent.hpp>
+#include <openstudio/utilities/bcl/BCLMeasure.hpp>
+#include <openstudio/utilities/bcl/RemoteBCL.hpp>
+#include <openstudio/utilities/core/Logger.hpp>
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QObject>
+#include <QString>
+
+#include <boost/optional.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+// One page of BCL search results
+struct BCLSearchPage
+{
+  std::vector<BCLSearchResult> results;
+  int totalResults = 0;
+  int numPages = 0;
+};
+
+/** BCLDownloadManager downloads BCL components and measures with at most maxDownloads() at a time.
+  *
+  * Each worker keeps its RemoteBCL and reuses it for the next download it takes from the queue. The RemoteBCL
+  * signals may come from a network thread, they are forwarded to the GUI thread before componentDownloaded and
+  * measureDownloaded are emitted.
+  *
+  * search() runs a search on a worker thread, pages are cached for a few minutes and shared by all managers.
+  **/
+class BCLDownloadManager : public QObject, public Nano::Observer
+{
+  Q_OBJECT
+
+ public:
+  enum class DownloadType
+  {
+    Component,
+    Measure
+  };
+
+  explicit BCLDownloadManager(QObject* parent = nullptr);
+
+  virtual ~BCLDownloadManager();
+
+  static int defaultMaxDownloads();
+
+  int maxDownloads() const;
+
+  void setMaxDownloads(int maxDownloads);
+
+  // Queue a download, returns false if uid is already queued or downloading
+  bool download(const std::string& uid, DownloadType type);
+
+  // Downloads queued or running
+  int pendingCount() const;
+
+  // Downloads finished and requested since the manager was last idle, for progress
+  int finishedCount() const;
+  int requestedCount() const;
+
+  // Size of the finished downloads over the time since the manager was last idle
+  double bytesPerSecond() const;
+
+  // Search the remote BCL, filterType is "components" or "measures"
+  static QFuture<BCLSearchPage> search(const std::string& filterType, const std::string& searchString, int tid, int pageIdx);
+
+  static void clearSearchCache();
+
+ signals:
+
+  void componentDownloaded(const std::string& uid, const boost::optional<BCLComponent>& component);
+
+  void measureDownloaded(const std::string& uid, const boost::optional<BCLMeasure>& measure);
+
+  void progress(int finished, int requested);
+
+  void idle();
+
+ protected:
+  // Start downloading uid on worker, returns false if it could not be started
+  virtual bool startDownload(int worker, const std::string& uid, DownloadType type);
+
+  // The RemoteBCL of worker, created on first use
+  RemoteBCL& remoteBCL(int worker);
+
+  // Called from any thread when the download of uid is over
+  void onComponentDownloaded(const std::string& uid, const boost::optional<BCLComponent>& component);
+  void onMeasureDownloaded(const std::string& uid, const boost::optional<BCLMeasure>& measure);
+
+ private:
+  REGISTER_LOGGER("openstudio.BCLDownloadManager");
+
+  struct Download
+  {
+    std::string uid;
+    DownloadType type;
+  };
+
+  struct Worker
+  {
+    std::unique_ptr<RemoteBCL> remoteBCL;
+    boost::optional<Download> download;
+  };
+
+  // Start queued downloads on the free workers
+  void startDownloads();
+
+  // Free the worker of uid and account for the downloaded directory, if any
+  void finishDownload(const std::string& uid, const boost::optional<openstudio::path>& directory);
+
+  void emitProgress();
+
+  int m_maxDownloads;
+  std::deque<Download> m_queue;
+  std::vector<Worker> m_workers;
+  int m_finishedCount = 0;
+  int m_requestedCount = 0;
+  uintmax_t m_bytes = 0;
+  QElapsedTimer m_elapsed;
+};
+
+}  // namespace openstudio
+
+#endif  // SHAREDGUICOMPONENTS_BCLDOWNLOADMANAGER_HPP
@@ -64,6 +64,7 @@ BuildingComponentDialogCentralWidget::BuildingComponentDialogCentralWidget(QWidg
     m_collapsibleComponentList(nullptr),
     m_componentList(nullptr),  // TODO cruft to be removed
     m_progressBar(nullptr),
+    m_downloadManager(nullptr),
     m_pendingDownloads(std::set<std::string>()),
     m_pageIdx(0),
     m_searchString(QString()),
@@ -77,6 +78,7 @@ BuildingComponentDialogCentralWidget::BuildingComponentDialogCentralWidget(int t
     m_collapsibleComponentList(nullptr),
     m_componentList(nullptr),  // TODO cruft to be removed
     m_progressBar(nullptr),
+    m_downloadManager(nullptr),
     m_pendingDownloads(std::set<std::string>()),
     m_pageIdx(0),
     m_searchString(QString()) {
@@ -85,6 +87,13 @@ BuildingComponentDialogCentralWidget::BuildingComponentDialogCentralWidget(int t
 
 void BuildingComponentDialogCentralWidget::init() {
   createLayout();
+
+  m_downloadManager = new BCLDownloadManager(this);
+  connect(m_downloadManager, &BCLDownloadManager::componentDownloaded, this, &BuildingComponentDialogCentralWidget::componentDownloadComplete);
+  connect(m_downloadManager, &BCLDownloadManager::measureDownloaded, this, &BuildingComponentDialogCentralWidget::measureDownloadComplete);
+  connect(m_downloadManager, &BCLDownloadManager::progress, this, &BuildingComponentDialogCentralWidget::onDownloadProgress);
+
+  connect(&m_searchWatcher, &QFutureWatcher<BCLSearchPage>::finished, this, &BuildingComponentDialogCentralWidget::onSearchFinished);
 }
 
 void BuildingComponentDialogCentralWidget::createLayout() {
@@ -194,15 +203,16 @@ void BuildingComponentDialogCentralWidget::setTid(const std::string& filterType,
     delete comp;
   }
 
-  RemoteBCL remoteBCL;
-  std::vector<BCLSearchResult> responses;
-  if (filterType == "components") {
-    responses = remoteBCL.searchComponentLibrary(searchString.toStdString(), tid, pageIdx);
-  } else if (filterType == "measures") {
-    responses = remoteBCL.searchMeasureLibrary(searchString.toStdString(), tid, pageIdx);
-  }
+  m_title = title;
+
+  // the results come back in onSearchFinished, a newer search replaces this one
+  m_searchWatcher.setFuture(BCLDownloadManager::search(filterType, searchString.toStdString(), tid, pageIdx));
+}
 
-  for (const auto& response : responses) {
+void BuildingComponentDialogCentralWidget::onSearchFinished() {
+  BCLSearchPage page = m_searchWatcher.result();
+
+  for (const auto& response : page.results) {
     auto component = new Component(response);
 
     // TODO replace with a componentList owned by m_collapsibleComponentList
@@ -210,15 +220,13 @@ void BuildingComponentDialogCentralWidget::setTid(const std::string& filterType,
   }
 
   // the parent taxonomy
-  m_collapsibleComponentList->setText(title);
+  m_collapsibleComponentList->setText(m_title);
 
   // the total number of results
-  int lastTotalResults = remoteBCL.lastTotalResults();
-  m_collapsibleComponentList->setNumResults(lastTotalResults);
+  m_collapsibleComponentList->setNumResults(page.totalResults);
 
   // the number of pages of results
-  int numResultPages = remoteBCL.numResultPages();
-  m_collapsibleComponentList->setNumPages(numResultPages);
+  m_collapsibleComponentList->setNumPages(page.numPages);
 
   // make sure the header is expanded
   if (m_collapsibleComponentList->checkedCollapsibleComponent()) {
@@ -246,73 +254,44 @@ void BuildingComponentDialogCentralWidget::upperPushButtonClicked() {
 }
 
 void BuildingComponentDialogCentralWidget::lowerPushButtonClicked() {
+  BCLDownloadManager::DownloadType type;
+  if (m_filterType == "components") {
+    type = BCLDownloadManager::DownloadType::Component;
+  } else if (m_filterType == "measures") {
+    type = BCLDownloadManager::DownloadType::Measure;
+  } else {
+    return;
+  }
+
   for (Component* component : m_collapsibleComponentList->components()) {
     if (component->checkBox()->isChecked() && component->checkBox()->isEnabled()) {
-
-      auto remoteBCL = new RemoteBCL();
-
-      if (m_filterType == "components") {
-        // Connect to Nano Signal
-        remoteBCL->componentDownloaded
-          .connect<BuildingComponentDialogCentralWidget, &BuildingComponentDialogCentralWidget::componentDownloadComplete>(
-            const_cast<BuildingComponentDialogCentralWidget*>(this));
-
-        bool downloadStarted = remoteBCL->downloadComponent(component->uid());
-        if (downloadStarted) {
-
-          component->checkBox()->setEnabled(false);
-          component->msg()->setHidden(true);
-          m_pendingDownloads.insert(component->uid());
-
-          // show busy
-          m_progressBar->setValue(1);
-          m_progressBar->setMinimum(0);
-          m_progressBar->setMaximum(0);
-          m_progressBar->setVisible(true);
-
-        } else {
-
-          delete remoteBCL;
-
-          // todo: show error
-        }
-      } else if (m_filterType == "measures") {
-        // Connect to Nano Signal
-        remoteBCL->measureDownloaded.connect<BuildingComponentDialogCentralWidget, &BuildingComponentDialogCentralWidget::measureDownloadComplete>(
-          const_cast<BuildingComponentDialogCentralWidget*>(this));
-
-        bool downloadStarted = remoteBCL->downloadMeasure(component->uid());
-        if (downloadStarted) {
-
-          component->checkBox()->setEnabled(false);
-          component->msg()->setHidden(true);
-          m_pendingDownloads.insert(component->uid());
-
-          // show busy
-          m_progressBar->setValue(1);
-          m_progressBar->setMinimum(0);
-          m_progressBar->setMaximum(0);
-          m_progressBar->setVisible(true);
-
-        } else {
-
-          delete remoteBCL;
-
-          // todo: show error
-        }
+      // at most BCLDownloadManager::maxDownloads() run at a time, the others wait in its queue
+      if (m_downloadManager->download(component->uid(), type)) {
+        component->checkBox()->setEnabled(false);
+        component->msg()->setHidden(true);
+        m_pendingDownloads.insert(component->uid());
       }
     }
   }
+
+  onDownloadProgress(m_downloadManager->finishedCount(), m_downloadManager->requestedCount());
+}
+
+void BuildingComponentDialogCentralWidget::onDownloadProgress(int finished, int requested) {
+  if (m_pendingDownloads.empty()) {
+    return;
+  }
+
+  m_progressBar->setMinimum(0);
+  m_progressBar->setMaximum(requested);
+  m_progressBar->setValue(finished);
+  m_progressBar->setFormat(tr("%v of %m, %1 kB/s").arg(m_downloadManager->bytesPerSecond() / 1000.0, 0, 'f', 1));
+  m_progressBar->setVisible(true);
 }
 
 void BuildingComponentDialogCentralWidget::comboBoxIndexChanged(const QString& text) {}
 
 void BuildingComponentDialogCentralWidget::componentDownloadComplete(const std::string& uid, const boost::optional<BCLComponent>& component) {
-  QObject* sender = this->sender();
-  if (sender) {
-    sender->deleteLater();
-  }
-
   if (component) {
     // good
     // remove old component
@@ -343,11 +322,6 @@ void BuildingComponentDialogCentralWidget::componentDownloadComplete(const std::
 }
 
 void BuildingComponentDialogCentralWidget::measureDownloadComplete(const std::string& uid, const boost::optional<BCLMeasure>& measure) {
-  QObject* sender = this->sender();
-  if (sender) {
-    sender->deleteLater();
-  }
-
   if (measure) {
     // good
 
@@ -370,10 +344,9 @@ void BuildingComponentDialogCentralWidget::measureDownloadComplete(const std::st
   BaseApp* app = dynamic_cast<BaseApp*>(Application::instance().application());
   if (app) {
     if (measure) {
-      try {
-        app->measureManager().getArguments(*measure);
-      } catch (const std::exception&) {
-      }
+      // Only fills the argument cache, errors are logged by the measure manager
+      app->measureManager().getArgumentsAsync(
+        *measure, [](const BCLMeasure&, const std::vector<openstudio::measure::OSArgument>&, const std::string&) {});
     }
     // DLM: handled in OSDocument::on_closeMeasuresBclDlg
     // app->measureManager().updateMeasuresLists();
@@ -30,6 +30,9 @@
 #ifndef SHAREDGUICOMPONENTS_BUILDINGCOMPONENTDIALOGCENTRALWIDGET_HPP
 #define SHAREDGUICOMPONENTS_BUILDINGCOMPONENTDIALOGCENTRALWIDGET_HPP
 
+#include "BCLDownloadManager.hpp"
+
+#include <QFutureWatcher>
 #include <QWidget>
 
 #include <set>
@@ -73,6 +76,9 @@ class BuildingComponentDialogCentralWidget : public QWidget, public Nano::Observ
   CollapsibleComponentList* m_collapsibleComponentList;
   ComponentList* m_componentList;  // TODO cruft to be removed
   QProgressBar* m_progressBar;
+  BCLDownloadManager* m_downloadManager;
+  QFutureWatcher<BCLSearchPage> m_searchWatcher;
+  QString m_title;
   std::set<std::string> m_pendingDownloads;
   std::string m_filterType;
   int m_pageIdx;
@@ -95,6 +101,8 @@ class BuildingComponentDialogCentralWidget : public QWidget, public Nano::Observ
   void on_headerClicked(bool checked);
   void componentDownloadComplete(const std::string& uid, const boost::optional<BCLComponent>& component);
   void measureDownloadComplete(const std::string& uid, const boost::optional<BCLMeasure>& measure);
+  void onDownloadProgress(int finished, int requested);
+  void onSearchFinished();
   void on_componentClicked(bool checked);
   void on_collapsibleComponentClicked(bool checked);
   void on_getComponentsByPage(int pageIdx);
@@ -0,0 +1,437 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "GridFilterIndex.hpp"
+
+#include "OSGridController.hpp"
+
+#include <openstudio/model/Model_Impl.hpp>
+#include <openstudio/model/ParentObject.hpp>
+
+#include <openstudio/utilities/core/Assert.hpp>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <QString>
+
+#include <algorithm>
+
+namespace openstudio {
+
+static std::string lowerCased(const std::string& text) {
+  return QString::fromStdString(text).toLower().toStdString();
+}
+
+static uint32_t trigram(const std::string& text, size_t pos) {
+  return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16)
+         | (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) | static_cast<unsigned char>(text[pos + 2]);
+}
+
+GridFilterIndex::GridFilterIndex(const model::Model& model) : m_model(model) {
+  m_model.getImpl<model::detail::Model_Impl>().get()->onChange.connect<GridFilterIndex, &GridFilterIndex::invalidate>(this);
+}
+
+GridFilterIndex::~GridFilterIndex() {}
+
+void GridFilterIndex::addFilter(const std::string& name, Level level, const Predicate& appliesTo, const ValueFunction& value, bool caseSensitive) {
+  Filter filter;
+  filter.level = level;
+  filter.appliesTo = appliesTo;
+  filter.value = value;
+  filter.caseSensitive = caseSensitive;
+  filter.hidden.resize(m_objects.size());
+  m_filters[name] = std::move(filter);
+}
+
+void GridFilterIndex::addTextFilter(const std::string& name, Level level, const Predicate& appliesTo, const ValueFunction& text) {
+  addFilter(name, level, appliesTo, text, false);
+  m_filters[name].text = true;
+}
+
+void GridFilterIndex::setObjects(const std::vector<model::ModelObject>& rowObjects, const std::set<model::ModelObject>& subRowObjects) {
+  if (m_dirty || rowObjects.size() != m_rowCount || subRowObjects.size() != m_subRowCount) {
+    rebuild(rowObjects, subRowObjects);
+  }
+}
+
+void GridFilterIndex::showAll(const std::string& name) {
+  Filter& f = filter(name);
+  f.mode = Mode::All;
+  updateHidden(f);
+}
+
+void GridFilterIndex::showUnassigned(const std::string& name) {
+  Filter& f = filter(name);
+  f.mode = Mode::Unassigned;
+  updateHidden(f);
+}
+
+void GridFilterIndex::showValue(const std::string& name, const std::string& value) {
+  Filter& f = filter(name);
+  f.mode = Mode::Value;
+  f.selectedValue = value;
+  updateHidden(f);
+}
+
+void GridFilterIndex::showContaining(const std::string& name, const std::string& text) {
+  Filter& f = filter(name);
+  OS_ASSERT(f.text);
+  f.mode = Mode::Contains;
+  f.selectedValue = lowerCased(text);
+  updateHidden(f);
+}
+
+size_t GridFilterIndex::comparedTexts(const std::string& name) const {
+  auto it = m_filters.find(name);
+  OS_ASSERT(it != m_filters.end());
+  return it->second.comparedTexts;
+}
+
+GridFilterIndex::Bits GridFilterIndex::hidden(Level level) const {
+  Bits result(m_objects.size());
+  for (const auto& f : m_filters) {
+    if (f.second.level == level && f.second.mode != Mode::All) {
+      result |= f.second.hidden;
+    }
+  }
+  return result;
+}
+
+void GridFilterIndex::apply(ObjectSelector& selector, bool hasSubRows) {
+  Bits rows = hidden(Level::Row);
+  Bits filtered = hidden(Level::SubRow);
+  if (!hasSubRows) {
+    filtered |= rows;
+    rows.reset();
+  }
+
+  // The selector forgets its filtering when the grid changes category
+  if (m_syncNeeded || (selector.m_filteredObjects.empty() && selector.m_hiddenRowObjects.empty())) {
+    syncApplied(selector);
+  }
+
+  const Bits flippedRows = rows ^ m_appliedRows;
+  for (size_t i = flippedRows.find_first(); i != Bits::npos; i = flippedRows.find_next(i)) {
+    selector.setRowObjectHidden(m_objects[i], rows[i]);
+  }
+
+  const Bits flippedFiltered = filtered ^ m_appliedFiltered;
+  for (size_t i = flippedFiltered.find_first(); i != Bits::npos; i = flippedFiltered.find_next(i)) {
+    if (filtered[i]) {
+      selector.m_filteredObjects.insert(m_objects[i]);
+    } else {
+      selector.m_filteredObjects.erase(m_objects[i]);
+    }
+  }
+
+  Bits effective = withChildren(filtered);
+  const Bits changed = (effective ^ m_appliedEffective) | flippedFiltered;
+  for (size_t i = changed.find_first(); i != Bits::npos; i = changed.find_next(i)) {
+    selector.updateWidgets(m_objects[i]);
+  }
+
+  m_appliedRows = std::move(rows);
+  m_appliedFiltered = std::move(filtered);
+  m_appliedEffective = std::move(effective);
+}
+
+size_t GridFilterIndex::objectCount() const {
+  return m_objects.size();
+}
+
+void GridFilterIndex::invalidate() {
+  m_dirty = true;
+}
+
+void GridFilterIndex::rebuild(const std::vector<model::ModelObject>& rowObjects, const std::set<model::ModelObject>& subRowObjects) {
+  std::vector<model::ModelObject> objects;
+  std::unordered_map<Handle, size_t, boost::hash<Handle>> ordinals;
+
+  auto ordinal = [&objects, &ordinals](const model::ModelObject& obj) {
+    auto inserted = ordinals.emplace(obj.handle(), objects.size());
+    if (inserted.second) {
+      objects.push_back(obj);
+    }
+    return inserted.first->second;
+  };
+
+  std::vector<size_t> rows;
+  rows.reserve(rowObjects.size());
+  for (const auto& obj : rowObjects) {
+    rows.push_back(ordinal(obj));
+  }
+
+  std::vector<size_t> subRows;
+  subRows.reserve(subRowObjects.size());
+  for (const auto& obj : subRowObjects) {
+    subRows.push_back(ordinal(obj));
+  }
+
+  const bool sameObjects = std::equal(objects.begin(), objects.end(), m_objects.begin(), m_objects.end(),
+                                      [](const model::ModelObject& lhs, const model::ModelObject& rhs) { return lhs.handle() == rhs.handle(); });
+  m_objects = std::move(objects);
+  m_ordinals = std::move(ordinals);
+
+  const size_t n = m_objects.size();
+  m_rowObjects = Bits(n);
+  for (size_t i : rows) {
+    m_rowObjects.set(i);
+  }
+  m_subRowObjects = Bits(n);
+  for (size_t i : subRows) {
+    m_subRowObjects.set(i);
+  }
+
+  m_parentsIndexed = false;
+  m_parents.clear();
+  m_grandParents.clear();
+
+  for (auto& f : m_filters) {
+    if (sameObjects && f.second.text && f.second.indexed) {
+      // Typically a rename, only the objects whose text changed are indexed again
+      reindexTexts(f.second);
+    } else {
+      f.second.indexed = false;
+    }
+    updateHidden(f.second);
+  }
+
+  m_rowCount = rowObjects.size();
+  m_subRowCount = subRowObjects.size();
+  m_dirty = false;
+  m_syncNeeded = true;
+}
+
+void GridFilterIndex::indexFilter(Filter& filter) const {
+  const size_t n = m_objects.size();
+  filter.applies = Bits(n);
+  filter.unassigned = Bits(n);
+  filter.values.clear();
+  filter.texts.clear();
+  filter.trigrams.clear();
+  filter.lastQuery.clear();
+  if (filter.text) {
+    filter.texts.resize(n);
+  }
+
+  const Bits& levelObjects = (filter.level == Level::Row) ? m_rowObjects : m_subRowObjects;
+  for (size_t i = levelObjects.find_first(); i != Bits::npos; i = levelObjects.find_next(i)) {
+    const model::ModelObject& obj = m_objects[i];
+    if (filter.appliesTo && !filter.appliesTo(obj)) {
+      continue;
+    }
+    filter.applies.set(i);
+
+    boost::optional<std::string> value;
+    if (filter.value) {
+      value = filter.value(obj);
+    }
+    if (!value) {
+      filter.unassigned.set(i);
+      continue;
+    }
+
+    if (filter.text) {
+      indexText(filter, i, *value);
+      continue;
+    }
+
+    Bits& bits = filter.values[key(filter, *value)];
+    if (bits.empty()) {
+      bits.resize(n);
+    }
+    bits.set(i);
+  }
+
+  filter.indexed = true;
+}
+
+void GridFilterIndex::updateHidden(Filter& filter) const {
+  if (filter.mode == Mode::All) {
+    filter.hidden = Bits(m_objects.size());
+    return;
+  }
+
+  if (!filter.indexed) {
+    indexFilter(filter);
+  }
+
+  switch (filter.mode) {
+    case Mode::Unassigned:
+      filter.hidden = filter.applies - filter.unassigned;
+      break;
+    case Mode::Value: {
+      filter.hidden = filter.applies;
+      auto it = filter.values.find(key(filter, filter.selectedValue));
+      if (it != filter.values.end()) {
+        filter.hidden -= it->second;
+      }
+      break;
+    }
+    case Mode::Contains:
+      if (filter.selectedValue.empty()) {
+        filter.hidden = Bits(m_objects.size());
+        filter.comparedTexts = 0;
+      } else {
+        filter.hidden = filter.applies - matches(filter, filter.selectedValue);
+      }
+      break;
+    default:
+      OS_ASSERT(false);
+  }
+}
+
+void GridFilterIndex::indexText(Filter& filter, size_t ordinal, std::string text) const {
+  text = lowerCased(text);
+  for (size_t pos = 0; pos + 3 <= text.size(); ++pos) {
+    Bits& bits = filter.trigrams[trigram(text, pos)];
+    if (bits.empty()) {
+      bits.resize(m_objects.size());
+    }
+    bits.set(ordinal);
+  }
+  filter.texts[ordinal] = std::move(text);
+}
+
+void GridFilterIndex::reindexTexts(Filter& filter) const {
+  filter.lastQuery.clear();
+
+  for (size_t i = filter.applies.find_first(); i != Bits::npos; i = filter.applies.find_next(i)) {
+    boost::optional<std::string> value = filter.value(m_objects[i]);
+    filter.unassigned[i] = !value;
+    std::string text = value ? lowerCased(*value) : std::string();
+    if (text == filter.texts[i]) {
+      continue;
+    }
+
+    const std::string& oldText = filter.texts[i];
+    for (size_t pos = 0; pos + 3 <= oldText.size(); ++pos) {
+      auto it = filter.trigrams.find(trigram(oldText, pos));
+      if (it != filter.trigrams.end()) {
+        it->second.reset(i);
+      }
+    }
+    indexText(filter, i, text);
+  }
+}
+
+GridFilterIndex::Bits GridFilterIndex::matches(Filter& filter, const std::string& query) const {
+  // Whatever contains the query contains the previous one if the query extends it
+  Bits candidates = (!filter.lastQuery.empty() && query.find(filter.lastQuery) != std::string::npos) ? filter.lastMatches : filter.applies;
+
+  for (size_t pos = 0; pos + 3 <= query.size() && candidates.any(); ++pos) {
+    auto it = filter.trigrams.find(trigram(query, pos));
+    if (it == filter.trigrams.end()) {
+      candidates.reset();
+    } else {
+      candidates &= it->second;
+    }
+  }
+
+  // Having all the trigrams doesn't mean having them in order
+  filter.comparedTexts = candidates.count();
+  Bits result(m_objects.size());
+  for (size_t i = candidates.find_first(); i != Bits::npos; i = candidates.find_next(i)) {
+    if (filter.texts[i].find(query) != std::string::npos) {
+      result.set(i);
+    }
+  }
+
+  filter.lastQuery = query;
+  filter.lastMatches = result;
+  return result;
+}
+
+GridFilterIndex::Filter& GridFilterIndex::filter(const std::string& name) {
+  auto it = m_filters.find(name);
+  OS_ASSERT(it != m_filters.end());
+  return it->second;
+}
+
+std::string GridFilterIndex::key(const Filter& filter, const std::string& value) const {
+  if (filter.caseSensitive) {
+    return value;
+  }
+  return boost::algorithm::to_lower_copy(value);
+}
+
+GridFilterIndex::Bits GridFilterIndex::withChildren(const Bits& own) {
+  Bits result = own;
+  if (own.none()) {
+    return result;
+  }
+
+  const size_t n = m_objects.size();
+  if (!m_parentsIndexed) {
+    m_parents.assign(n, n);
+    m_grandParents.assign(n, n);
+    auto ordinal = [this, n](const model::ModelObject& obj) {
+      auto it = m_ordinals.find(obj.handle());
+      return (it == m_ordinals.end()) ? n : it->second;
+    };
+    for (size_t i = m_subRowObjects.find_first(); i != Bits::npos; i = m_subRowObjects.find_next(i)) {
+      if (auto parent = m_objects[i].parent()) {
+        m_parents[i] = ordinal(*parent);
+        if (auto parentsParent = parent->parent()) {
+          m_grandParents[i] = ordinal(*parentsParent);
+        }
+      }
+    }
+    m_parentsIndexed = true;
+  }
+
+  for (size_t i = m_subRowObjects.find_first(); i != Bits::npos; i = m_subRowObjects.find_next(i)) {
+    if ((m_parents[i] < n && own[m_parents[i]]) || (m_grandParents[i] < n && own[m_grandParents[i]])) {
+      result.set(i);
+    }
+  }
+  return result;
+}
+
+void GridFilterIndex::syncApplied(const ObjectSelector& selector) {
+  const size_t n = m_objects.size();
+
+  auto read = [this, n](const std::set<model::ModelObject>& objects) {
+    Bits result(n);
+    for (const auto& obj : objects) {
+      auto it = m_ordinals.find(obj.handle());
+      if (it != m_ordinals.end()) {
+        result.set(it->second);
+      }
+    }
+    return result;
+  };
+
+  m_appliedRows = read(selector.m_hiddenRowObjects);
+  m_appliedFiltered = read(selector.m_filteredObjects);
+  m_appliedEffective = withChildren(m_appliedFiltered);
+  m_syncNeeded = false;
+}
+
+}  // namespace openstudio
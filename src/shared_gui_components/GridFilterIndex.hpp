@@ -0,0 +1,207 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef SHAREDGUICOMPONENTS_GRIDFILTERINDEX_HPP
+#define SHAREDGUICOMPONENTS_GRIDFILTERINDEX_HPP
+
+#include <openstudio/nano/nano_signal_slot.hpp>  // Signal-Slot replacement
+
+#include <openstudio/model/Model.hpp>
+#include <openstudio/model/ModelObject.hpp>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openstudio {
+
+class ObjectSelector;
+
+/** GridFilterIndex precomputes the filters of a grid whose rows and sub rows can be filtered by value (story, thermal
+  * zone, surface type...).
+  *
+  * Each row and sub row object gets an ordinal, and each filter keeps one bitset per value listing the objects having
+  * that value. Selecting a value and combining the filters are then bitset operations rather than model queries and set
+  * merges, and apply() only updates the ObjectSelector widgets of the objects whose filtering changed since last time.
+  *
+  * Text filters keep a trigram index of the lower cased text of each object instead, so that a substring search only
+  * checks the objects having all the trigrams of the query, and a query extending the previous one only checks its matches.
+  *
+  * The index is rebuilt on first use after the model changed, the selected value of each filter is kept. When the
+  * objects are the same, as after a rename, the text filters only update the objects whose text changed.
+  **/
+class GridFilterIndex : public Nano::Observer
+{
+ public:
+  using Bits = boost::dynamic_bitset<>;
+  using Predicate = std::function<bool(const model::ModelObject&)>;
+  // Value of an object for a filter, boost::none if it is unassigned
+  using ValueFunction = std::function<boost::optional<std::string>(const model::ModelObject&)>;
+
+  // Row filters hide whole rows, SubRow filters hide the sub row objects and the sub rows of their children
+  enum class Level
+  {
+    Row,
+    SubRow
+  };
+
+  explicit GridFilterIndex(const model::Model& model);
+
+  virtual ~GridFilterIndex();
+
+  GridFilterIndex(const GridFilterIndex&) = delete;
+  GridFilterIndex& operator=(const GridFilterIndex&) = delete;
+
+  // Register a filter. It only hides objects of its level for which appliesTo is true, and shows all until a value is selected
+  void addFilter(const std::string& name, Level level, const Predicate& appliesTo, const ValueFunction& value, bool caseSensitive = true);
+
+  // Register a filter matching a substring of the text of the objects, case insensitive. boost::none matches nothing
+  void addTextFilter(const std::string& name, Level level, const Predicate& appliesTo, const ValueFunction& text);
+
+  // The objects of the grid, the index is rebuilt if they changed since the last call
+  void setObjects(const std::vector<model::ModelObject>& rowObjects, const std::set<model::ModelObject>& subRowObjects);
+
+  void showAll(const std::string& name);
+
+  // Hide the objects that have a value
+  void showUnassigned(const std::string& name);
+
+  // Hide the objects that don't have this value
+  void showValue(const std::string& name, const std::string& value);
+
+  // Hide the objects whose text doesn't contain this text, for text filters. An empty text shows all
+  void showContaining(const std::string& name, const std::string& text);
+
+  // Number of texts the last showContaining of this text filter compared to the query, the others being ruled out beforehand
+  size_t comparedTexts(const std::string& name) const;
+
+  // Objects hidden by the filters of this level
+  Bits hidden(Level level) const;
+
+  // Update the filtered objects of the selector and the visibility of the widgets that changed since the last call.
+  // Without sub rows the row filters apply to the objects of the selector directly, as sub row filters do
+  void apply(ObjectSelector& selector, bool hasSubRows);
+
+  size_t objectCount() const;
+
+ private:
+  enum class Mode
+  {
+    All,
+    Unassigned,
+    Value,
+    Contains
+  };
+
+  struct Filter
+  {
+    Level level;
+    Predicate appliesTo;
+    ValueFunction value;
+    bool caseSensitive;
+    bool text = false;
+
+    // Indexed on first use after a rebuild
+    bool indexed = false;
+    Bits applies;
+    Bits unassigned;
+    std::map<std::string, Bits> values;
+
+    // Text filters: lower cased text by ordinal, and the objects containing each trigram
+    std::vector<std::string> texts;
+    std::unordered_map<uint32_t, Bits> trigrams;
+    // Matches of the last query, a query containing it can only match a subset
+    std::string lastQuery;
+    Bits lastMatches;
+    size_t comparedTexts = 0;
+
+    // Selection
+    Mode mode = Mode::All;
+    std::string selectedValue;
+    Bits hidden;
+  };
+
+  void invalidate();
+
+  void rebuild(const std::vector<model::ModelObject>& rowObjects, const std::set<model::ModelObject>& subRowObjects);
+
+  void indexFilter(Filter& filter) const;
+
+  void indexText(Filter& filter, size_t ordinal, std::string text) const;
+
+  // Update the text of the objects that changed, the ordinals being the same
+  void reindexTexts(Filter& filter) const;
+
+  Bits matches(Filter& filter, const std::string& query) const;
+
+  void updateHidden(Filter& filter) const;
+
+  Filter& filter(const std::string& name);
+
+  std::string key(const Filter& filter, const std::string& value) const;
+
+  // own | own of parent | own of grand parent, the sub row filters hide the children of what they hide
+  Bits withChildren(const Bits& own);
+
+  // Read the state of the selector into the applied bitsets
+  void syncApplied(const ObjectSelector& selector);
+
+  model::Model m_model;
+  bool m_dirty = true;
+  size_t m_rowCount = 0;
+  size_t m_subRowCount = 0;
+
+  std::map<std::string, Filter> m_filters;
+
+  std::vector<model::ModelObject> m_objects;
+  std::unordered_map<Handle, size_t, boost::hash<Handle>> m_ordinals;
+  Bits m_rowObjects;
+  Bits m_subRowObjects;
+  // Ordinal of the parent and grand parent of each object if they are indexed, m_objects.size() otherwise
+  bool m_parentsIndexed = false;
+  std::vector<size_t> m_parents;
+  std::vector<size_t> m_grandParents;
+
+  // What the last call to apply gave to the selector, read back from it after a rebuild
+  bool m_syncNeeded = true;
+  Bits m_appliedRows;
+  Bits m_appliedFiltered;
+  Bits m_appliedEffective;
+};
+
+}  // namespace openstudio
+
+#endif  // SHAREDGUICOMPONENTS_GRIDFILTERINDEX_HPP
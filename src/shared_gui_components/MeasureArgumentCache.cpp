@@ -0,0 +1,254 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "MeasureArgumentCache.hpp"
+
+#include "../model_editor/Utilities.hpp"
+
+#include <openstudio/utilities/bcl/BCLFileReference.hpp>
+#include <openstudio/utilities/core/PathHelpers.hpp>
+
+#include <json/json.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <sstream>
+
+namespace openstudio {
+
+MeasureArgumentCache::MeasureArgumentCache(const openstudio::path& cacheDir) : m_cacheDir(cacheDir) {}
+
+openstudio::path MeasureArgumentCache::defaultCacheDir() {
+  return toPath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)) / toPath("measure_arguments");
+}
+
+std::string MeasureArgumentCache::modelHash(const openstudio::path& osmPath) {
+  QFile file(toQString(osmPath));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return std::string();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(&file);
+  return hash.result().toHex().toStdString();
+}
+
+openstudio::path MeasureArgumentCache::cacheDir() const {
+  return m_cacheDir;
+}
+
+boost::optional<std::string> MeasureArgumentCache::find(const BCLMeasure& t_measure, const std::string& t_modelHash) {
+  Entry* e = entry(t_measure);
+  if (!e) {
+    return boost::none;
+  }
+
+  for (const auto& reply : e->replies) {
+    if (reply.first == t_modelHash) {
+      return reply.second;
+    }
+  }
+
+  return boost::none;
+}
+
+void MeasureArgumentCache::insert(const BCLMeasure& t_measure, const std::string& t_modelHash, const std::string& t_reply) {
+  Entry* e = entry(t_measure);
+  if (!e) {
+    Entry newEntry;
+    newEntry.measureDir = toString(t_measure.directory());
+    newEntry.fingerprint = fingerprint(t_measure);
+    e = &(m_entries[newEntry.measureDir] = newEntry);
+  }
+
+  for (auto it = e->replies.begin(); it != e->replies.end();) {
+    if (it->first == t_modelHash) {
+      it = e->replies.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  e->replies.emplace_back(t_modelHash, t_reply);
+  while (e->replies.size() > static_cast<size_t>(MAX_MODEL_REPLIES)) {
+    e->replies.erase(e->replies.begin());
+  }
+
+  save(*e);
+}
+
+void MeasureArgumentCache::invalidate(const openstudio::path& t_dir) {
+  const QString dir = QDir::cleanPath(toQString(t_dir));
+
+  auto matches = [&dir](const std::string& measureDir) {
+    const QString cleanMeasureDir = QDir::cleanPath(toQString(measureDir));
+    return cleanMeasureDir == dir || cleanMeasureDir.startsWith(dir + "/");
+  };
+
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (matches(it->first)) {
+      it = m_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Entries not loaded yet are only on disk
+  QDir cacheDir(toQString(m_cacheDir));
+  for (const QFileInfo& fileInfo : cacheDir.entryInfoList(QStringList("*.json"), QDir::Files)) {
+    QFile file(fileInfo.absoluteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+      continue;
+    }
+
+    Json::CharReaderBuilder rbuilder;
+    std::istringstream ss(file.readAll().toStdString());
+    file.close();
+
+    std::string errors;
+    Json::Value json;
+    if (!Json::parseFromStream(rbuilder, ss, &json, &errors) || matches(json.get("measure_dir", "").asString())) {
+      QFile::remove(fileInfo.absoluteFilePath());
+    }
+  }
+}
+
+void MeasureArgumentCache::clear() {
+  m_entries.clear();
+  QDir(toQString(m_cacheDir)).removeRecursively();
+}
+
+std::string MeasureArgumentCache::fingerprint(const BCLMeasure& t_measure) {
+  std::stringstream ss;
+  ss << t_measure.versionId();
+
+  std::vector<openstudio::path> paths{t_measure.directory() / toPath("measure.xml")};
+  for (const auto& file : t_measure.files()) {
+    paths.push_back(file.path());
+  }
+
+  for (const auto& path : paths) {
+    QFileInfo fileInfo(toQString(path));
+    ss << ";" << toString(path.filename()) << ":" << fileInfo.size() << ":" << fileInfo.lastModified().toMSecsSinceEpoch();
+  }
+
+  return ss.str();
+}
+
+openstudio::path MeasureArgumentCache::entryPath(const std::string& t_measureDir) const {
+  QByteArray name = QCryptographicHash::hash(QByteArray::fromStdString(t_measureDir), QCryptographicHash::Sha1).toHex();
+  return m_cacheDir / toPath(QString(name) + ".json");
+}
+
+MeasureArgumentCache::Entry* MeasureArgumentCache::entry(const BCLMeasure& t_measure) {
+  const std::string measureDir = toString(t_measure.directory());
+
+  auto it = m_entries.find(measureDir);
+  if (it == m_entries.end()) {
+    QFile file(toQString(entryPath(measureDir)));
+    if (!file.open(QIODevice::ReadOnly)) {
+      return nullptr;
+    }
+
+    Json::CharReaderBuilder rbuilder;
+    std::istringstream ss(file.readAll().toStdString());
+    file.close();
+
+    std::string errors;
+    Json::Value json;
+    if (!Json::parseFromStream(rbuilder, ss, &json, &errors)) {
+      LOG(Warn, "Discarding unreadable cached arguments of measure '" << measureDir << "': " << errors);
+      remove(measureDir);
+      return nullptr;
+    }
+
+    Entry e;
+    e.measureDir = json.get("measure_dir", "").asString();
+    e.fingerprint = json.get("fingerprint", "").asString();
+    for (const auto& reply : json.get("replies", Json::Value(Json::arrayValue))) {
+      e.replies.emplace_back(reply.get("model_hash", "").asString(), reply.get("reply", "").asString());
+    }
+
+    if (e.measureDir != measureDir) {
+      // Hash collision, extremely unlikely
+      return nullptr;
+    }
+
+    it = m_entries.emplace(measureDir, e).first;
+  }
+
+  if (it->second.fingerprint != fingerprint(t_measure)) {
+    // The measure changed since its arguments were computed
+    remove(measureDir);
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+void MeasureArgumentCache::save(const Entry& t_entry) const {
+  Json::Value json;
+  json["measure_dir"] = t_entry.measureDir;
+  json["fingerprint"] = t_entry.fingerprint;
+  Json::Value replies(Json::arrayValue);
+  for (const auto& reply : t_entry.replies) {
+    Json::Value value;
+    value["model_hash"] = reply.first;
+    value["reply"] = reply.second;
+    replies.append(value);
+  }
+  json["replies"] = replies;
+
+  if (!QDir().mkpath(toQString(m_cacheDir))) {
+    LOG(Warn, "Cannot create measure argument cache directory '" << toString(m_cacheDir) << "'");
+    return;
+  }
+
+  Json::StreamWriterBuilder wbuilder;
+  std::string content = Json::writeString(wbuilder, json);
+
+  QFile file(toQString(entryPath(t_entry.measureDir)));
+  if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    file.write(content.data(), content.size());
+  } else {
+    LOG(Warn, "Cannot write cached arguments of measure '" << t_entry.measureDir << "'");
+  }
+}
+
+void MeasureArgumentCache::remove(const std::string& t_measureDir) {
+  m_entries.erase(t_measureDir);
+  QFile::remove(toQString(entryPath(t_measureDir)));
+}
+
+}  // namespace openstudio
@@ -0,0 +1,115 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef SHAREDGUICOMPONENTS_MEASUREARGUMENTCACHE_HPP
+#define SHAREDGUICOMPONENTS_MEASUREARGUMENTCACHE_HPP
+
+#include <openstudio/utilities/bcl/BCLMeasure.hpp>
+#include <openstudio/utilities/core/Logger.hpp>
+#include <openstudio/utilities/core/Path.hpp>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+
+/***
+* MeasureArgumentCache persists the replies of the measure manager's compute_arguments requests across sessions.
+*
+* Replies are keyed by measure directory and by the content hash of the model they were computed for. Each measure's
+* entry also records a fingerprint of the measure (version id, size and modification time of its files). An entry whose
+* fingerprint no longer matches is dropped on the next lookup, so editing the measure invalidates its arguments.
+*
+* Replies are only served for the model they were computed for: defaults taken from the model (names, counts, areas) can
+* coincide on two models without the measure being independent of the model.
+**/
+#if defined(openstudio_lib_EXPORTS) || defined(COMPILING_FROM_OSAPP)
+#  include "../openstudio_lib/OpenStudioAPI.hpp"
+class OPENSTUDIO_API MeasureArgumentCache
+#else
+class MeasureArgumentCache
+#endif
+{
+ public:
+  explicit MeasureArgumentCache(const openstudio::path& cacheDir);
+
+  // measure_arguments directory in the user's cache location
+  static openstudio::path defaultCacheDir();
+
+  // Content hash of a saved model
+  static std::string modelHash(const openstudio::path& osmPath);
+
+  openstudio::path cacheDir() const;
+
+  // Cached compute_arguments reply for this measure and model, boost::none on a miss
+  boost::optional<std::string> find(const BCLMeasure& t_measure, const std::string& t_modelHash);
+
+  void insert(const BCLMeasure& t_measure, const std::string& t_modelHash, const std::string& t_reply);
+
+  // Drop the entries of the measures in this directory (or of the measure itself if it is a measure directory)
+  void invalidate(const openstudio::path& t_dir);
+
+  void clear();
+
+  // Replies kept per measure, oldest are dropped first
+  static constexpr int MAX_MODEL_REPLIES = 4;
+
+ private:
+  REGISTER_LOGGER("openstudio.MeasureArgumentCache");
+
+  struct Entry
+  {
+    std::string measureDir;
+    std::string fingerprint;
+    // (model hash, reply), oldest first
+    std::vector<std::pair<std::string, std::string>> replies;
+  };
+
+  static std::string fingerprint(const BCLMeasure& t_measure);
+
+  openstudio::path entryPath(const std::string& t_measureDir) const;
+
+  // Entry for this measure if there is a valid one, loaded from disk on first use
+  Entry* entry(const BCLMeasure& t_measure);
+
+  void save(const Entry& t_entry) const;
+
+  void remove(const std::string& t_measureDir);
+
+  openstudio::path m_cacheDir;
+  std::map<std::string, Entry> m_entries;
+};
+
+}  // namespace openstudio
+
+#endif  // SHAREDGUICOMPONENTS_MEASUREARGUMENTCACHE_HPP
@@ -28,6 +28,7 @@
 ***********************************************************************************************************************/
 
 #include "MeasureManager.hpp"
+#include "MeasureManagerClient.hpp"
 
 #include "BaseApp.hpp"
 #include "BCLMeasureDialog.hpp"
@@ -58,6 +59,8 @@
 
 #include <json/json.h>
 
+#include <memory>
+
 #include <QAbstractButton>
 #include <QBoxLayout>
 #include <QDesktopServices>
@@ -72,18 +75,17 @@
 #include <QUrl>
 #include <QRadioButton>
 #include <QProgressDialog>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QThread>
+#include <QNetworkReply>
 // Debug only
 //#include <QSslError>
 //#include <QDateTime>
 
 namespace openstudio {
 
-MeasureManager::MeasureManager(BaseApp* t_app) : m_app(t_app), m_started(false), m_mutex(QMutex::NonRecursive) {
-  m_networkAccessManager = new QNetworkAccessManager(this);
+MeasureManager::MeasureManager(BaseApp* t_app)
+  : m_app(t_app), m_argumentCache(MeasureArgumentCache::defaultCacheDir()), m_started(false), m_mutex(QMutex::NonRecursive) {
+  m_client = new MeasureManagerClient(this);
 }
 
 QUrl MeasureManager::url() const {
@@ -92,6 +94,15 @@ QUrl MeasureManager::url() const {
 
 void MeasureManager::setUrl(const QUrl& url) {
   m_url = url;
+  m_client->setUrl(url);
+}
+
+MeasureManagerClient* MeasureManager::client() const {
+  return m_client;
+}
+
+MeasureArgumentCache& MeasureManager::argumentCache() {
+  return m_argumentCache;
 }
 
 bool MeasureManager::waitForStarted(int msec) {
@@ -102,43 +113,21 @@ bool MeasureManager::waitForStarted(int msec) {
   // ping server until get a started response
   bool success = false;
 
-  QUrl url(m_url);
-  url.setPath("/");
-
   int msecPerLoop = 20;
   int numTries = msec / msecPerLoop;
   int current = 0;
   while (!success && current < numTries) {
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
-
-    QNetworkAccessManager manager;
-
-    QNetworkReply* reply = manager.get(request);
+    // Blocks without processing events, this is also called from a QtConcurrent thread by OpenStudioApp
+    success = m_client->getAndWait("/").success;
 
     // If trying to debug a potential SSL error
     // connect(reply, SIGNAL(sslErrors(QList<QSslError>)), this, SLOT(sslErrors(QList<QSslError>)));
     // connect(reply, SIGNAL(sslErrors(QList<QSslError>)), reply, SLOT(ignoreSslErrors()));
 
-    while (reply->isRunning()) {
-      Application::instance().processEvents();
-    }
-
-    auto error = reply->error();
-    delete reply;
-
-    if (error == QNetworkReply::NoError) {
-      success = true;
-    } else {
-      // We actually want to pause for msecPerLoop, processEvents will only put an upper limit the event processing that needs doing
-      // > processEvents: Processes pending events for the calling thread for maxTime_ms milliseconds or
-      // > ** until there are no more events to process,whichever is shorter**.
-      // Application::instance().processEvents(msecPerLoop);
-
-      // So we use QThread::msleep instead, which is not 100% accurate but we do not care. I am getting about 20ms delay in between tries
+    if (!success) {
+      // Pause for msecPerLoop before trying again
       // Debug
-      // LOG(Debug, "[" << current << ", " << QDateTime::currentDateTime().toMSecsSinceEpoch() << " ms]: QNetworkReply is " << error);
-
+      // LOG(Debug, "[" << current << ", " << QDateTime::currentDateTime().toMSecsSinceEpoch() << " ms]: QNetworkReply failed");
       QThread::msleep(msecPerLoop);
     }
 
@@ -148,7 +137,7 @@ bool MeasureManager::waitForStarted(int msec) {
   if (success) {
     m_started = true;
   } else {
-    LOG(Error, "Measure manager server failed to start. Was looking at URL=" << toString(url.toString()));
+    LOG(Error, "Measure manager server failed to start. Was looking at URL=" << toString(m_url.toString()));
   }
 
   return m_started;
@@ -191,6 +180,7 @@ void MeasureManager::saveTempModel(const path& tempDir) {
   m_tempModelPath = tempDir / toPath("temp_measure_manager.osm");
 
   model->save(m_tempModelPath, true);
+  m_tempModelHash = MeasureArgumentCache::modelHash(m_tempModelPath);
 
   m_measureArguments.clear();
 }
@@ -457,41 +447,98 @@ std::vector<measure::OSArgument> MeasureManager::getArguments(const BCLMeasure&
     return it->second;
   }
 
-  QUrl url(m_url);
-  url.setPath("/compute_arguments");
-
-  std::string url_s = m_url.toString().toStdString();
+  if (auto arguments = cachedArguments(t_measure)) {
+    return *arguments;
+  }
 
   QString data = QString("{\"measure_dir\": \"") + toQString(t_measure.directory()) + QString("\", \"osm_path\": \"") + toQString(m_tempModelPath) +
                  QString("\"}");
 
-  QNetworkRequest request(url);
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
+  MeasureManagerClient::Result reply = m_client->postAndWait("/compute_arguments", data.toUtf8());
+  std::string s = reply.body.toStdString();
 
-  QNetworkAccessManager manager;
+  if (!reply.success) {
+    LOG_AND_THROW("Error computing arguments: " << s)
+  }
 
-  QNetworkReply* reply = manager.post(request, data.toUtf8());
+  std::string errorString;
+  std::vector<measure::OSArgument> result = parseArguments(s, errorString);
 
-  while (reply->isRunning()) {
-    Application::instance().processEvents();
+  if (!errorString.empty()) {
+    LOG_AND_THROW(errorString);
   }
 
-  QString replyString = reply->readAll();
-  std::string s = replyString.toStdString();
-  auto error = reply->error();
-  delete reply;
+  m_measureArguments.insert(std::make_pair(t_measure.directory(), result));
+  m_argumentCache.insert(t_measure, m_tempModelHash, s);
 
-  if (error != QNetworkReply::NoError) {
-    LOG_AND_THROW("Error computing arguments: " << s)
+  return result;
+}
+
+void MeasureManager::getArgumentsAsync(const BCLMeasure& t_measure, const ArgumentsCallback& t_callback) {
+
+  auto it = m_measureArguments.find(t_measure.directory());
+  if (it != m_measureArguments.end()) {
+    t_callback(t_measure, it->second, std::string());
+    return;
+  }
+
+  if (auto arguments = cachedArguments(t_measure)) {
+    t_callback(t_measure, *arguments, std::string());
+    return;
   }
 
+  QString data = QString("{\"measure_dir\": \"") + toQString(t_measure.directory()) + QString("\", \"osm_path\": \"") + toQString(m_tempModelPath) +
+                 QString("\"}");
+
+  m_client->post("/compute_arguments", data.toUtf8(), [this, t_measure, t_callback](bool t_success, const QByteArray& t_body) {
+    std::string s = t_body.toStdString();
+    std::string errorString;
+    std::vector<measure::OSArgument> result;
+
+    if (t_success) {
+      result = parseArguments(s, errorString);
+    } else {
+      errorString = "Error computing arguments: " + s;
+    }
+
+    if (errorString.empty()) {
+      m_measureArguments.insert(std::make_pair(t_measure.directory(), result));
+      m_argumentCache.insert(t_measure, m_tempModelHash, s);
+    } else {
+      LOG(Error, errorString);
+    }
+
+    t_callback(t_measure, result, errorString);
+  });
+}
+
+boost::optional<std::vector<measure::OSArgument>> MeasureManager::cachedArguments(const BCLMeasure& t_measure) {
+  boost::optional<std::string> reply = m_argumentCache.find(t_measure, m_tempModelHash);
+  if (!reply) {
+    return boost::none;
+  }
+
+  std::string errorString;
+  std::vector<measure::OSArgument> result = parseArguments(*reply, errorString);
+  if (!errorString.empty()) {
+    // Let the server recompute them
+    LOG(Warn, "Ignoring cached arguments of measure '" << t_measure.directory() << "': " << errorString);
+    m_argumentCache.invalidate(t_measure.directory());
+    return boost::none;
+  }
+
+  m_measureArguments.insert(std::make_pair(t_measure.directory(), result));
+
+  return result;
+}
+
+std::vector<measure::OSArgument> MeasureManager::parseArguments(const std::string& t_reply, std::string& t_error) {
   std::vector<measure::OSArgument> result;
 
   Json::CharReaderBuilder rbuilder;
-  std::istringstream ss(s);
-  std::string errorString;
+  std::istringstream ss(t_reply);
   Json::Value json;
-  bool parsingSuccessful = Json::parseFromStream(rbuilder, ss, &json, &errorString);
+  bool parsingSuccessful = Json::parseFromStream(rbuilder, ss, &json, &t_error);
 
   if (parsingSuccessful) {
 
@@ -509,24 +556,18 @@ std::vector<measure::OSArgument> MeasureManager::getArguments(const BCLMeasure&
         if (osArgument) {
           result.push_back(*osArgument);
         } else {
-          errorString += "Could not convert argument.";
+          t_error += "Could not convert argument.";
         }
       } catch (const std::exception& e) {
-        errorString += std::string("Error occurred: ") + e.what();
+        t_error += std::string("Error occurred: ") + e.what();
         continue;
       }
     }
 
   } else {
-    LOG_AND_THROW("Error computing arguments: " << s)
-  }
-
-  if (!errorString.empty()) {
-    LOG_AND_THROW(errorString);
+    t_error = "Error computing arguments: " + t_reply;
   }
 
-  m_measureArguments.insert(std::make_pair(t_measure.directory(), result));
-
   return result;
 }
 
@@ -827,118 +868,35 @@ void MeasureManager::updateMeasuresLists(bool updateUserMeasures) {
 bool MeasureManager::reset() {
   waitForStarted();
 
-  if (!m_mutex.tryLock()) {
-    return false;
-  }
-
-  QUrl url(m_url);
-  url.setPath("/reset");
-
-  std::string url_s = m_url.toString().toStdString();
-
-  QString data = QString("{}");
-
-  QNetworkRequest request(url);
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
-
-  QNetworkAccessManager manager;
-
-  QNetworkReply* reply = manager.post(request, data.toUtf8());
-
-  while (reply->isRunning()) {
-    Application::instance().processEvents();
-  }
-
-  QString replyString = reply->readAll();
-  std::string s = replyString.toStdString();
-
-  bool result = true;
-  if (reply->error() != QNetworkReply::NoError) {
-    result = false;
-  }
-
-  delete reply;
-
-  m_mutex.unlock();
-
-  return result;
+  return postAndWait("/reset", QString("{}"));
 }
 
 bool MeasureManager::checkForLocalBCLUpdates() {
   waitForStarted();
 
-  if (!m_mutex.tryLock()) {
-    return false;
-  }
-
-  QUrl url(m_url);
-  url.setPath("/bcl_measures");
-
-  std::string url_s = m_url.toString().toStdString();
-
-  QString data = QString("{}");
-
-  QNetworkRequest request(url);
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
-
-  QNetworkAccessManager manager;
-
-  QNetworkReply* reply = manager.post(request, data.toUtf8());
-
-  while (reply->isRunning()) {
-    Application::instance().processEvents();
-  }
-
-  QString replyString = reply->readAll();
-  std::string s = replyString.toStdString();
-
-  bool result = true;
-  if (reply->error() != QNetworkReply::NoError) {
-    result = false;
-  }
-
-  delete reply;
-
-  m_mutex.unlock();
-
-  return result;
+  return postAndWait("/bcl_measures", QString("{}"));
 }
 
 bool MeasureManager::checkForUpdates(const openstudio::path& measureDir, bool force) {
   waitForStarted();
 
-  if (!m_mutex.tryLock()) {
-    return false;
+  if (force) {
+    // Measures are reloaded because their files changed
+    m_argumentCache.invalidate(measureDir);
   }
 
-  QUrl url(m_url);
-  url.setPath("/update_measures");
-
-  std::string url_s = m_url.toString().toStdString();
-
   QString data = QString("{\"measures_dir\": \"") + toQString(measureDir) + QString("\", \"force_reload\": ") +
                  (force ? QString("true") : QString("false")) + QString("}");
 
-  QNetworkRequest request(url);
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
-
-  QNetworkAccessManager manager;
-
-  QNetworkReply* reply = manager.post(request, data.toUtf8());
-
-  while (reply->isRunning()) {
-    Application::instance().processEvents();
-  }
-
-  QString replyString = reply->readAll();
-  std::string s = replyString.toStdString();
+  return postAndWait("/update_measures", data);
+}
 
-  bool result = true;
-  if (reply->error() != QNetworkReply::NoError) {
-    result = false;
+bool MeasureManager::postAndWait(const QString& t_path, const QString& t_data) {
+  if (!m_mutex.tryLock()) {
+    return false;
   }
 
-  delete reply;
+  bool result = m_client->postAndWait(t_path, t_data.toUtf8()).success;
 
   m_mutex.unlock();
 
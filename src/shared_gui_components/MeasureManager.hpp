@@ -31,11 +31,13 @@
 #define SHAREDGUICOMPONENTS_MEASUREMANAGER_HPP
 
 #include "LocalLibraryController.hpp"
+#include "MeasureArgumentCache.hpp"
 #include <openstudio/utilities/bcl/BCLMeasure.hpp>
 #include <openstudio/utilities/core/Path.hpp>
 #include <openstudio/utilities/core/UUID.hpp>
 #include <openstudio/model/Model.hpp>
 #include <openstudio/measure/OSArgument.hpp>
+#include <functional>
 #include <vector>
 #include <map>
 #include <QSharedPointer>
@@ -45,7 +47,6 @@
 #include <QMutex>
 
 class QEvent;
-class QNetworkAccessManager;
 // class QSslError; // If trying to debug a potential SSL error
 
 namespace Json {
@@ -56,6 +57,7 @@ namespace openstudio {
 
 class BaseApp;
 class BCLMeasure;
+class MeasureManagerClient;
 
 namespace osversion {
 class VersionTranslator;
@@ -145,6 +147,20 @@ class MeasureManager : public QObject
   //// Will throw if arguments cannot be computed.
   std::vector<measure::OSArgument> getArguments(const BCLMeasure& t_measure);
 
+  //// Callback for getArgumentsAsync, error is empty on success
+  using ArgumentsCallback =
+    std::function<void(const BCLMeasure& t_measure, const std::vector<measure::OSArgument>& t_arguments, const std::string& t_error)>;
+
+  //// Get arguments for given measure using current model without blocking, the callback is invoked once they are computed
+  //// (immediately if they are already cached). Several requests can be in flight at once.
+  void getArgumentsAsync(const BCLMeasure& t_measure, const ArgumentsCallback& t_callback);
+
+  //// The client used to talk to the measure manager server
+  MeasureManagerClient* client() const;
+
+  //// Arguments computed by the server, persisted across sessions
+  MeasureArgumentCache& argumentCache();
+
   std::string suggestMeasureName(const BCLMeasure& t_measure);
 
   bool isMeasureSelected();
@@ -202,14 +218,25 @@ class MeasureManager : public QObject
 
   boost::optional<measure::OSArgument> getArgument(const measure::OSArgumentType& type, const Json::Value& jsonArgument);
 
+  //// Parse the reply to a compute_arguments request, errors are appended to t_error
+  std::vector<measure::OSArgument> parseArguments(const std::string& t_reply, std::string& t_error);
+
+  //// Arguments from the disk cache if they were computed for this measure and model before
+  boost::optional<std::vector<measure::OSArgument>> cachedArguments(const BCLMeasure& t_measure);
+
+  //// Post data to the server and block until the reply is received, returns false if the request failed or another one is in progress
+  bool postAndWait(const QString& t_path, const QString& t_data);
+
   BaseApp* m_app;
   openstudio::path m_tempModelPath;
+  std::string m_tempModelHash;
   std::map<UUID, BCLMeasure> m_myMeasures;
   std::map<UUID, BCLMeasure> m_bclMeasures;
   std::map<openstudio::path, std::vector<measure::OSArgument>> m_measureArguments;
+  MeasureArgumentCache m_argumentCache;
   QUrl m_url;
   QSharedPointer<LocalLibraryController> m_libraryController;
-  QNetworkAccessManager* m_networkAccessManager;
+  MeasureManagerClient* m_client;
   bool m_started;
   QMutex m_mutex;
 };
@@ -0,0 +1,141 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "MeasureManagerClient.hpp"
+
+#include <QMutexLocker>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <future>
+#include <memory>
+
+namespace openstudio {
+
+MeasureManagerClient::MeasureManagerClient(QObject* parent)
+  : QObject(parent), m_networkAccessManager(new QNetworkAccessManager()), m_pendingRequests(0) {
+  // The manager and its replies are deleted once the network thread stops
+  m_networkAccessManager->moveToThread(&m_networkThread);
+  connect(&m_networkThread, &QThread::finished, m_networkAccessManager, &QObject::deleteLater);
+  m_networkThread.start();
+}
+
+MeasureManagerClient::~MeasureManagerClient() {
+  m_networkThread.quit();
+  m_networkThread.wait();
+}
+
+QUrl MeasureManagerClient::url() const {
+  QMutexLocker lock(&m_urlMutex);
+  return m_url;
+}
+
+void MeasureManagerClient::setUrl(const QUrl& url) {
+  QMutexLocker lock(&m_urlMutex);
+  m_url = url;
+}
+
+int MeasureManagerClient::pendingRequests() const {
+  return m_pendingRequests;
+}
+
+void MeasureManagerClient::send(const QString& path, bool isPost, const QByteArray& json, std::function<void(const Result&)> onFinished) {
+  QUrl url = this->url();
+  url.setPath(path);
+
+  QNetworkRequest request(url);
+  request.setHeader(QNetworkRequest::ContentTypeHeader, "json");
+  request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+
+  QMetaObject::invokeMethod(
+    m_networkAccessManager,
+    [this, request, isPost, json, onFinished]() {
+      QNetworkReply* reply = isPost ? m_networkAccessManager->post(request, json) : m_networkAccessManager->get(request);
+
+      connect(reply, &QNetworkReply::finished, reply, [this, reply, onFinished]() {
+        Result result;
+        result.success = (reply->error() == QNetworkReply::NoError);
+        result.body = reply->readAll();
+        if (!result.success) {
+          LOG(Debug, "Request to " << reply->url().toString().toStdString() << " failed: " << reply->errorString().toStdString());
+        }
+
+        reply->deleteLater();
+
+        onFinished(result);
+      });
+    },
+    Qt::QueuedConnection);
+}
+
+void MeasureManagerClient::sendAsync(const QString& path, bool isPost, const QByteArray& json, Callback callback) {
+  ++m_pendingRequests;
+
+  send(path, isPost, json, [this, callback](const Result& result) {
+    // Back to the thread owning the client
+    QMetaObject::invokeMethod(
+      this,
+      [this, callback, result]() {
+        if (callback) {
+          callback(result.success, result.body);
+        }
+
+        --m_pendingRequests;
+        if (m_pendingRequests == 0) {
+          emit allFinished();
+        }
+      },
+      Qt::QueuedConnection);
+  });
+}
+
+void MeasureManagerClient::get(const QString& path, Callback callback) {
+  sendAsync(path, false, QByteArray(), std::move(callback));
+}
+
+void MeasureManagerClient::post(const QString& path, const QByteArray& json, Callback callback) {
+  sendAsync(path, true, json, std::move(callback));
+}
+
+MeasureManagerClient::Result MeasureManagerClient::getAndWait(const QString& path) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  std::future<Result> future = promise->get_future();
+  send(path, false, QByteArray(), [promise](const Result& result) { promise->set_value(result); });
+  return future.get();
+}
+
+MeasureManagerClient::Result MeasureManagerClient::postAndWait(const QString& path, const QByteArray& json) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  std::future<Result> future = promise->get_future();
+  send(path, true, json, [promise](const Result& result) { promise->set_value(result); });
+  return future.get();
+}
+
+}  // namespace openstudio
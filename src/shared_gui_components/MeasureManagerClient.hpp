@@ -0,0 +1,122 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2019, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef SHAREDGUICOMPONENTS_MEASUREMANAGERCLIENT_HPP
+#define SHAREDGUICOMPONENTS_MEASUREMANAGERCLIENT_HPP
+
+#include <openstudio/utilities/core/Logger.hpp>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QUrl>
+
+#include <functional>
+
+class QNetworkAccessManager;
+
+namespace openstudio {
+
+/***
+* MeasureManagerClient talks to the measure manager server over a single persistent QNetworkAccessManager, which lives
+* in a network thread owned by the client. Connections to the server are kept alive and reused, and requests are allowed
+* to be pipelined.
+*
+* get and post are asynchronous: they return immediately and the callback is invoked from the event loop of the thread
+* owning the client once the reply is finished, so any number of requests can be in flight at once.
+*
+* getAndWait and postAndWait are provided for callers that need a result before they can continue. They go through the
+* same network access manager and block the calling thread, without running its event loop, so none of its slots can run
+* while it waits. They can be called from any thread but the network thread.
+**/
+#if defined(openstudio_lib_EXPORTS) || defined(COMPILING_FROM_OSAPP)
+#  include "../openstudio_lib/OpenStudioAPI.hpp"
+class OPENSTUDIO_API MeasureManagerClient : public QObject
+#else
+class MeasureManagerClient : public QObject
+#endif
+{
+  Q_OBJECT;
+
+ public:
+  // success is false if there was a network error or the server returned an error status, body is the reply content in both cases
+  using Callback = std::function<void(bool success, const QByteArray& body)>;
+
+  explicit MeasureManagerClient(QObject* parent = nullptr);
+
+  virtual ~MeasureManagerClient();
+
+  QUrl url() const;
+
+  void setUrl(const QUrl& url);
+
+  void get(const QString& path, Callback callback);
+
+  void post(const QString& path, const QByteArray& json, Callback callback);
+
+  // Number of requests sent and not finished yet
+  int pendingRequests() const;
+
+  struct Result
+  {
+    bool success = false;
+    QByteArray body;
+  };
+
+  // Same as get and post, the result holds what the callback would receive
+  Result getAndWait(const QString& path);
+
+  Result postAndWait(const QString& path, const QByteArray& json);
+
+ signals:
+
+  // Emitted when the last pending request finishes
+  void allFinished();
+
+ private:
+  REGISTER_LOGGER("openstudio.MeasureManagerClient");
+
+  // Sends the request from the network thread, onFinished is called there
+  void send(const QString& path, bool isPost, const QByteArray& json, std::function<void(const Result&)> onFinished);
+
+  void sendAsync(const QString& path, bool isPost, const QByteArray& json, Callback callback);
+
+  QThread m_networkThread;
+  QNetworkAccessManager* m_networkAccessManager;
+  // The url is read from the threads calling getAndWait and postAndWait
+  mutable QMutex m_urlMutex;
+  QUrl m_url;
+  int m_pendingRequests;
+};
+
+}  // namespace openstudio
+
+#endif  // SHAREDGUICOMPONENTS_MEASUREMANAGERCLIENT_HPP
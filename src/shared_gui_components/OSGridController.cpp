@@ -39,6 +39,8 @@
 #include "OSQuantityEdit.hpp"
 #include "OSUnsignedEdit.hpp"
 
+#include "../model_editor/ModelChangeBus.hpp"
+
 #include "../openstudio_lib/HorizontalTabWidget.hpp"
 #include "../openstudio_lib/MainRightColumnController.hpp"
 #include "../openstudio_lib/ModelObjectInspectorView.hpp"
@@ -52,6 +54,7 @@
 #include "../openstudio_lib/SchedulesView.hpp"
 
 #include <openstudio/model/Model_Impl.hpp>
+#include <openstudio/model/ParentObject.hpp>
 #include <openstudio/model/ModelObject_Impl.hpp>
 #include <openstudio/model/PlanarSurface.hpp>
 #include <openstudio/model/PlanarSurface_Impl.hpp>
@@ -71,6 +74,7 @@
 #include <QButtonGroup>
 #include <QCheckBox>
 #include <QColor>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QSettings>
 #include <QTimer>
@@ -100,23 +104,53 @@ ObjectSelector::ObjectSelector(OSGridController* t_grid) : m_grid(t_grid), m_obj
 void ObjectSelector::addWidget(const boost::optional<model::ModelObject>& t_obj, Holder* t_holder, int t_row, int t_column,
                                const boost::optional<int>& t_subrow, const bool t_selector) {
   WidgetLocation* widgetLoc = new WidgetLocation(t_holder, t_row, t_column, t_subrow);
+  // Deleted along with the holder
+  widgetLoc->setParent(t_holder);
 
   connect(t_holder, &QObject::destroyed, this, &ObjectSelector::widgetDestroyed);
   connect(t_holder, &Holder::inFocus, widgetLoc, &WidgetLocation::onInFocus);
   connect(widgetLoc, &WidgetLocation::inFocus, this, &ObjectSelector::inFocus);
 
-  m_widgetMap.insert(std::make_pair(t_obj, widgetLoc));
+  auto inserted = m_widgets.emplace(t_holder, WidgetEntry{t_holder, t_obj, widgetLoc, t_row, 0, 0});
+  WidgetEntry* entry = &inserted.first->second;
+  if (!inserted.second) {
+    // The holder is registered again, drop its former location
+    removeFromIndexes(entry);
+    *entry = WidgetEntry{t_holder, t_obj, widgetLoc, t_row, 0, 0};
+  }
+
+  if (t_row >= static_cast<int>(m_rowWidgets.size())) {
+    m_rowWidgets.resize(t_row + 1);
+  }
+  entry->rowPos = m_rowWidgets[t_row].size();
+  m_rowWidgets[t_row].push_back(entry);
+
+  if (t_obj) {
+    auto& objectWidgets = m_objectWidgets[t_obj->handle()];
+    entry->objectPos = objectWidgets.size();
+    objectWidgets.push_back(entry);
+  }
 
   if (t_selector && t_obj) {
-    m_selectorObjects.insert(*t_obj);
+    addSelectorObject(*t_obj, t_subrow.has_value());
   }
 }
 
+void ObjectSelector::addSelectorObject(const model::ModelObject& t_obj, bool t_isSubRow) {
+  m_selectorObjects.insert(t_obj);
+  m_selectorSubRows[t_obj.handle()] = t_isSubRow;
+}
+
 void ObjectSelector::clear() {
-  m_widgetMap.clear();  // TODO delete all QObjects, or set parent
+  m_widgets.clear();
+  m_rowWidgets.clear();
+  m_objectWidgets.clear();
   m_selectedObjects.clear();
   m_selectorObjects.clear();
+  m_selectorSubRows.clear();
   m_filteredObjects.clear();
+  m_registeredRows.clear();
+  m_hiddenRowObjects.clear();
   m_objectFilter = getDefaultFilter();
 }
 
@@ -125,27 +159,81 @@ void ObjectSelector::objectRemoved(const openstudio::model::ModelObject& t_obj)
 
   m_selectedObjects.erase(t_obj);
   m_selectorObjects.erase(t_obj);
+  m_selectorSubRows.erase(t_obj.handle());
   m_filteredObjects.erase(t_obj);
-  m_widgetMap.erase(boost::optional<model::ModelObject>(t_obj));
+  m_registeredRows.erase(t_obj.handle());
+  m_hiddenRowObjects.erase(t_obj);
+
+  auto it = m_objectWidgets.find(t_obj.handle());
+  if (it != m_objectWidgets.end()) {
+    // The holders stay alive until the grid is refreshed, they are just no longer tracked
+    std::vector<WidgetEntry*> entries = it->second;
+    for (WidgetEntry* entry : entries) {
+      removeWidget(entry);
+    }
+  }
 }
 
 bool ObjectSelector::containsObject(const openstudio::model::ModelObject& t_obj) const {
-  return m_selectedObjects.count(t_obj) != 0 || m_selectorObjects.count(t_obj) != 0 || m_filteredObjects.count(t_obj) != 0 ||
-         m_widgetMap.count(boost::optional<model::ModelObject>(t_obj));
+  return m_selectedObjects.count(t_obj) != 0 || m_selectorObjects.count(t_obj) != 0 || m_filteredObjects.count(t_obj) != 0
+         || m_objectWidgets.count(t_obj.handle()) != 0;
 }
 
 void ObjectSelector::widgetDestroyed(QObject* t_obj) {
-  auto itr = m_widgetMap.begin();
+  // Only the address is used, the holder is being destroyed
+  auto it = m_widgets.find(t_obj);
+  if (it != m_widgets.end()) {
+    removeWidget(&it->second);
+  }
+}
 
-  while (itr != m_widgetMap.end()) {
-    if (itr->second->widget == t_obj) {
-      itr = m_widgetMap.erase(itr);
-    } else {
-      ++itr;
+void ObjectSelector::removeFromIndexes(WidgetEntry* t_entry) {
+  // Swap with the last entry of each index, so that removing every widget of the grid stays linear
+  auto& rowWidgets = m_rowWidgets[t_entry->row];
+  WidgetEntry* lastInRow = rowWidgets.back();
+  rowWidgets[t_entry->rowPos] = lastInRow;
+  lastInRow->rowPos = t_entry->rowPos;
+  rowWidgets.pop_back();
+
+  if (t_entry->object) {
+    auto it = m_objectWidgets.find(t_entry->object->handle());
+    OS_ASSERT(it != m_objectWidgets.end());
+    WidgetEntry* lastOfObject = it->second.back();
+    it->second[t_entry->objectPos] = lastOfObject;
+    lastOfObject->objectPos = t_entry->objectPos;
+    it->second.pop_back();
+    if (it->second.empty()) {
+      m_objectWidgets.erase(it);
     }
   }
 }
 
+void ObjectSelector::removeWidget(WidgetEntry* t_entry) {
+  removeFromIndexes(t_entry);
+  m_widgets.erase(t_entry->holder);
+}
+
+const ObjectSelector::WidgetEntry* ObjectSelector::firstWidget(const model::ModelObject& t_obj) const {
+  auto it = m_objectWidgets.find(t_obj.handle());
+  if (it == m_objectWidgets.end()) {
+    return nullptr;
+  }
+  return it->second.front();
+}
+
+const ObjectSelector::WidgetEntry* ObjectSelector::findWidget(int t_row, int t_column, const boost::optional<int>& t_subrow) const {
+  if (t_row < 0 || t_row >= static_cast<int>(m_rowWidgets.size())) {
+    return nullptr;
+  }
+
+  for (const WidgetEntry* entry : m_rowWidgets[t_row]) {
+    if (entry->location->column == t_column && (!t_subrow || t_subrow == entry->location->subrow)) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
 bool ObjectSelector::getObjectSelection(const model::ModelObject& t_obj) const {
   return m_selectedObjects.count(t_obj) != 0;
 }
@@ -166,7 +254,7 @@ void ObjectSelector::setObjectSelection(const model::ModelObject& t_obj, bool t_
 std::set<model::ModelObject> ObjectSelector::getSelectedObjects() const {
   std::set<model::ModelObject> returned;
 
-  std::copy_if(m_selectedObjects.begin(), m_selectedObjects.end(), std::inserter(returned, returned.begin()), m_objectFilter);
+  std::copy_if(m_selectedObjects.begin(), m_selectedObjects.end(), std::inserter(returned, returned.end()), m_objectFilter);
 
   return returned;
 }
@@ -174,12 +262,9 @@ std::set<model::ModelObject> ObjectSelector::getSelectedObjects() const {
 std::vector<QWidget*> ObjectSelector::getColumnsSelectedWidgets(int column) {
   std::vector<QWidget*> results;
 
-  for (auto selectedObject : m_selectedObjects) {
-    for (auto& widgetLoc : m_widgetMap) {
-      if (widgetLoc.first && selectedObject == widgetLoc.first.get()) {
-        results.push_back(getWidget(widgetLoc.second->row, column, widgetLoc.second->subrow));
-        break;
-      }
+  for (const auto& selectedObject : m_selectedObjects) {
+    if (const WidgetEntry* entry = firstWidget(selectedObject)) {
+      results.push_back(getWidget(entry->row, column, entry->location->subrow));
     }
   }
   return results;
@@ -199,179 +284,131 @@ std::function<bool(const model::ModelObject&)> ObjectSelector::getDefaultFilter(
   return [](const model::ModelObject&) { return true; };
 }
 
-void ObjectSelector::selectAll() {
-  m_selectedObjects.clear();
-
-  for (auto obj : m_selectorObjects) {
-
-    auto range = m_widgetMap.equal_range(boost::optional<model::ModelObject>(obj));
-
-    assert(range.first != range.second);
-
-    // Find the row that contains this object
-    auto row = std::make_tuple(range.first->second->row, range.first->second->subrow);
-
-    auto objectVisible = m_objectFilter(obj);
+bool ObjectSelector::isObjectVisible(const model::ModelObject& t_obj, bool t_isSubRow) const {
+  if (!m_objectFilter(t_obj)) {
+    return false;
+  }
 
-    if (objectVisible) {
-      if (std::get<1>(row)) {
-        // We have a matched sub row
-        auto parent = obj.parent();
-        if (parent) {
-          // Check if we are filtering on the sub row's parent object
-          if (m_filteredObjects.count(*parent) != 0) {
-            objectVisible = false;
-          }
+  // Nothing filtered, no need to look for the parents
+  if (m_filteredObjects.empty()) {
+    return true;
+  }
 
-          if (objectVisible) {
-            // We still haven't matched the sub row, let's look up 1 more level
-            auto parentsParent = parent->parent();
-            // Evan's note:
-            //   in the case of SpacesSubsurfacesGridView,
-            //   obj.parent() returns Surface,
-            //   but our common currency is Space.
-            //   obj.parent()->parent() returns Space
-
-            if (parentsParent) {
-              // Check if we are filtering on the sub row's parent's parent object
-              if (m_filteredObjects.count(*parentsParent) != 0) {
-                objectVisible = false;
-              }
-            }
-          }
-        }
-        // Hmmm, still no match, let's check if we
-        // are filtering on the sub row's object
-        if (objectVisible && m_filteredObjects.count(obj) != 0) {
-          objectVisible = false;
-        }
-      } else {
-        // We only matched the row
-        if (m_filteredObjects.count(obj) != 0) {
-          objectVisible = false;
-        }
+  if (t_isSubRow) {
+    // We have a matched sub row
+    auto parent = t_obj.parent();
+    if (parent) {
+      // Check if we are filtering on the sub row's parent object
+      if (m_filteredObjects.count(*parent) != 0) {
+        return false;
       }
-    }
 
-    if (objectVisible) {
-      // add this to the selected set
-      m_selectedObjects.insert(obj);
+      // We still haven't matched the sub row, let's look up 1 more level
+      auto parentsParent = parent->parent();
+      // Evan's note:
+      //   in the case of SpacesSubsurfacesGridView,
+      //   obj.parent() returns Surface,
+      //   but our common currency is Space.
+      //   obj.parent()->parent() returns Space
+      //
+      // JM: 2018-08-21
+      //  in the case of the Loads subtab
+      //  t_obj.parent() will return either Space or SpaceType depending on how owns it
+      //  So if it's SpaceType, it won't match...
+      //  Also, even for Space, it will filter out only that load and not the entire corresponding Space master
+      //  which is fine if filtering by "Load Type", but not fine if filtering by Story for eg...
+
+      // Check if we are filtering on the sub row's parent's parent object
+      if (parentsParent && m_filteredObjects.count(*parentsParent) != 0) {
+        return false;
+      }
     }
   }
 
-  m_grid->requestRefreshGrid();
+  // Check if we are filtering on the (sub) row's object
+  return m_filteredObjects.count(t_obj) == 0;
 }
 
-void ObjectSelector::clearSelection() {
-  std::set<model::ModelObject> deselectedObjects;
-
-  auto selectedObjects = m_selectedObjects;
+std::vector<model::ModelObject> ObjectSelector::visibleSelectorObjects() const {
+  std::vector<model::ModelObject> result;
+  result.reserve(m_selectorObjects.size());
 
-  m_selectedObjects.clear();
+  // In the order of m_selectorObjects
+  for (const auto& obj : m_selectorObjects) {
+    auto it = m_selectorSubRows.find(obj.handle());
+    const bool isSubRow = (it != m_selectorSubRows.end()) && it->second;
 
-  for (auto obj : m_selectorObjects) {
+    if (isObjectVisible(obj, isSubRow)) {
+      result.push_back(obj);
+    }
+  }
 
-    auto range = m_widgetMap.equal_range(boost::optional<model::ModelObject>(obj));
+  return result;
+}
 
-    assert(range.first != range.second);
+void ObjectSelector::selectAll() {
+  m_selectedObjects.clear();
 
-    // Find the row that contains this object
-    auto row = std::make_tuple(range.first->second->row, range.first->second->subrow);
+  // Sorted like m_selectedObjects, each insertion is at the end
+  for (const auto& obj : visibleSelectorObjects()) {
+    m_selectedObjects.insert(m_selectedObjects.end(), obj);
+  }
 
-    auto objectVisible = m_objectFilter(obj);
+  m_grid->requestRefreshGrid();
+}
 
-    if (objectVisible) {
-      if (std::get<1>(row)) {
-        // We have a matched sub row
-        auto parent = obj.parent();
-        if (parent) {
-          // Check if we are filtering on the sub row's parent object
-          if (m_filteredObjects.count(*parent) != 0) {
-            objectVisible = false;
-          }
+void ObjectSelector::clearSelection() {
+  std::vector<model::ModelObject> deselectedObjects = visibleSelectorObjects();
 
-          if (objectVisible) {
-            // We still haven't matched the sub row, let's look up 1 more level
-            auto parentsParent = parent->parent();
-            // Evan's note:
-            //   in the case of SpacesSubsurfacesGridView,
-            //   obj.parent() returns Surface,
-            //   but our common currency is Space.
-            //   obj.parent()->parent() returns Space
-
-            if (parentsParent) {
-              // Check if we are filtering on the sub row's parent's parent object
-              if (m_filteredObjects.count(*parentsParent) != 0) {
-                objectVisible = false;
-              }
-            }
-          }
-        }
-        // Hmmm, still no match, let's check if we
-        // are filtering on the sub row's object
-        if (objectVisible && m_filteredObjects.count(obj) != 0) {
-          objectVisible = false;
-        }
-      } else {
-        // We only matched the row
-        if (m_filteredObjects.count(obj) != 0) {
-          objectVisible = false;
-        }
-      }
-    }
+  auto selectedObjects = std::move(m_selectedObjects);
 
-    if (objectVisible) {
-      // add this to the selected set
-      deselectedObjects.insert(obj);
-    }
-  }
+  m_selectedObjects.clear();
 
   std::set_difference(selectedObjects.begin(), selectedObjects.end(), deselectedObjects.begin(), deselectedObjects.end(),
-                      inserter(m_selectedObjects, m_selectedObjects.begin()));
+                      inserter(m_selectedObjects, m_selectedObjects.end()));
 
   m_grid->requestRefreshGrid();
 }
 
 boost::optional<model::ModelObject> ObjectSelector::getObject(const int t_row, const int t_column, const boost::optional<int>& t_subrow) {
-  boost::optional<model::ModelObject> object;
+  if (const WidgetEntry* entry = findWidget(t_row, t_column, t_subrow)) {
+    return entry->object;
+  }
+  return boost::none;
+}
 
-  for (auto& widgetLoc : m_widgetMap) {
-    if (widgetLoc.second->row == t_row && widgetLoc.second->column == t_column && (!t_subrow || t_subrow == widgetLoc.second->subrow)) {
-      object = widgetLoc.first;
-      break;
-    }
+boost::optional<int> ObjectSelector::getRow(const model::ModelObject& t_obj) const {
+  if (const WidgetEntry* entry = firstWidget(t_obj)) {
+    return entry->row;
   }
-  return object;
+  return boost::none;
 }
 
 QWidget* ObjectSelector::getWidget(const int t_row, const int t_column, const boost::optional<int>& t_subrow) {
-  QWidget* widget = nullptr;
-
-  for (auto& widgetLoc : m_widgetMap) {
-    if (widgetLoc.second->row == t_row && widgetLoc.second->column == t_column && (!t_subrow || t_subrow == widgetLoc.second->subrow)) {
-      widget = qobject_cast<Holder*>(widgetLoc.second->widget)->widget;
-      break;
-    }
+  if (const WidgetEntry* entry = findWidget(t_row, t_column, t_subrow)) {
+    return qobject_cast<Holder*>(entry->location->widget)->widget;
   }
-  return widget;
+  return nullptr;
 }
 
 void ObjectSelector::updateWidgets(const int t_row, const boost::optional<int>& t_subrow, bool t_objectSelected, bool t_objectVisible) {
+  if (t_row < 0 || t_row >= static_cast<int>(m_rowWidgets.size())) {
+    return;
+  }
+
   std::set<std::pair<QWidget*, int>> widgetsToUpdate;
   bool isSubRow = t_subrow.has_value();
 
   // determine if we want to update the parent widget or the child widget
-  for (auto& widgetLoc : m_widgetMap) {
-    // If the row corresponds
-    if (widgetLoc.second->row == t_row) {
-      // And there isn't any subrow, we get the parent
-      if (!isSubRow) {
-        widgetsToUpdate.insert(std::make_pair(widgetLoc.second->widget->parentWidget(), widgetLoc.second->column));
-        // Otherwise, the subrow needs to corresponds, and we hide that widget
-      } else if (t_subrow == widgetLoc.second->subrow) {
-        widgetsToUpdate.insert(std::make_pair(widgetLoc.second->widget, widgetLoc.second->column));
-        widgetLoc.second->widget->setStyleSheet("");
-      }
+  for (const WidgetEntry* entry : m_rowWidgets[t_row]) {
+    WidgetLocation* widgetLoc = entry->location;
+    // And there isn't any subrow, we get the parent
+    if (!isSubRow) {
+      widgetsToUpdate.insert(std::make_pair(widgetLoc->widget->parentWidget(), widgetLoc->column));
+      // Otherwise, the subrow needs to corresponds, and we hide that widget
+    } else if (t_subrow == widgetLoc->subrow) {
+      widgetsToUpdate.insert(std::make_pair(widgetLoc->widget, widgetLoc->column));
+      widgetLoc->widget->setStyleSheet("");
     }
   }
 
@@ -384,17 +421,23 @@ void ObjectSelector::updateWidgets(const int t_row, const boost::optional<int>&
 
 void ObjectSelector::updateWidgets(bool isRowLevel) {
   if (isRowLevel) {
+    m_hiddenRowObjects.clear();
+
     // We loop on all object in the leftmost colum (eg: 'Space' for all SpaceSubtabs)
     for (int t_row = 0; t_row < this->m_grid->rowCount(); ++t_row) {
       bool objectVisible = true;
       bool objectSelected = false;
 
       // If that object is present in m_filteredObjects
-      boost::optional<model::ModelObject> _rowLevelObj = getObject(t_row, 0, boost::optional<int>());
+      boost::optional<model::ModelObject> _rowLevelObj;
+      if (!m_grid->m_hasHorizontalHeader || t_row > 0) {
+        _rowLevelObj = m_grid->modelObject(t_row);
+      }
       if (_rowLevelObj && (m_filteredObjects.count(_rowLevelObj.get()) != 0)) {
         // LOG(Debug, "Hidding t_row=" << t_row << " matched as rowLevelObj (=" << _rowLevelObj.get().briefDescription() << ")");
         objectVisible = false;
         objectSelected = m_selectedObjects.count(_rowLevelObj.get()) != 0;
+        m_hiddenRowObjects.insert(_rowLevelObj.get());
       }
 
       // We'll hide the entire row
@@ -408,159 +451,128 @@ void ObjectSelector::updateWidgets(bool isRowLevel) {
   }
 }
 
+void ObjectSelector::updateRowWidgets(const std::set<int>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+
+  std::set<model::ModelObject> objects;
+  for (int row : rows) {
+    if (row < 0 || row >= static_cast<int>(m_rowWidgets.size())) {
+      continue;
+    }
+    for (const WidgetEntry* entry : m_rowWidgets[row]) {
+      if (entry->object && m_selectorObjects.count(*entry->object) != 0) {
+        objects.insert(*entry->object);
+      }
+    }
+  }
+
+  for (const auto& obj : objects) {
+    updateWidgets(obj);
+  }
+
+  // Rows hidden by a row level filter stay hidden
+  if (!m_hiddenRowObjects.empty()) {
+    for (int row : rows) {
+      if (m_grid->m_hasHorizontalHeader && row == 0) {
+        continue;
+      }
+      auto rowLevelObj = m_grid->modelObject(row);
+      if (m_hiddenRowObjects.count(rowLevelObj) != 0) {
+        updateWidgets(row, boost::optional<int>(), m_selectedObjects.count(rowLevelObj) != 0, false);
+      }
+    }
+  }
+}
+
+void ObjectSelector::remapRows(const std::map<int, int>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+
+  // Take all the moved rows out first, a row may move to the former place of another one
+  std::vector<std::pair<int, std::vector<WidgetEntry*>>> moved;
+  for (const auto& row : rows) {
+    if (row.first >= 0 && row.first < static_cast<int>(m_rowWidgets.size()) && !m_rowWidgets[row.first].empty()) {
+      moved.emplace_back(row.second, std::move(m_rowWidgets[row.first]));
+      m_rowWidgets[row.first].clear();
+    }
+  }
+
+  for (auto& row : moved) {
+    if (row.first >= static_cast<int>(m_rowWidgets.size())) {
+      m_rowWidgets.resize(row.first + 1);
+    }
+    auto& rowWidgets = m_rowWidgets[row.first];
+    for (WidgetEntry* entry : row.second) {
+      entry->row = row.first;
+      entry->location->row = row.first;
+      entry->rowPos = rowWidgets.size();
+      rowWidgets.push_back(entry);
+    }
+  }
+}
+
+void ObjectSelector::setRowObjectHidden(const model::ModelObject& t_obj, bool t_hidden) {
+  if (t_hidden) {
+    m_hiddenRowObjects.insert(t_obj);
+  } else {
+    m_hiddenRowObjects.erase(t_obj);
+  }
+
+  // Rows without widgets get hidden when they are built, see updateRowWidgets
+  if (auto row = getRow(t_obj)) {
+    updateWidgets(*row, boost::optional<int>(), t_hidden && m_selectedObjects.count(t_obj) != 0, !t_hidden);
+  }
+}
+
 // TODO: this overloaded function isn't called anywhere...
 void ObjectSelector::updateWidgets(const model::ModelObject& t_obj, const bool t_objectVisible) {
-  auto range = m_widgetMap.equal_range(boost::optional<model::ModelObject>(t_obj));
+  auto it = m_objectWidgets.find(t_obj.handle());
 
-  assert(range.first != range.second);
+  assert(it != m_objectWidgets.end());
 
   // Find the row that contains this object
-  auto row = std::make_tuple(range.first->second->row, range.first->second->subrow);
+  const WidgetEntry* entry = it->second.front();
 
-  // TODO: should we delete that too? see comment below in updateWidgets(const model::ModelObject &t_obj)
 #if _DEBUG || (__GNUC__ && !NDEBUG)
   // Sanity check to make sure we don't have the same object in two different rows
-  ++range.first;
-  while (range.first != range.second) {
-    assert(row == std::make_tuple(range.first->second->row, range.first->second->subrow));
-    ++range.first;
+  for (const WidgetEntry* other : it->second) {
+    assert(entry->row == other->row && entry->location->subrow == other->location->subrow);
   }
 #endif
 
   const auto objectSelected = m_selectedObjects.count(t_obj) != 0;
 
-  updateWidgets(std::get<0>(row), std::get<1>(row), objectSelected, t_objectVisible);
+  updateWidgets(entry->row, entry->location->subrow, objectSelected, t_objectVisible);
 }
 
 void ObjectSelector::updateWidgets(const model::ModelObject& t_obj) {
+  // The object may not have widgets if its row isn't materialized yet (virtualized grid)
+  auto it = m_objectWidgets.find(t_obj.handle());
+  if (it == m_objectWidgets.end()) {
+    return;
+  }
 
-  // Find all entries in m_widgetMap that matches t_obj
-  auto range = m_widgetMap.equal_range(boost::optional<model::ModelObject>(t_obj));
-
-  // Check that it did return something
-  assert(range.first != range.second);
-
-  // Note JM: leaving it here in case you need to look at the contents of m_widgetMap...
-  /*
-     *std::cout << "\n\nContent of m_widgetMap\n";
-     *for (auto it = m_widgetMap.begin(); it != m_widgetMap.end(); ++it) {
-     *  const boost::optional<model::ModelObject> mo = it->first;
-     *  int t_row = it->second->row;
-     *  boost::optional<int> t_subrow = it->second->subrow;
-     *  if( mo ) {
-     *    std::cout << "row=" << t_row << ", subrow=" << t_subrow <<", mo=" << mo->briefDescription() << "\n";
-     *  } else {
-     *    std::cout << "row=" << t_row << ", subrow=" << t_subrow <<", mo=None\n";
-     *  }
-     *}
-     */
-
-  /*
-   *  auto row = std::make_tuple(t_row, t_subrow);
-   *#if _DEBUG || (__GNUC__ && !NDEBUG)
-   *    // Sanity check to make sure we don't have the same object in two different rows
-   *    // TODO: JM 2018-08-21: In case of the Loads subtab for eg, given than obj is a **Space** (always!)
-   *    // but given that we have lots of load objects (People, Light, etc) for each Space,
-   *    // We kinda expect to have the same object in several rows, don't we?
-   *    ++range.first;
-   *    while (range.first != range.second)
-   *    {
-   *      assert(row == std::make_tuple(range.first->second->row, range.first->second->subrow));
-   *      ++range.first;
-   *    }
-   *#endif
-   */
-
-  // For all rows that contain this object
-  for (auto it = range.first; it != range.second; ++it) {
-    // it->second returns the WidgetLocation of that entry
-    // it->second->row (subrow) returns the WidgetLocation's row (and subrow)
-    int t_row = it->second->row;
-    boost::optional<int> t_subrow = it->second->subrow;
-
-    const auto objectSelected = m_selectedObjects.count(t_obj) != 0;
-    auto objectVisible = m_objectFilter(t_obj);
-
-    // If the object is not already hidden
-    if (objectVisible) {
-      // We try find it it's a subrow
-      if (t_subrow) {
-        // We have a matched sub row
-        auto parent = t_obj.parent();
-        if (parent) {
-          // Check if we are filtering on the sub row's parent object
-          if (m_filteredObjects.count(*parent) != 0) {
-            objectVisible = false;
-          }
-
-          if (objectVisible) {
-            // We still haven't matched the sub row, let's look up 1 more level
-            auto parentsParent = parent->parent();
-            // Evan's note:
-            //   in the case of SpacesSubsurfacesGridView,
-            //   t_obj.parent() returns Surface,
-            //   but our common currency is Space.
-            //   t_obj.parent()->parent() returns Space
-            //
-            // JM: 2018-08-21
-            //  in the case of the Loads subtab
-            //  t_obj.parent() will return either Space or SpaceType depending on how owns it
-            //  So if it's SpaceType, it won't match...
-            //  Also, even for Space, it will filter out only that load and not the entire corresponding Space master
-            //  which is fine if filtering by "Load Type", but not fine if filtering by Story for eg...
-
-            if (parentsParent) {
-              // Check if we are filtering on the sub row's parent's parent object
-              if (m_filteredObjects.count(*parentsParent) != 0) {
-                objectVisible = false;
-              }
-            }
-          }
-        }
-        // Hmmm, still no match, let's check if we
-        // are filtering on the sub row's object
-        if (objectVisible && m_filteredObjects.count(t_obj) != 0) {
-          objectVisible = false;
-        }
+  // JM 2018-08-21: In case of the Loads subtab for eg, the same object can be in several rows, update each (sub) row once,
+  // not once per widget of the object
+  std::set<std::pair<int, boost::optional<int>>> rows;
+  for (const WidgetEntry* entry : it->second) {
+    rows.insert(std::make_pair(entry->row, entry->location->subrow));
+  }
 
-        // Still no match? That's problematic... perhaps it's the Loads subtab?
-        /*
- *          if (objectVisible) {
- *            boost::optional<const model::ModelObject &> _rowLevelObj = getObject(t_row, 0, boost::optional<int>());
- *            if (_rowLevelObj && m_filteredObjects.count(_rowLevelObj.get()) != 0) {
- *              LOG(Debug, t_obj.briefDescription() << " matched as rowLevelObj (=" << _rowLevelObj.get().briefDescription() << ")"
- *                  << " || t_row=" << t_row << ", t_subrow=" << t_subrow);
- *              objectVisible = false;
- *              t_subrow = boost::optional<int>();
- *            }
- *
- *            //range = m_widgetMap.equal_range(boost::optional<model::ModelObject>(t_obj));
- *            //std::cout << "\n\nt_obj=" << t_obj.briefDescription() << "\n";
- *            //for (auto it = range.first; it != range.second; ++it) {
- *              //boost::optional<model::ModelObject> mo = it->first;
- *              //WidgetLocation * wL = it->second;
- *              //if (mo) {
- *                //std::cout << "mo=" << mo->name().get()
- *                  //<< ", row=" << wL->row << ", subrow=";
- *                //if (boost::optional<int> sr = wL->subrow) {
- *                  //std::cout << sr;
- *                //} else {
- *                  //std::cout << "None";
- *                //}
- *                //std::cout << "\n";
- *              //}
- *            //}
- *          }
- */
-      } else {
-        // We only matched the row: (works for the Properties subtab probably)
-        if (m_filteredObjects.count(t_obj) != 0) {
-          LOG(Debug, t_obj.briefDescription() << " matched as row");
-          objectVisible = false;
-        }
-      }
+  const auto objectSelected = m_selectedObjects.count(t_obj) != 0;
+  boost::optional<bool> rowVisible;
+  boost::optional<bool> subRowVisible;
+
+  for (const auto& row : rows) {
+    const bool isSubRow = row.second.has_value();
+    boost::optional<bool>& objectVisible = isSubRow ? subRowVisible : rowVisible;
+    if (!objectVisible) {
+      objectVisible = isObjectVisible(t_obj, isSubRow);
     }
-    updateWidgets(t_row, t_subrow, objectSelected, objectVisible);
+    updateWidgets(row.first, row.second, objectSelected, *objectVisible);
   }
 }
 
@@ -596,14 +608,122 @@ OSGridController::~OSGridController() {
 }
 
 void OSGridController::requestRefreshGrid() {
+  if (m_bulkEdit) {
+    m_bulkEdit->refreshGrid = true;
+    return;
+  }
+
   gridView()->requestRefreshGrid();
 }
 
+void OSGridController::requestRefreshRow(const model::ModelObject& t_obj) {
+  if (m_bulkEdit) {
+    m_bulkEdit->changedObjects.push_back(t_obj);
+    return;
+  }
+
+  // Row objects are indexed by the grid view, sub row objects by the widgets bound to them
+  int row = gridView()->rowIndexByHandle(t_obj.handle());
+  if (row < 0) {
+    if (auto widgetRow = m_objectSelector->getRow(t_obj)) {
+      row = *widgetRow;
+    }
+  }
+  if (row >= 0) {
+    gridView()->requestRefreshRow(row);
+    return;
+  }
+
+  // A selectable object without widgets lives in a page of a virtualized grid that isn't built, it is up to date once built
+  if (gridView()->isVirtualized() && m_objectSelector->m_selectorObjects.count(t_obj) != 0) {
+    return;
+  }
+
+  requestRefreshGrid();
+}
+
 void OSGridController::refreshGrid() {
   // Never hit
   OS_ASSERT(false);
 }
 
+void OSGridController::applyToObjects(const std::set<model::ModelObject>& t_objects, const std::function<void(const model::ModelObject&)>& t_apply) {
+  if (m_bulkEdit) {
+    LOG(Warn, "Apply to selected is already in progress");
+    return;
+  }
+
+  m_bulkEdit = std::make_unique<BulkEdit>();
+  m_bulkEdit->objects.assign(t_objects.begin(), t_objects.end());
+  m_bulkEdit->apply = t_apply;
+
+  // The rows are rebuilt at the end, don't repaint them in between
+  gridView()->setUpdatesEnabled(false);
+
+  if (m_bulkEdit->objects.size() > BULK_EDIT_CHUNK_SIZE) {
+    // Not a child of the grid view, it would inherit its disabled updates and never repaint
+    m_bulkEdit->progress =
+      new QProgressDialog("Applying to selected objects", "Cancel", 0, m_bulkEdit->objects.size(), gridView()->window());
+    m_bulkEdit->progress->setWindowModality(Qt::ApplicationModal);
+    m_bulkEdit->progress->setMinimumDuration(500);
+    m_bulkEdit->progress->setValue(0);
+  }
+
+  applyBulkEditChunk();
+}
+
+void OSGridController::applyBulkEditChunk() {
+  OS_ASSERT(m_bulkEdit);
+  BulkEdit& bulkEdit = *m_bulkEdit;
+
+  const bool canceled = bulkEdit.progress && bulkEdit.progress->wasCanceled();
+  if (!canceled) {
+    const size_t end = std::min(bulkEdit.next + BULK_EDIT_CHUNK_SIZE, bulkEdit.objects.size());
+    for (; bulkEdit.next < end; ++bulkEdit.next) {
+      const model::ModelObject& modelObject = bulkEdit.objects[bulkEdit.next];
+      // A previous setter may have removed it
+      if (!m_model.getObject(modelObject.handle())) {
+        continue;
+      }
+      bulkEdit.apply(modelObject);
+      bulkEdit.changedObjects.push_back(modelObject);
+    }
+
+    if (bulkEdit.next < bulkEdit.objects.size()) {
+      // Let the progress dialog repaint and handle Cancel before the next chunk
+      bulkEdit.progress->setValue(bulkEdit.next);
+      QTimer::singleShot(0, this, &OSGridController::applyBulkEditChunk);
+      return;
+    }
+  }
+
+  endBulkEdit();
+}
+
+void OSGridController::endBulkEdit() {
+  std::unique_ptr<BulkEdit> bulkEdit = std::move(m_bulkEdit);
+
+  if (bulkEdit->progress) {
+    bulkEdit->progress->reset();
+    bulkEdit->progress->deleteLater();
+  }
+
+  if (bulkEdit->next < bulkEdit->objects.size()) {
+    LOG(Info, "Apply to selected canceled, " << bulkEdit->next << " of " << bulkEdit->objects.size() << " objects were changed");
+  }
+
+  // One change set for the whole edit: the rows that were changed, or the whole grid if anything asked for it
+  if (bulkEdit->refreshGrid) {
+    requestRefreshGrid();
+  } else {
+    for (const auto& modelObject : bulkEdit->changedObjects) {
+      requestRefreshRow(modelObject);
+    }
+  }
+
+  gridView()->setUpdatesEnabled(true);
+}
+
 void OSGridController::loadQSettings() {
   QSettings settings("OpenStudio", m_headerText);
   m_customFields = settings.value("customFields").toStringList().toVector().toStdVector();
@@ -700,8 +820,7 @@ QWidget* OSGridController::makeWidget(model::ModelObject t_mo, const QSharedPoin
     checkBox->bind(t_mo, BoolGetter(std::bind(&CheckBoxConcept::get, checkBoxConcept.data(), t_mo)),
                    boost::optional<BoolSetter>(std::bind(&CheckBoxConcept::set, checkBoxConcept.data(), t_mo, std::placeholders::_1)));
 
-    isConnected = connect(checkBox, SIGNAL(stateChanged(int)), gridView(),
-                          SLOT(requestRefreshGrid()));  // TODO this is not the most efficient, by single row would be better
+    isConnected = connect(checkBox, &OSCheckBox3::stateChanged, this, [this, t_mo]() { requestRefreshRow(t_mo); });
     OS_ASSERT(isConnected);
 
     isConnected = connect(checkBox, SIGNAL(stateChanged(int)), gridView(), SIGNAL(gridRowSelectionChanged(int)));
@@ -1067,6 +1186,31 @@ QWidget* OSGridController::makeWidget(model::ModelObject t_mo, const QSharedPoin
   return widget;
 }
 
+void OSGridController::ensureSelectorObjects(int row) {
+  if (m_objectSelector->m_registeredRows.count(modelObject(row).handle()) == 0) {
+    addSelectorObjects(row);
+  }
+}
+
+void OSGridController::addSelectorObjects(int row) {
+  model::ModelObject mo = modelObject(row);
+  m_objectSelector->m_registeredRows.insert(mo.handle());
+
+  for (const auto& baseConcept : m_baseConcepts) {
+    if (QSharedPointer<DataSourceAdapter> dataSource = baseConcept.dynamicCast<DataSourceAdapter>()) {
+      if (baseConcept->isSelector() || dataSource->innerConcept()->isSelector()) {
+        for (auto& item : dataSource->source().items(mo)) {
+          if (item) {
+            m_objectSelector->addSelectorObject(item->cast<model::ModelObject>(), true);
+          }
+        }
+      }
+    } else if (baseConcept->isSelector()) {
+      m_objectSelector->addSelectorObject(mo, false);
+    }
+  }
+}
+
 void OSGridController::setConceptValue(model::ModelObject t_setterMO, model::ModelObject t_getterMO,
                                        const QSharedPointer<BaseConcept>& t_baseConcept) {
   if (QSharedPointer<CheckBoxConcept> concept = t_baseConcept.dynamicCast<CheckBoxConcept>()) {
@@ -1672,13 +1816,22 @@ OSItem* OSGridController::getSelectedItemFromModelSubTabView() {
 }
 
 void OSGridController::connectToModel() {
-  m_model.getImpl<model::detail::Model_Impl>().get()->addWorkspaceObject.connect<OSGridController, &OSGridController::onAddWorkspaceObject>(this);
+  // Added objects arrive in one batch per event loop turn, removals stay synchronous because the object selector
+  // has to look the removed object up while it is still alive
+  if (!m_modelChangeBus) {
+    m_modelChangeBus = ModelChangeBus::get(m_model);
+  }
+  // The objects added so far are already rows
+  m_modelChangeBus->flush();
+  connect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &OSGridController::onModelChanges, Qt::UniqueConnection);
   m_model.getImpl<model::detail::Model_Impl>().get()->removeWorkspaceObject.connect<OSGridController, &OSGridController::onRemoveWorkspaceObject>(
     this);
 }
 
 void OSGridController::disconnectFromModel() {
-  m_model.getImpl<model::detail::Model_Impl>().get()->addWorkspaceObject.disconnect<OSGridController, &OSGridController::onAddWorkspaceObject>(this);
+  if (m_modelChangeBus) {
+    disconnect(m_modelChangeBus.get(), &ModelChangeBus::changesReady, this, &OSGridController::onModelChanges);
+  }
   m_model.getImpl<model::detail::Model_Impl>().get()->removeWorkspaceObject.disconnect<OSGridController, &OSGridController::onRemoveWorkspaceObject>(
     this);
 }
@@ -1690,6 +1843,9 @@ void OSGridController::onRemoveWorkspaceObject(const WorkspaceObject& object, co
   auto modelObject = object.cast<model::ModelObject>();
   auto weHaveObject = false;
 
+  // Must be looked up before the selector forgets about the object
+  boost::optional<int> objectRow = m_objectSelector->getRow(modelObject);
+
   if (m_objectSelector->containsObject(modelObject)) {
     m_objectSelector->objectRemoved(object.cast<model::ModelObject>());
     weHaveObject = true;
@@ -1708,28 +1864,39 @@ void OSGridController::onRemoveWorkspaceObject(const WorkspaceObject& object, co
     gridView()->requestRemoveRow(rowIndexFromModelIndex(index));
   } else if (weHaveObject) {
     // we know we are tracking this object, but it's not one of the row-major ones...
-    // must be a subrow... for now, not ideal, but let's queue a refresh of the grid
-    requestRefreshGrid();
+    // must be a subrow, only the row it was displayed in needs to be rebuilt
+    if (objectRow) {
+      gridView()->requestRefreshRow(*objectRow);
+    } else {
+      requestRefreshGrid();
+    }
   }
   //}
 }
 
-void OSGridController::onAddWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType,
-                                            const openstudio::UUID& handle) {
-  //if (m_iddObjectType == iddObjectType) { TODO uncomment, currently used to update views with extensible dropzones, which need to issue their own signal to refresh
-  // Update model list
-  // m_modelObjects.push_back(object.cast<model::ModelObject>());
-  refreshModelObjects();
-
-  // Update row
-  gridView()->requestAddRow(rowCount() - 1);
-  //}
+void OSGridController::onModelChanges(const ModelChangeBatch& batch) {
+  for (const auto& [iddObjectType, objects] : batch.added) {
+    for (const auto& impl : objects) {
+      if (m_iddObjectType == iddObjectType) {
+        // A new row, the grid view will figure out where it goes once the model objects are refreshed
+        gridView()->requestAddRow(rowCount() - 1);
+      } else if (auto parent = impl->getObject<model::ModelObject>().parent()) {
+        // Views with extensible dropzones or sub rows rely on this to show the new object. It has no widgets yet, refresh the
+        // row its parent is displayed in
+        requestRefreshRow(parent->cast<model::ModelObject>());
+      } else {
+        // Nothing to narrow it down, one grid refresh covers the rest of the batch
+        requestRefreshGrid();
+        return;
+      }
+    }
+  }
 }
 
 void OSGridController::onObjectRemoved(boost::optional<model::ParentObject> parent) {
   if (parent) {
-    // We have a parent we can search for in our current list of modelObjects and just delete that 1 row
-    this->requestRefreshGrid();  // TODO replace this with a by-row refresh only
+    // We have a parent we can search for in our current list of modelObjects and just refresh that 1 row
+    this->requestRefreshRow(*parent);
   } else {
     // We don't know which row needs to be redrawn, so we have to do the whole grid
     this->requestRefreshGrid();
@@ -1767,35 +1934,36 @@ void OSGridController::onInFocus(bool inFocus, bool hasData, int row, int column
       QSharedPointer<BaseConcept> dropZoneConcept = source.dropZoneConcept();
       boost::optional<model::ModelObject> object = this->m_objectSelector->getObject(selectedRow, selectedColumn, selectedSubrow);
       if (object) {
-        for (auto modelObject : selectedObjects) {
-          // Don't set the chosen object when iterating through the selected objects
-          if (modelObject != object.get()) {
-            OS_ASSERT(dataSource.data()->innerConcept());
-            if (dropZoneConcept) {
-              // Widget has sub rows
-              setConceptValue(modelObject, object.get(), dropZoneConcept, dataSource.data()->innerConcept());
-            } else {
-              // Row has sub rows
-              setConceptValue(modelObject, object.get(), dataSource.data()->innerConcept());
-            }
-          }
-        }
-      }
-    } else if (!selectedSubrow) {
-      for (auto modelObject : selectedObjects) {
+        OS_ASSERT(dataSource.data()->innerConcept());
         // Don't set the chosen object when iterating through the selected objects
-        if (modelObject != this->modelObject(selectedRow)) {
-          setConceptValue(modelObject, this->modelObject(selectedRow), m_baseConcepts[column]);
+        selectedObjects.erase(object.get());
+        model::ModelObject getterMO = object.get();
+        QSharedPointer<BaseConcept> innerConcept = dataSource.data()->innerConcept();
+        if (dropZoneConcept) {
+          // Widget has sub rows
+          applyToObjects(selectedObjects, [this, getterMO, dropZoneConcept, innerConcept](const model::ModelObject& modelObject) {
+            setConceptValue(modelObject, getterMO, dropZoneConcept, innerConcept);
+          });
+        } else {
+          // Row has sub rows
+          applyToObjects(selectedObjects, [this, getterMO, innerConcept](const model::ModelObject& modelObject) {
+            setConceptValue(modelObject, getterMO, innerConcept);
+          });
         }
       }
+    } else if (!selectedSubrow) {
+      // Don't set the chosen object when iterating through the selected objects
+      model::ModelObject getterMO = this->modelObject(selectedRow);
+      selectedObjects.erase(getterMO);
+      QSharedPointer<BaseConcept> baseConcept = m_baseConcepts[column];
+      applyToObjects(selectedObjects, [this, getterMO, baseConcept](const model::ModelObject& modelObject) {
+        setConceptValue(modelObject, getterMO, baseConcept);
+      });
     } else {
       // Should never get here
       OS_ASSERT(false);
     }
 
-    // Now refresh
-    gridView()->requestRefreshGrid();  // TODO this is heavy handed; each cell should update itself
-
   } else {
     HorizontalHeaderWidget* horizontalHeaderWidget = qobject_cast<HorizontalHeaderWidget*>(m_horizontalHeader.at(column));
     OS_ASSERT(horizontalHeaderWidget);
@@ -42,8 +42,15 @@
 
 #include <openstudio/utilities/idd/IddObject.hpp>
 
-#include <string>
+#include <boost/functional/hash.hpp>
+
 #include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <QObject>
@@ -57,9 +64,12 @@ class QCheckBox;
 class QColor;
 class QLabel;
 class QPaintEvent;
+class QProgressDialog;
 
 namespace openstudio {
 
+class ModelChangeBus;
+struct ModelChangeBatch;
 class OSComboBox2;
 class OSGridView;
 
@@ -193,9 +203,13 @@ class ObjectSelector : public QObject, public Nano::Observer
 
   void addWidget(const boost::optional<model::ModelObject>& t_obj, Holder* t_holder, int row, int column, const boost::optional<int>& subrow,
                  bool t_selector);
+  // Register a selectable object whose row has no widgets (see OSGridView::setVirtualized), so that it can still be selected
+  void addSelectorObject(const model::ModelObject& t_obj, bool t_isSubRow);
   void setObjectSelection(const model::ModelObject& t_obj, bool t_selected);
   bool getObjectSelection(const model::ModelObject& t_obj) const;
   boost::optional<model::ModelObject> getObject(const int t_row, const int t_column, const boost::optional<int>& t_subrow);
+  // Row of the first widget bound to this object, if it has any
+  boost::optional<int> getRow(const model::ModelObject& t_obj) const;
   QWidget* getWidget(const int t_row, const int t_column, const boost::optional<int>& t_subrow);
   std::set<model::ModelObject> getSelectedObjects() const;
   std::vector<QWidget*> getColumnsSelectedWidgets(int column);
@@ -207,11 +221,26 @@ class ObjectSelector : public QObject, public Nano::Observer
   void selectAll();
   void clearSelection();
   void updateWidgets(bool isRowLevel = false);
+  // Restyle and apply the filter to the widgets located in the given rows only
+  void updateRowWidgets(const std::set<int>& rows);
+  // Move widget locations from one row to another (old row -> new row), used when rows are shifted without being rebuilt
+  void remapRows(const std::map<int, int>& rows);
+  // Restyle and apply the filter to the widgets of this object only
+  void updateWidgets(const model::ModelObject& t_obj);
+  // Hide or show the row of this row level object, like a row level call to updateWidgets does for every row
+  void setRowObjectHidden(const model::ModelObject& t_obj, bool t_hidden);
 
   std::set<model::ModelObject> m_selectedObjects;
   std::set<model::ModelObject> m_selectorObjects;
   std::set<model::ModelObject> m_filteredObjects;
 
+  // Row level objects whose selectable objects were registered by OSGridController::addSelectorObjects. The registrations
+  // outlive the widgets, so a row only needs it once until the selector is cleared
+  std::unordered_set<Handle, boost::hash<Handle>> m_registeredRows;
+
+  // Row level objects hidden by the last row level call to updateWidgets, reapplied to rows that get their widgets later
+  std::set<model::ModelObject> m_hiddenRowObjects;
+
  signals:
   void inFocus(bool inFocus, bool hasData, int row, int column, boost::optional<int> subrow);
 
@@ -222,14 +251,38 @@ class ObjectSelector : public QObject, public Nano::Observer
   REGISTER_LOGGER("openstudio.ObjectSelector");
 
  private:
-  void updateWidgets(const model::ModelObject& t_obj);
   void updateWidgets(const model::ModelObject& t_obj, const bool t_objectVisible);
   void updateWidgets(const int t_row, const boost::optional<int>& t_subrow, bool t_selected, bool t_visible);
   static std::function<bool(const model::ModelObject&)> getDefaultFilter();
+  bool isObjectVisible(const model::ModelObject& t_obj, bool t_isSubRow) const;
+  // m_selectorObjects passing the filters, in the order of m_selectorObjects
+  std::vector<model::ModelObject> visibleSelectorObjects() const;
+
+  // A registered holder, indexed by row and by object
+  struct WidgetEntry
+  {
+    const QObject* holder;
+    boost::optional<model::ModelObject> object;
+    WidgetLocation* location;
+    int row;
+    // position in m_rowWidgets[row] and in m_objectWidgets[object handle]
+    size_t rowPos;
+    size_t objectPos;
+  };
+
+  void removeFromIndexes(WidgetEntry* t_entry);
+  void removeWidget(WidgetEntry* t_entry);
+  const WidgetEntry* firstWidget(const model::ModelObject& t_obj) const;
+  const WidgetEntry* findWidget(int t_row, int t_column, const boost::optional<int>& t_subrow) const;
 
   OSGridController* m_grid;
-  std::multimap<boost::optional<model::ModelObject>, WidgetLocation*> m_widgetMap;
+  // Owns the entries, keyed by holder. The other indexes point into it, its elements don't move on rehash
+  std::unordered_map<const QObject*, WidgetEntry> m_widgets;
+  std::vector<std::vector<WidgetEntry*>> m_rowWidgets;
+  std::unordered_map<Handle, std::vector<WidgetEntry*>, boost::hash<Handle>> m_objectWidgets;
   std::function<bool(const model::ModelObject&)> m_objectFilter;
+  // Whether each of m_selectorObjects lives in a sub row, this doesn't require the object to have widgets
+  std::unordered_map<Handle, bool, boost::hash<Handle>> m_selectorSubRows;
 };
 
 class OSGridController : public QObject, public Nano::Observer
@@ -516,6 +569,12 @@ class OSGridController : public QObject, public Nano::Observer
 
   OSGridView* gridView();
 
+  // Apply to Selected, t_apply sets the value on one object. The row refreshes requested meanwhile are collected and
+  // requested once at the end. Large selections are applied in chunks, behind a progress dialog that can cancel the rest
+  void applyToObjects(const std::set<model::ModelObject>& t_objects, const std::function<void(const model::ModelObject&)>& t_apply);
+
+  static constexpr size_t BULK_EDIT_CHUNK_SIZE = 100;
+
   // If a column contains information about a construction, it may be an inherited construction
   // (as determined by calling PlanarSurface::isConstructionDefaulted). An instantiated gridview
   // should set this value, if appropriate.
@@ -596,6 +655,12 @@ class OSGridController : public QObject, public Nano::Observer
 
   bool getRowIndexByItem(OSItem* item, int& rowIndex);
 
+  // Register the selectable objects of a row without building its widgets
+  void addSelectorObjects(int row);
+
+  // Register the selectable objects of a row unless they already were since the selector was last cleared
+  void ensureSelectorObjects(int row);
+
   void setConceptValue(model::ModelObject t_setterMO, model::ModelObject t_getterMO, const QSharedPointer<BaseConcept>& t_baseConcept);
 
   void resetConceptValue(model::ModelObject t_resetMO, const QSharedPointer<BaseConcept>& t_baseConcept);
@@ -603,6 +668,22 @@ class OSGridController : public QObject, public Nano::Observer
   void setConceptValue(model::ModelObject t_setterMO, model::ModelObject t_getterMO, const QSharedPointer<BaseConcept>& t_setterBaseConcept,
                        const QSharedPointer<BaseConcept>& t_getterBaseConcept);
 
+  void endBulkEdit();
+
+  struct BulkEdit
+  {
+    std::vector<model::ModelObject> objects;
+    size_t next = 0;
+    std::function<void(const model::ModelObject&)> apply;
+    QProgressDialog* progress = nullptr;
+    // Objects whose row must be refreshed, unless the whole grid must be
+    std::vector<model::ModelObject> changedObjects;
+    bool refreshGrid = false;
+  };
+
+  // Set while an Apply to Selected is in progress
+  std::unique_ptr<BulkEdit> m_bulkEdit;
+
   QButtonGroup* m_horizontalHeaderBtnGrp;
 
   QString m_headerText;
@@ -611,6 +692,9 @@ class OSGridController : public QObject, public Nano::Observer
 
   std::shared_ptr<ObjectSelector> m_objectSelector;
 
+  // Held for the controller's lifetime so the bus outlives its connection
+  std::shared_ptr<ModelChangeBus> m_modelChangeBus;
+
   std::tuple<int, int, boost::optional<int>> m_selectedCellLocation = std::make_tuple(-1, -1, -1);
 
   std::vector<std::pair<int, bool>> m_applyToButtonStates = std::vector<std::pair<int, bool>>();
@@ -638,6 +722,9 @@ class OSGridController : public QObject, public Nano::Observer
 
   void requestRefreshGrid();
 
+  // Refresh only the row displaying this object, falls back to the whole grid when there is no such row
+  void requestRefreshRow(const model::ModelObject& t_obj);
+
   void onInFocus(bool inFocus, bool hasData, int row, int column, boost::optional<int> subrow);
 
  protected slots:
@@ -648,9 +735,11 @@ class OSGridController : public QObject, public Nano::Observer
 
   void horizontalHeaderChecked(int index);
 
+  void applyBulkEditChunk();
+
   void onRemoveWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
 
-  void onAddWorkspaceObject(const WorkspaceObject& object, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+  void onModelChanges(const ModelChangeBatch& batch);
 
   void onObjectRemoved(boost::optional<model::ParentObject> parent);
 
@@ -53,9 +53,14 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QScrollArea>
+#include <QScrollBar>
 #include <QShowEvent>
 #include <QStackedWidget>
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 #ifdef Q_OS_DARWIN
 #  define WIDTH 110
 #  define HEIGHT 60
@@ -166,6 +171,9 @@ OSGridView::OSGridView(OSGridController* gridController, const QString& headerTe
   m_timer.setSingleShot(true);
   connect(&m_timer, &QTimer::timeout, this, &OSGridView::doRefresh);
 
+  m_visiblePagesTimer.setSingleShot(true);
+  connect(&m_visiblePagesTimer, &QTimer::timeout, this, &OSGridView::updateVisiblePages);
+
   if (this->isVisible()) {
     m_gridController->connectToModel();
     refreshAll();
@@ -182,14 +190,14 @@ void OSGridView::setGridController(OSGridController* gridController) {
   m_gridController->setParent(this);
 }
 
+// The row passed to requestAddRow and requestRemoveRow is informational only: refreshIncremental matches rows by the object they display,
+// which also handles inserts in the middle of a sorted grid
 void OSGridView::requestAddRow(int row) {
   // std::cout << "REQUEST ADDROW CALLED " << std::endl;
   setEnabled(false);
 
   m_timer.start();
 
-  m_rowToAdd = row;
-
   m_queueRequests.emplace_back(AddRow);
 }
 
@@ -199,11 +207,34 @@ void OSGridView::requestRemoveRow(int row) {
 
   m_timer.start();
 
-  m_rowToRemove = row;
-
   m_queueRequests.emplace_back(RemoveRow);
 }
 
+void OSGridView::requestRefreshRow(int row) {
+  setEnabled(false);
+
+  m_timer.start();
+
+  m_rowsToRefresh.insert(row);
+
+  m_queueRequests.emplace_back(RefreshRow);
+}
+
+int OSGridView::lastRefreshCellCount() const {
+  return m_lastRefreshCellCount;
+}
+
+void OSGridView::setVirtualized(bool virtualized) {
+  if (m_virtualized != virtualized) {
+    m_virtualized = virtualized;
+    requestRefreshAll();
+  }
+}
+
+bool OSGridView::isVirtualized() const {
+  return m_virtualized;
+}
+
 //void OSGridView::refreshRow(int row)
 //{
 //  for( int j = 0; j < m_gridController->columnCount(); j++ )
@@ -310,15 +341,6 @@ void OSGridView::requestRefreshGrid() {
   m_queueRequests.emplace_back(RefreshGrid);
 }
 
-//void OSGridView::requestRefreshRow(int t_row)
-//{
-//  setEnabled(false);
-//
-//  m_timer.start();
-//
-//  m_queueRequests.emplace_back(RefreshRow);
-//}
-
 void OSGridView::doRefresh() {
   // std::cout << " DO REFRESH CALLED " << m_queueRequests.size() << std::endl;
 
@@ -327,62 +349,220 @@ void OSGridView::doRefresh() {
     return;
   }
 
-  // TODO: JM 2019-01-03 : Unused!
-  [[maybe_unused]] bool has_add_row = false;
-  [[maybe_unused]] bool has_remove_row = false;
-  [[maybe_unused]] bool has_refresh_grid = false;
-  [[maybe_unused]] bool has_refresh_all = false;
+  bool has_add_remove_row = false;
+  bool has_refresh_row = false;
+  bool has_refresh_grid = false;
+  bool has_refresh_all = false;
 
   for (const auto& r : m_queueRequests) {
-    if (r == AddRow) has_add_row = true;
-    if (r == RemoveRow) has_remove_row = true;
+    if (r == AddRow || r == RemoveRow) has_add_remove_row = true;
+    if (r == RefreshRow) has_refresh_row = true;
     if (r == RefreshGrid) has_refresh_grid = true;
     if (r == RefreshAll) has_refresh_all = true;
   }
 
   m_queueRequests.clear();
 
-  //if (has_refresh_all) {
-  //  refreshAll();
-  //}
-  //else if (has_refresh_grid) {
-  //  refreshGrid(); // This now causes a crash
-  //}
-  //else if (has_add_row) {
-  //  addRow(m_rowToAdd);
-  //}
-  //else if (has_remove_row) {
-  //  removeRow(m_rowToRemove);
-  //}
-  //else {
-  //  // Should never get here
-  //  OS_ASSERT(false);
-  //}
-
-  refreshAll();  // TODO remove this and uncomment the block above for finer granularity refreshes
+  if (has_refresh_all || has_refresh_grid) {
+    // When virtualized, a full refresh only builds the visible pages
+    refreshAll();
+  } else if (m_virtualized && (has_add_remove_row || has_refresh_row)) {
+    refreshVirtualized();
+  } else if (has_add_remove_row || has_refresh_row) {
+    refreshIncremental();
+  } else {
+    // Should never get here
+    OS_ASSERT(false);
+  }
+
   setEnabled(true);
 }
 
 void OSGridView::refreshAll() {
   // std::cout << " REFRESHALL CALLED " << std::endl;
   m_queueRequests.clear();
+  m_rowsToRefresh.clear();
+  setRowObjects({});
+  m_lastRefreshCellCount = 0;
+
+  // Computed before deleting anything, while the layouts still have their geometry
+  auto pages = m_virtualized ? visiblePages() : std::make_pair(0, -1);
+
   deleteAll();
+  m_materializedPages.clear();
+  m_pagePlaceholders.clear();
 
   if (m_gridController) {
     m_gridController->refreshModelObjects();
 
-    for (int i = 0; i < m_gridController->rowCount(); i++) {
-      for (int j = 0; j < m_gridController->columnCount(); j++) {
-        addWidget(i, j);
+    if (m_virtualized) {
+      m_materializedPages.assign(pageCount(), false);
+      m_pagePlaceholders.assign(pageCount(), nullptr);
+
+      for (int page = 0; page < pageCount(); ++page) {
+        // The first page holds the horizontal header, it always has widgets
+        if (page == 0 || (page >= pages.first && page <= pages.second)) {
+          materializePage(page);
+        } else {
+          releasePage(page);
+          // So the rows can still be selected through "Select All" and used by "Apply to Selected"
+          const int firstRow = page * ROWS_PER_LAYOUT;
+          for (int row = firstRow; row < firstRow + pageRowCount(page); ++row) {
+            m_gridController->ensureSelectorObjects(row);
+          }
+        }
       }
+
+      // Once laid out, the placeholders tell which pages are actually visible
+      m_visiblePagesTimer.start();
+    } else {
+      for (int i = 0; i < m_gridController->rowCount(); i++) {
+        for (int j = 0; j < m_gridController->columnCount(); j++) {
+          addWidget(i, j);
+        }
+      }
+
+      this->m_gridController->getObjectSelector()->updateWidgets();
     }
 
-    this->m_gridController->getObjectSelector()->updateWidgets();
+    const int headerRowCount = m_gridController->m_hasHorizontalHeader ? 1 : 0;
+    std::vector<boost::optional<model::ModelObject>> rowObjects(m_gridController->rowCount());
+    for (int i = headerRowCount; i < m_gridController->rowCount(); i++) {
+      rowObjects[i] = m_gridController->modelObject(i);
+    }
+    setRowObjects(std::move(rowObjects));
 
     QTimer::singleShot(0, this, SLOT(selectRowDeterminedByModelSubTabView()));
   }
 }
 
+void OSGridView::refreshIncremental() {
+  OS_ASSERT(m_gridController);
+
+  std::set<int> rowsToRefresh;
+  std::swap(rowsToRefresh, m_rowsToRefresh);
+  m_lastRefreshCellCount = 0;
+
+  m_gridController->refreshModelObjects();
+
+  const int headerRowCount = m_gridController->m_hasHorizontalHeader ? 1 : 0;
+  const int columnCount = m_gridController->columnCount();
+  const int oldRowCount = static_cast<int>(m_rowObjects.size());
+  const int newRowCount = m_gridController->rowCount();
+
+  if (oldRowCount < headerRowCount) {
+    // Nothing was ever drawn
+    refreshAll();
+    return;
+  }
+
+  std::vector<boost::optional<model::ModelObject>> newRowObjects(newRowCount);
+  for (int row = headerRowCount; row < newRowCount; ++row) {
+    newRowObjects[row] = m_gridController->modelObject(row);
+  }
+
+  // All rows before firstChangedRow still display the same object and stay where they are
+  int firstChangedRow = headerRowCount;
+  while (firstChangedRow < oldRowCount && firstChangedRow < newRowCount && m_rowObjects[firstChangedRow] == newRowObjects[firstChangedRow]) {
+    ++firstChangedRow;
+  }
+
+  std::vector<QWidget*> widgetsToDelete;
+  std::vector<int> rowsToBuild;
+
+  // Invalidated rows in the unchanged part of the grid are rebuilt in place
+  for (int row : rowsToRefresh) {
+    if (row >= headerRowCount && row < firstChangedRow) {
+      auto widgets = takeRow(row);
+      widgetsToDelete.insert(widgetsToDelete.end(), widgets.begin(), widgets.end());
+      rowsToBuild.push_back(row);
+    }
+  }
+
+  // Detach everything past firstChangedRow, keeping the widgets of the objects that are still displayed so we can move them
+  std::map<model::ModelObject, std::pair<int, std::vector<QWidget*>>> detachedRows;
+  for (int row = firstChangedRow; row < oldRowCount; ++row) {
+    auto widgets = takeRow(row);
+    const auto& rowObject = m_rowObjects[row];
+    if (rowObject && rowsToRefresh.count(row) == 0 && detachedRows.count(*rowObject) == 0) {
+      detachedRows.emplace(*rowObject, std::make_pair(row, std::move(widgets)));
+    } else {
+      widgetsToDelete.insert(widgetsToDelete.end(), widgets.begin(), widgets.end());
+    }
+  }
+
+  // Match the detached rows with their new location
+  std::map<int, int> movedRows;
+  std::vector<std::tuple<int, int, std::vector<QWidget*>>> rowsToPlace;
+  for (int row = firstChangedRow; row < newRowCount; ++row) {
+    auto it = detachedRows.find(*newRowObjects[row]);
+    if (it != detachedRows.end()) {
+      movedRows[it->second.first] = row;
+      rowsToPlace.emplace_back(it->second.first, row, std::move(it->second.second));
+      detachedRows.erase(it);
+    } else {
+      rowsToBuild.push_back(row);
+    }
+  }
+
+  // Whatever is left is no longer part of the grid
+  for (auto& detachedRow : detachedRows) {
+    widgetsToDelete.insert(widgetsToDelete.end(), detachedRow.second.second.begin(), detachedRow.second.second.end());
+  }
+
+  // The ObjectSelector forgets about these through QObject::destroyed
+  for (auto widget : widgetsToDelete) {
+    delete widget;
+  }
+
+  // Moved rows must be remapped before new rows are built, otherwise the new widget locations would be remapped too
+  m_gridController->getObjectSelector()->remapRows(movedRows);
+
+  auto selectedRow = std::get<0>(m_gridController->m_selectedCellLocation);
+  if (selectedRow >= firstChangedRow) {
+    auto it = movedRows.find(selectedRow);
+    if (it != movedRows.end()) {
+      std::get<0>(m_gridController->m_selectedCellLocation) = it->second;
+    } else {
+      m_gridController->m_selectedCellLocation = std::make_tuple(-1, -1, -1);
+    }
+  }
+
+  std::set<int> rowsToRestyle;
+
+  for (auto& rowToPlace : rowsToPlace) {
+    const int oldRow = std::get<0>(rowToPlace);
+    const int newRow = std::get<1>(rowToPlace);
+    const bool restyle = (oldRow % 2) != (newRow % 2);
+    if (restyle) {
+      rowsToRestyle.insert(newRow);
+    }
+
+    const auto& widgets = std::get<2>(rowToPlace);
+    for (int column = 0; column < static_cast<int>(widgets.size()); ++column) {
+      if (QWidget* widget = widgets[column]) {
+        if (restyle) {
+          widget->setStyleSheet(m_gridController->cellStyle(newRow, column, false, true));
+        }
+        addWidget(widget, newRow, column);
+      }
+    }
+  }
+
+  for (int row : rowsToBuild) {
+    for (int column = 0; column < columnCount; ++column) {
+      addWidget(row, column);
+    }
+    rowsToRestyle.insert(row);
+  }
+
+  setRowObjects(std::move(newRowObjects));
+
+  m_gridController->getObjectSelector()->updateRowWidgets(rowsToRestyle);
+
+  QTimer::singleShot(0, this, SLOT(selectRowDeterminedByModelSubTabView()));
+}
+
 void OSGridView::selectRowDeterminedByModelSubTabView() {
   // Get selected item
   auto selectedItem = m_gridController->getSelectedItemFromModelSubTabView();
@@ -414,13 +594,36 @@ void OSGridView::addWidget(int row, int column) {
   QWidget* widget = m_gridController->widgetAt(row, column);
 
   addWidget(widget, row, column);
+
+  ++m_lastRefreshCellCount;
 }
 
-void OSGridView::addWidget(QWidget* w, int row, int column) {
+std::vector<QWidget*> OSGridView::takeRow(int row) {
+  OS_ASSERT(m_gridController);
+
+  std::vector<QWidget*> widgets(m_gridController->columnCount(), nullptr);
+
   unsigned layoutindex = row / ROWS_PER_LAYOUT;
   auto relativerow = row % ROWS_PER_LAYOUT;
 
   if (layoutindex >= m_gridLayouts.size()) {
+    return widgets;
+  }
+
+  auto layout = m_gridLayouts[layoutindex];
+  for (int column = 0; column < static_cast<int>(widgets.size()); ++column) {
+    QLayoutItem* item = layout->itemAtPosition(relativerow, column);
+    if (item && item->widget()) {
+      widgets[column] = item->widget();
+      layout->removeWidget(widgets[column]);
+    }
+  }
+
+  return widgets;
+}
+
+QGridLayout* OSGridView::gridLayout(unsigned layoutindex) {
+  while (layoutindex >= m_gridLayouts.size()) {
     auto grid = makeGridLayout();
     OS_ASSERT(grid);
 
@@ -429,7 +632,377 @@ void OSGridView::addWidget(QWidget* w, int row, int column) {
     m_contentLayout->addLayout(grid);
   }
 
-  m_gridLayouts[layoutindex]->addWidget(w, relativerow, column);
+  return m_gridLayouts[layoutindex];
+}
+
+void OSGridView::addWidget(QWidget* w, int row, int column) {
+  unsigned layoutindex = row / ROWS_PER_LAYOUT;
+  auto relativerow = row % ROWS_PER_LAYOUT;
+
+  gridLayout(layoutindex)->addWidget(w, relativerow, column);
+}
+
+void OSGridView::refreshVirtualized() {
+  OS_ASSERT(m_gridController);
+
+  const int headerRowCount = m_gridController->m_hasHorizontalHeader ? 1 : 0;
+  const int oldRowCount = static_cast<int>(m_rowObjects.size());
+
+  if (oldRowCount < headerRowCount || m_materializedPages.empty()) {
+    // Nothing was ever drawn
+    refreshAll();
+    return;
+  }
+
+  std::set<int> rowsToRefresh;
+  std::swap(rowsToRefresh, m_rowsToRefresh);
+  m_lastRefreshCellCount = 0;
+
+  m_gridController->refreshModelObjects();
+
+  const int columnCount = m_gridController->columnCount();
+  const int newRowCount = m_gridController->rowCount();
+  const int newPageCount = pageCount();
+
+  std::vector<boost::optional<model::ModelObject>> newRowObjects(newRowCount);
+  for (int row = headerRowCount; row < newRowCount; ++row) {
+    newRowObjects[row] = m_gridController->modelObject(row);
+  }
+
+  auto isMaterialized = [this](int row) {
+    const unsigned page = row / ROWS_PER_LAYOUT;
+    return page < m_materializedPages.size() && m_materializedPages[page];
+  };
+
+  // All rows before firstChangedRow still display the same object and stay where they are
+  int firstChangedRow = headerRowCount;
+  while (firstChangedRow < oldRowCount && firstChangedRow < newRowCount && m_rowObjects[firstChangedRow] == newRowObjects[firstChangedRow]) {
+    ++firstChangedRow;
+  }
+
+  std::vector<QWidget*> widgetsToDelete;
+  std::vector<int> rowsToBuild;
+  // Rows without widgets whose selectable objects must be registered
+  std::vector<int> rowsToRegister;
+  std::set<model::ModelObject> invalidatedObjects;
+
+  // Invalidated rows in the unchanged part of the grid are rebuilt in place if they have widgets
+  for (int row : rowsToRefresh) {
+    if (row < headerRowCount || row >= oldRowCount) {
+      continue;
+    }
+    if (row >= firstChangedRow) {
+      invalidatedObjects.insert(*m_rowObjects[row]);
+    } else if (isMaterialized(row)) {
+      auto widgets = takeRow(row);
+      widgetsToDelete.insert(widgetsToDelete.end(), widgets.begin(), widgets.end());
+      rowsToBuild.push_back(row);
+    } else {
+      // No widgets to rebuild, but the sub rows may have changed
+      rowsToRegister.push_back(row);
+    }
+  }
+
+  // Only the rows of the materialized pages have widgets to detach past firstChangedRow, the others are just renumbered
+  std::map<model::ModelObject, std::pair<int, std::vector<QWidget*>>> detachedRows;
+  for (int row = firstChangedRow; row < oldRowCount; ++row) {
+    if (!isMaterialized(row)) {
+      continue;
+    }
+    auto widgets = takeRow(row);
+    const auto& rowObject = m_rowObjects[row];
+    if (rowObject && invalidatedObjects.count(*rowObject) == 0 && detachedRows.count(*rowObject) == 0) {
+      detachedRows.emplace(*rowObject, std::make_pair(row, std::move(widgets)));
+    } else {
+      widgetsToDelete.insert(widgetsToDelete.end(), widgets.begin(), widgets.end());
+    }
+  }
+
+  // Pages that no longer exist lose their placeholder, pages that are new start without widgets
+  const int oldPageCount = static_cast<int>(m_materializedPages.size());
+  for (int page = newPageCount; page < oldPageCount; ++page) {
+    if (QWidget* placeholder = m_pagePlaceholders[page]) {
+      gridLayout(page)->removeWidget(placeholder);
+      widgetsToDelete.push_back(placeholder);
+    }
+  }
+  m_materializedPages.resize(newPageCount, false);
+  m_pagePlaceholders.resize(newPageCount, nullptr);
+  for (int page = oldPageCount; page < newPageCount; ++page) {
+    releasePage(page);
+  }
+
+  // Match the rows past firstChangedRow with the widgets they had, if any
+  std::map<int, int> movedRows;
+  std::vector<std::tuple<int, int, std::vector<QWidget*>>> rowsToPlace;
+  for (int row = firstChangedRow; row < newRowCount; ++row) {
+    const model::ModelObject& rowObject = *newRowObjects[row];
+    const bool changed = invalidatedObjects.count(rowObject) != 0 || m_rowIndexByHandle.count(rowObject.handle()) == 0;
+
+    if (!isMaterialized(row)) {
+      if (changed) {
+        rowsToRegister.push_back(row);
+      }
+      continue;
+    }
+
+    auto it = detachedRows.find(rowObject);
+    if (it != detachedRows.end()) {
+      movedRows[it->second.first] = row;
+      rowsToPlace.emplace_back(it->second.first, row, std::move(it->second.second));
+      detachedRows.erase(it);
+    } else {
+      rowsToBuild.push_back(row);
+    }
+  }
+
+  // Whatever is left moved to a page without widgets, or is no longer part of the grid
+  for (auto& detachedRow : detachedRows) {
+    widgetsToDelete.insert(widgetsToDelete.end(), detachedRow.second.second.begin(), detachedRow.second.second.end());
+  }
+
+  // The ObjectSelector forgets about these through QObject::destroyed
+  for (auto widget : widgetsToDelete) {
+    delete widget;
+  }
+
+  // Moved rows must be remapped before new rows are built, otherwise the new widget locations would be remapped too
+  m_gridController->getObjectSelector()->remapRows(movedRows);
+
+  auto selectedRow = std::get<0>(m_gridController->m_selectedCellLocation);
+  if (selectedRow >= firstChangedRow) {
+    auto it = movedRows.find(selectedRow);
+    if (it != movedRows.end()) {
+      std::get<0>(m_gridController->m_selectedCellLocation) = it->second;
+    } else {
+      m_gridController->m_selectedCellLocation = std::make_tuple(-1, -1, -1);
+    }
+  }
+
+  std::set<int> rowsToRestyle;
+
+  for (auto& rowToPlace : rowsToPlace) {
+    const int oldRow = std::get<0>(rowToPlace);
+    const int newRow = std::get<1>(rowToPlace);
+    const bool restyle = (oldRow % 2) != (newRow % 2);
+    if (restyle) {
+      rowsToRestyle.insert(newRow);
+    }
+
+    const auto& widgets = std::get<2>(rowToPlace);
+    for (int column = 0; column < static_cast<int>(widgets.size()); ++column) {
+      if (QWidget* widget = widgets[column]) {
+        if (restyle) {
+          widget->setStyleSheet(m_gridController->cellStyle(newRow, column, false, true));
+        }
+        addWidget(widget, newRow, column);
+      }
+    }
+  }
+
+  for (int row : rowsToBuild) {
+    for (int column = 0; column < columnCount; ++column) {
+      addWidget(row, column);
+    }
+    rowsToRestyle.insert(row);
+  }
+
+  for (int row : rowsToRegister) {
+    m_gridController->addSelectorObjects(row);
+  }
+
+  // The row count of the pages past firstChangedRow may have changed
+  for (int page = firstChangedRow / ROWS_PER_LAYOUT; page < newPageCount; ++page) {
+    if (QWidget* placeholder = m_pagePlaceholders[page]) {
+      placeholder->setFixedHeight(pageRowCount(page) * m_estimatedRowHeight);
+    }
+  }
+
+  setRowObjects(std::move(newRowObjects));
+
+  m_gridController->getObjectSelector()->updateRowWidgets(rowsToRestyle);
+
+  // Rows were shifted across pages, the visible pages may have changed
+  m_visiblePagesTimer.start();
+
+  QTimer::singleShot(0, this, SLOT(selectRowDeterminedByModelSubTabView()));
+}
+
+void OSGridView::setRowObjects(std::vector<boost::optional<model::ModelObject>> rowObjects) {
+  m_rowObjects = std::move(rowObjects);
+
+  m_rowIndexByHandle.clear();
+  for (int row = 0; row < static_cast<int>(m_rowObjects.size()); ++row) {
+    if (m_rowObjects[row]) {
+      m_rowIndexByHandle.emplace(m_rowObjects[row]->handle(), row);
+    }
+  }
+}
+
+int OSGridView::rowIndexByHandle(const Handle& handle) const {
+  auto it = m_rowIndexByHandle.find(handle);
+  if (it == m_rowIndexByHandle.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+int OSGridView::pageCount() const {
+  if (!m_gridController) {
+    return 0;
+  }
+
+  return (m_gridController->rowCount() + ROWS_PER_LAYOUT - 1) / ROWS_PER_LAYOUT;
+}
+
+int OSGridView::pageRowCount(int page) const {
+  const int firstRow = page * ROWS_PER_LAYOUT;
+  return std::max(0, std::min(m_gridController->rowCount(), firstRow + ROWS_PER_LAYOUT) - firstRow);
+}
+
+QScrollArea* OSGridView::scrollArea() {
+  if (!m_scrollArea) {
+    for (QWidget* widget = parentWidget(); widget; widget = widget->parentWidget()) {
+      if (auto scrollArea = qobject_cast<QScrollArea*>(widget)) {
+        m_scrollArea = scrollArea;
+        connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, &m_visiblePagesTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+        scrollArea->viewport()->installEventFilter(this);
+        break;
+      }
+    }
+  }
+
+  return m_scrollArea;
+}
+
+std::pair<int, int> OSGridView::visiblePages() {
+  const int count = pageCount();
+  const auto defaultPages = std::make_pair(0, std::min(count - 1, OVERSCAN_PAGES));
+
+  auto area = scrollArea();
+  if (!area || !isVisible()) {
+    return defaultPages;
+  }
+
+  QWidget* viewport = area->viewport();
+  int first = -1;
+  int last = -1;
+
+  for (int page = 0; page < count && page < static_cast<int>(m_gridLayouts.size()); ++page) {
+    QGridLayout* layout = m_gridLayouts[page];
+    QWidget* parent = layout->parentWidget();
+    if (!parent) {
+      continue;
+    }
+
+    QRect pageRect = layout->geometry();
+    const int top = parent->mapTo(viewport, pageRect.topLeft()).y();
+    const int bottom = top + pageRect.height();
+    if (bottom >= 0 && top <= viewport->height()) {
+      if (first < 0) {
+        first = page;
+      }
+      last = page;
+    }
+  }
+
+  if (first < 0) {
+    return defaultPages;
+  }
+
+  return std::make_pair(std::max(0, first - OVERSCAN_PAGES), std::min(count - 1, last + OVERSCAN_PAGES));
+}
+
+void OSGridView::materializePage(int page) {
+  OS_ASSERT(m_gridController);
+
+  auto layout = gridLayout(page);
+
+  if (QWidget* placeholder = m_pagePlaceholders[page]) {
+    layout->removeWidget(placeholder);
+    delete placeholder;
+    m_pagePlaceholders[page] = nullptr;
+  }
+
+  const int firstRow = page * ROWS_PER_LAYOUT;
+  const int lastRow = std::min(m_gridController->rowCount(), firstRow + ROWS_PER_LAYOUT);
+
+  std::set<int> rows;
+  for (int row = firstRow; row < lastRow; ++row) {
+    for (int column = 0; column < m_gridController->columnCount(); ++column) {
+      addWidget(row, column);
+    }
+    rows.insert(row);
+  }
+
+  m_materializedPages[page] = true;
+
+  m_gridController->getObjectSelector()->updateRowWidgets(rows);
+}
+
+void OSGridView::releasePage(int page) {
+  OS_ASSERT(m_gridController);
+  // The first page holds the horizontal header, which the controller keeps references to
+  OS_ASSERT(page > 0);
+
+  const int firstRow = page * ROWS_PER_LAYOUT;
+  const int lastRow = firstRow + pageRowCount(page);
+
+  // The selectable objects of these rows stay registered once their widgets are gone
+  for (int row = firstRow; row < lastRow; ++row) {
+    for (auto widget : takeRow(row)) {
+      delete widget;
+    }
+  }
+
+  auto placeholder = new QWidget();
+  placeholder->setFixedHeight(pageRowCount(page) * m_estimatedRowHeight);
+  gridLayout(page)->addWidget(placeholder, 0, 0, 1, std::max(1, m_gridController->columnCount()));
+  m_pagePlaceholders[page] = placeholder;
+
+  m_materializedPages[page] = false;
+}
+
+void OSGridView::updateVisiblePages() {
+  if (!m_virtualized || !m_gridController) {
+    return;
+  }
+
+  // Wait for the pending refresh if the rows changed since the pages were laid out
+  if (m_timer.isActive() || static_cast<int>(m_rowObjects.size()) != m_gridController->rowCount()
+      || static_cast<int>(m_materializedPages.size()) != pageCount()) {
+    return;
+  }
+
+  // Use a full page that has widgets (the first one has the header) to refine the placeholder height
+  for (int page = 1; page < pageCount() - 1 && page < static_cast<int>(m_gridLayouts.size()); ++page) {
+    if (m_materializedPages[page]) {
+      const int height = m_gridLayouts[page]->geometry().height();
+      if (height > 0) {
+        m_estimatedRowHeight = std::max(1, height / ROWS_PER_LAYOUT);
+      }
+      break;
+    }
+  }
+
+  auto pages = visiblePages();
+
+  for (int page = 1; page < pageCount(); ++page) {
+    const bool visible = (page >= pages.first && page <= pages.second);
+    if (visible && !m_materializedPages[page]) {
+      materializePage(page);
+    } else if (!visible && m_materializedPages[page]) {
+      releasePage(page);
+    }
+  }
+}
+
+bool OSGridView::eventFilter(QObject* watched, QEvent* event) {
+  if (m_virtualized && m_scrollArea && watched == m_scrollArea->viewport() && event->type() == QEvent::Resize) {
+    m_visiblePagesTimer.start();
+  }
+
+  return QWidget::eventFilter(watched, event);
 }
 
 void OSGridView::selectCategory(int index) {
@@ -30,6 +30,7 @@
 #ifndef SHAREDGUICOMPONENTS_OSGRIDVIEW_HPP
 #define SHAREDGUICOMPONENTS_OSGRIDVIEW_HPP
 
+#include <QPointer>
 #include <QTimer>
 #include <QWidget>
 
@@ -37,6 +38,11 @@
 
 #include <openstudio/model/ModelObject.hpp>
 
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
 class QGridLayout;
 class QHideEvent;
 class QVBoxLayout;
@@ -44,6 +50,7 @@ class QLabel;
 class QShowEvent;
 class QString;
 class QLayoutItem;
+class QScrollArea;
 
 namespace openstudio {
 
@@ -73,6 +80,22 @@ class OSGridView : public QWidget
 
   void requestAddRow(int row);
 
+  // Rebuild the widgets of a single row on the next refresh, leaving the rest of the grid untouched
+  void requestRefreshRow(int row);
+
+  // Row currently displaying the object with this handle, -1 if there is none
+  int rowIndexByHandle(const Handle& handle) const;
+
+  // Number of cells built by the controller during the last refresh, this is what a refresh costs
+  int lastRefreshCellCount() const;
+
+  // In virtualized mode, only the pages of ROWS_PER_LAYOUT rows that intersect the viewport of the enclosing QScrollArea
+  // (plus OVERSCAN_PAGES on each side) have widgets. The other pages are replaced by a placeholder of the estimated height,
+  // and their widgets are released when they are scrolled away.
+  void setVirtualized(bool virtualized);
+
+  bool isVirtualized() const;
+
   QVBoxLayout* m_contentLayout;
 
  protected:
@@ -80,6 +103,8 @@ class OSGridView : public QWidget
 
   virtual void showEvent(QShowEvent* event) override;
 
+  virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
  signals:
 
   void dropZoneItemClicked(OSItem* item);
@@ -110,6 +135,8 @@ class OSGridView : public QWidget
 
   void selectRowDeterminedByModelSubTabView();
 
+  void updateVisiblePages();
+
  private:
   enum QueueType
   {
@@ -123,13 +150,48 @@ class OSGridView : public QWidget
   // construct a grid layout to our specs
   QGridLayout* makeGridLayout();
 
+  // Return the grid layout of a page, adding new layouts if necessary
+  QGridLayout* gridLayout(unsigned layoutindex);
+
   // Add a widget, adding a new layout if necessary
   void addWidget(QWidget* w, int row, int column);
 
+  // Remove the widgets of a row from the layouts without deleting them, one entry per column (possibly nullptr)
+  std::vector<QWidget*> takeRow(int row);
+
+  // Apply the queued row inserts, removals and invalidations: rows that still display the same object are kept (and moved if needed),
+  // only new or invalidated rows are built by the controller
+  void refreshIncremental();
+
+  // Same as refreshIncremental for a virtualized grid: rows are inserted, removed and invalidated in the row model, only the
+  // materialized pages get their widgets moved or rebuilt, the other pages only have their placeholder resized
+  void refreshVirtualized();
+
+  void setRowObjects(std::vector<boost::optional<model::ModelObject>> rowObjects);
+
+  int pageCount() const;
+
+  // Number of rows in this page, the last one may not be full
+  int pageRowCount(int page) const;
+
+  // The enclosing scroll area, if any
+  QScrollArea* scrollArea();
+
+  // First and last page that should have widgets, overscan included
+  std::pair<int, int> visiblePages();
+
+  // Build the widgets of a page, replacing its placeholder
+  void materializePage(int page);
+
+  // Delete the widgets of a page and replace them by a placeholder
+  void releasePage(int page);
+
   void setGridController(OSGridController* gridController);
 
   static const int ROWS_PER_LAYOUT = 100;
 
+  static constexpr int OVERSCAN_PAGES = 1;
+
   std::vector<QGridLayout*> m_gridLayouts;
 
   OSCollapsibleView* m_CollapsibleView;
@@ -140,9 +202,26 @@ class OSGridView : public QWidget
 
   QTimer m_timer;
 
-  int m_rowToAdd = -1;
+  // The object displayed in each row of the grid, boost::none for the header row
+  std::vector<boost::optional<model::ModelObject>> m_rowObjects;
+
+  std::map<Handle, int> m_rowIndexByHandle;
+
+  std::set<int> m_rowsToRefresh;
+
+  int m_lastRefreshCellCount = 0;
+
+  bool m_virtualized = false;
+
+  std::vector<bool> m_materializedPages;
+
+  std::vector<QWidget*> m_pagePlaceholders;
+
+  QPointer<QScrollArea> m_scrollArea;
+
+  QTimer m_visiblePagesTimer;
 
-  int m_rowToRemove = -1;
+  int m_estimatedRowHeight = 40;
 };
 
 }  // namespace openstudio
@@ -58,6 +58,7 @@
 #include <QLineEdit>
 #include <QMessageBox>
 #include <QMimeData>
+#include <QPointer>
 #include <QPushButton>
 #include <QRadioButton>
 
@@ -253,14 +254,25 @@ void MeasureStepController::addItemForDroppedMeasure(QDropEvent* event) {
     return;
   }
 
-  // Since we set the measure_paths, we only neeed to reference the name of the directory (=last level directory name)
-  // eg: /path/to/measure_folder => measure_folder
-  MeasureStep measureStep(toString(getLastLevelDirectoryName(projectMeasure->directory())));
-  try {
-    std::vector<measure::OSArgument> arguments = m_app->measureManager().getArguments(*projectMeasure);
-  } catch (const RubyException& e) {
+  // The step is added once the arguments are computed, the document stays disabled meanwhile
+  QPointer<MeasureStepController> self(this);
+  m_app->measureManager().getArgumentsAsync(
+    *projectMeasure, [self, document](const BCLMeasure& t_measure, const std::vector<measure::OSArgument>&, const std::string& t_error) {
+      if (!self) {
+        if (document) {
+          document->enable();
+        }
+        return;
+      }
+      self->addMeasureStep(t_measure, t_error, document);
+    });
+}
+
+void MeasureStepController::addMeasureStep(const BCLMeasure& projectMeasure, const std::string& argumentsError,
+                                           const std::shared_ptr<OSDocument>& document) {
+  if (!argumentsError.empty()) {
     QString errorMessage("Failed to compute arguments for measure: \n\n");
-    errorMessage += QString::fromStdString(e.what());
+    errorMessage += QString::fromStdString(argumentsError);
     QMessageBox::information(m_app->mainWidget(), QString("Failed to add measure"), errorMessage);
 
     if (document) {
@@ -269,8 +281,12 @@ void MeasureStepController::addItemForDroppedMeasure(QDropEvent* event) {
     return;
   }
 
+  // Since we set the measure_paths, we only neeed to reference the name of the directory (=last level directory name)
+  // eg: /path/to/measure_folder => measure_folder
+  MeasureStep measureStep(toString(getLastLevelDirectoryName(projectMeasure.directory())));
+
   // the new measure
-  std::string name = m_app->measureManager().suggestMeasureName(*projectMeasure);
+  std::string name = m_app->measureManager().suggestMeasureName(projectMeasure);
   // DLM: moved to WorkflowStepResult
   //measureStep.setMeasureId(projectMeasure->uid());
   //measureStep.setVersionId(projectMeasure->versionId());
@@ -280,8 +296,8 @@ void MeasureStepController::addItemForDroppedMeasure(QDropEvent* event) {
   //}
   measureStep.setName(name);
   //measureStep.setDisplayName(name); // DLM: TODO
-  measureStep.setDescription(projectMeasure->description());
-  measureStep.setModelerDescription(projectMeasure->modelerDescription());
+  measureStep.setDescription(projectMeasure.description());
+  measureStep.setModelerDescription(projectMeasure.modelerDescription());
 
   WorkflowJSON workflowJSON = m_app->currentModel()->workflowJSON();
 
@@ -449,6 +465,23 @@ std::vector<measure::OSArgument> MeasureStepItem::arguments() const {
   return result;
 }
 
+void MeasureStepItem::requestArguments() {
+  OptionalBCLMeasure bclMeasure = this->bclMeasure();
+  if (!bclMeasure) {
+    emit argumentsChanged(hasIncompleteArguments());
+    return;
+  }
+
+  QPointer<MeasureStepItem> self(this);
+  m_app->measureManager().getArgumentsAsync(
+    *bclMeasure, [self](const BCLMeasure&, const std::vector<measure::OSArgument>&, const std::string& t_error) {
+      if (self) {
+        // arguments() reads them from the cache now, unless they could not be computed
+        emit self->argumentsChanged(!t_error.empty() || self->hasIncompleteArguments());
+      }
+    });
+}
+
 bool MeasureStepItem::hasIncompleteArguments() const {
   return (incompleteArguments().size() > 0);
 }
@@ -566,10 +599,13 @@ QWidget* MeasureStepItemDelegate::view(QSharedPointer<OSListItem> dataSource) {
 
     // Warning Icon
 
-    workflowStepView->workflowStepButton->cautionLabel->setVisible(measureStepItem->hasIncompleteArguments());
+    workflowStepView->workflowStepButton->cautionLabel->setVisible(false);
 
     connect(measureStepItem.data(), &MeasureStepItem::argumentsChanged, workflowStepView->workflowStepButton->cautionLabel, &QLabel::setVisible);
 
+    // The arguments of every step are computed at once instead of one after the other
+    measureStepItem->requestArguments();
+
     // Up and down buttons
 
     connect(workflowStepView->upButton, &QPushButton::clicked, measureStepItem.data(), &MeasureStepItem::moveUp);
@@ -40,9 +40,12 @@
 #include <QPointer>
 #include <QSharedPointer>
 #include <map>
+#include <memory>
 
 namespace openstudio {
 
+class OSDocument;
+
 namespace measuretab {
 
 class WorkflowSectionItem;
@@ -154,6 +157,9 @@ class MeasureStepController : public WorkflowStepController
  private:
   void addItem(QSharedPointer<OSListItem> item);
 
+  // Second half of addItemForDroppedMeasure, once the arguments of the dropped measure are computed
+  void addMeasureStep(const BCLMeasure& projectMeasure, const std::string& argumentsError, const std::shared_ptr<OSDocument>& document);
+
   MeasureType m_measureType;
   BaseApp* m_app;
 
@@ -204,6 +210,9 @@ class MeasureStepItem : public OSListItem
 
   std::vector<measure::OSArgument> incompleteArguments() const;
 
+  // Computes the arguments without blocking, argumentsChanged is emitted once they are known
+  void requestArguments();
+
  public slots:
 
   void remove();